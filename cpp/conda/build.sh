@@ -12,6 +12,7 @@ cmake -GNinja \
     -DCMAKE_CXX_STANDARD=20 \
     -DCMAKE_INSTALL_PREFIX=${PREFIX} \
     -DCMAKE_OSX_SYSROOT=${CONDA_BUILD_SYSROOT} \
+    -DMrd_GENERATED_USE_ZSTD=ON \
     ../
 
 ninja install
@@ -1,4 +1,5 @@
 #include "mrd/binary/protocols.h"
+#include "mrd/data_visitor.h"
 
 int main(void) {
   mrd::binary::MrdWriter w("test.bin");
@@ -25,15 +26,16 @@ int main(void) {
   std::optional<mrd::Header> header_in;
   r.ReadHeader(header_in);
 
-  mrd::StreamItem v;
-  while (r.ReadData(v)) {
-    if (!std::holds_alternative<mrd::Acquisition>(v)) {
-      continue;
-    }
-
-    auto acq = std::get<mrd::Acquisition>(v);
-    // Process Acquisition
-    // ...
+  // Each item is passed to the matching handler and can be moved out of it.
+  // Items without a handler are skipped.
+  std::vector<mrd::Acquisition> acquisitions;
+  while (mrd::ReadData(r, mrd::Overloaded{
+      [&](mrd::Acquisition&& acq) {
+        // Process Acquisition
+        // ...
+        acquisitions.push_back(std::move(acq));
+      },
+  })) {
   }
   r.Close();
 
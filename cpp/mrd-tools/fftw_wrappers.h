@@ -3,6 +3,11 @@
 #include <complex>
 #include <cstring>
 #include <fftw3.h>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 #include <xtensor/containers/xarray.hpp>
 #include <xtensor/misc/xmanipulation.hpp>
 
@@ -10,6 +15,64 @@ namespace fftw_wrappers {
 
 namespace detail {
 
+// FFTW plans created once per transform shape and direction and reused for the
+// lifetime of the process. Creating a plan is not thread-safe and is by far the
+// most expensive part of a small transform, whereas executing an existing plan
+// on new arrays with fftwf_execute_dft is thread-safe.
+class PlanCache {
+ public:
+  static PlanCache& Instance() {
+    static PlanCache cache;
+    return cache;
+  }
+
+  ~PlanCache() {
+    for (auto& [key, plan] : plans_) {
+      fftwf_destroy_plan(plan);
+    }
+  }
+
+  // Returns an out-of-place plan for arrays of the given dimensions. The plan
+  // does not require aligned arrays, so it can be executed on any xtensor data.
+  fftwf_plan Get(std::vector<int> const& dims, int direction) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto key = std::make_pair(dims, direction);
+    auto it = plans_.find(key);
+    if (it != plans_.end()) {
+      return it->second;
+    }
+
+    size_t size = 1;
+    for (int d : dims) {
+      size *= static_cast<size_t>(d);
+    }
+    // FFTW_ESTIMATE does not touch the arrays while planning
+    fftwf_complex* in = fftwf_alloc_complex(size);
+    fftwf_complex* out = fftwf_alloc_complex(size);
+    fftwf_plan plan = fftwf_plan_dft(static_cast<int>(dims.size()), dims.data(), in, out, direction,
+                                     FFTW_ESTIMATE | FFTW_UNALIGNED);
+    fftwf_free(in);
+    fftwf_free(out);
+    if (plan == nullptr) {
+      throw std::runtime_error("Failed to create FFTW plan");
+    }
+
+    plans_.emplace(std::move(key), plan);
+    return plan;
+  }
+
+  size_t Size() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return plans_.size();
+  }
+
+ private:
+  PlanCache() = default;
+
+  std::mutex mutex_;
+  std::map<std::pair<std::vector<int>, int>, fftwf_plan> plans_;
+};
+
 // Helper function for 1D FFTW operations
 template <class E>
 inline auto fftw_1d_impl(E&& e, int direction, bool normalize) -> xt::xarray<std::complex<float>> {
@@ -22,9 +85,8 @@ inline auto fftw_1d_impl(E&& e, int direction, bool normalize) -> xt::xarray<std
   fftwf_complex* in = reinterpret_cast<fftwf_complex*>(input.data());
   fftwf_complex* out = reinterpret_cast<fftwf_complex*>(result.data());
 
-  fftwf_plan plan = fftwf_plan_dft_1d(size, in, out, direction, FFTW_ESTIMATE);
-  fftwf_execute(plan);
-  fftwf_destroy_plan(plan);
+  fftwf_plan plan = PlanCache::Instance().Get({static_cast<int>(size)}, direction);
+  fftwf_execute_dft(plan, in, out);
 
   if (normalize) {
     result /= static_cast<float>(size);
@@ -52,9 +114,8 @@ inline auto fftw_2d_impl(E&& e, int direction, bool normalize) -> xt::xarray<std
   fftwf_complex* in = reinterpret_cast<fftwf_complex*>(input.data());
   fftwf_complex* out = reinterpret_cast<fftwf_complex*>(result.data());
 
-  fftwf_plan plan = fftwf_plan_dft_2d(n0, n1, in, out, direction, FFTW_ESTIMATE);
-  fftwf_execute(plan);
-  fftwf_destroy_plan(plan);
+  fftwf_plan plan = PlanCache::Instance().Get({static_cast<int>(n0), static_cast<int>(n1)}, direction);
+  fftwf_execute_dft(plan, in, out);
 
   if (normalize) {
     result /= static_cast<float>(n0 * n1);
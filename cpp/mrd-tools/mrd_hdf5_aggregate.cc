@@ -0,0 +1,26 @@
+#include "mrd/hdf5/file.h"
+
+#include <iostream>
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <output filename> <filename>..." << std::endl;
+    return 1;
+  }
+
+  std::string output_filename = argv[1];
+  std::vector<std::string> filenames(argv + 2, argv + argc);
+
+  // The header of the first file describes the aggregate
+  std::optional<mrd::Header> header;
+  mrd::hdf5::MrdFileReader r(filenames[0], true);
+  r.ReadHeader(header);
+  r.Close();
+
+  mrd::hdf5::MrdFileWriter w(output_filename);
+  w.WriteHeader(header);
+  w.WriteVirtualData(filenames);
+  w.EndData();
+  w.Close();
+  return 0;
+}
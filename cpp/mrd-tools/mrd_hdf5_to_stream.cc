@@ -1,16 +1,103 @@
 #include "mrd/binary/protocols.h"
-#include "mrd/hdf5/protocols.h"
+#include "mrd/hdf5/file.h"
+#include "mrd/pipelined_copy.h"
+
+#include <iostream>
+#include <optional>
 
 int main(int argc, char** argv) {
+  auto print_usage = [&]() {
+    std::cerr << "Usage: " << argv[0] << " <filename> [options]" << std::endl;
+    std::cerr << "  --stats                (report the throughput of the copy)" << std::endl;
+    std::cerr << "  --range <begin>:[end]  (write only the items at these positions of the data stream)" << std::endl;
+    std::cerr << "  --repetition <n>       (write only the acquisitions of repetition n, using the key tables)" << std::endl;
+    std::cerr << "  --swmr                 (read the file while mrd_stream_to_hdf5 --swmr writes it)" << std::endl;
+  };
+
   if (argc < 2) {
-    std::cerr << "Usage: " << argv[0] << " <filename>" << std::endl;
+    print_usage();
     return 1;
   }
 
   std::string filename = argv[1];
+  bool print_stats = false;
+  std::optional<uint64_t> range_begin;
+  std::optional<uint64_t> range_end;
+  std::optional<uint32_t> repetition;
+  mrd::hdf5::Hdf5Options options;
+
+  std::vector<std::string> args(argv + 2, argv + argc);
+  for (auto current_arg = args.begin(); current_arg != args.end(); current_arg++) {
+    if (*current_arg == "--stats") {
+      print_stats = true;
+    } else if (*current_arg == "--range") {
+      current_arg++;
+      auto colon = current_arg == args.end() ? std::string::npos : current_arg->find(':');
+      if (colon == std::string::npos) {
+        std::cerr << "Missing range" << std::endl;
+        print_usage();
+        return 1;
+      }
+      range_begin = std::stoull(current_arg->substr(0, colon));
+      if (colon + 1 < current_arg->size()) {
+        range_end = std::stoull(current_arg->substr(colon + 1));
+      }
+    } else if (*current_arg == "--repetition") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing repetition" << std::endl;
+        print_usage();
+        return 1;
+      }
+      repetition = static_cast<uint32_t>(std::stoul(*current_arg));
+    } else if (*current_arg == "--swmr") {
+      options.swmr = true;
+    } else {
+      std::cerr << "Unknown option: " << *current_arg << std::endl;
+      print_usage();
+      return 1;
+    }
+  }
 
-  mrd::hdf5::MrdReader r(filename);
+  mrd::hdf5::MrdFileReader r(filename, options, range_begin || repetition);
   mrd::binary::MrdWriter w(std::cout);
-  r.CopyTo(w);
+
+  if (repetition || range_begin) {
+    std::optional<mrd::Header> header;
+    r.ReadHeader(header);
+    w.WriteHeader(header);
+    if (repetition) {
+      mrd::hdf5::AcquisitionSelection selection;
+      selection.repetition = *repetition;
+      std::vector<mrd::Acquisition> acquisitions;
+      r.Select(selection, acquisitions);
+      for (auto& acq : acquisitions) {
+        w.WriteData(mrd::StreamItem(std::move(acq)));
+      }
+    } else if (range_end) {
+      std::vector<mrd::StreamItem> items;
+      r.ReadDataRange(*range_begin, *range_end, items);
+      w.WriteData(items);
+    } else {
+      r.Seek(*range_begin);
+      mrd::StreamItem item;
+      while (r.ReadData(item)) {
+        w.WriteData(item);
+      }
+    }
+    w.EndData();
+    w.Close();
+    return 0;
+  }
+
+  auto stats = mrd::CopyToPipelined(r, w, 64);
+  if (print_stats) {
+    std::cerr << "Copied " << stats.items << " items in " << stats.elapsed.count() << " s ("
+              << stats.ItemsPerSecond() << " items/s)" << std::endl
+              << "  reader: " << stats.read_time.count() << " s reading, "
+              << stats.reader_wait_time.count() << " s waiting for the writer" << std::endl
+              << "  writer: " << stats.write_time.count() << " s writing, "
+              << stats.writer_wait_time.count() << " s waiting for the reader" << std::endl;
+  }
   return 0;
 }
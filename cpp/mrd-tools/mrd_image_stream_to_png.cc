@@ -1,4 +1,4 @@
-#include "mrd/binary/protocols.h"
+#include "mrd/binary/format.h"
 
 #include <Magick++.h>
 #include <format>
@@ -60,7 +60,7 @@ int main(int argc, char** argv) {
     }
   }
 
-  mrd::binary::MrdReader r(input_path.empty() ? std::cin : *input_file);
+  mrd::binary::MrdFormatReader r(input_path.empty() ? std::cin : *input_file);
 
   std::optional<mrd::Header> h;
   r.ReadHeader(h);
@@ -1,5 +1,8 @@
 #include "fftw_wrappers.h"
-#include "mrd/binary/protocols.h"
+#include "mrd/async_writer.h"
+#include "mrd/binary/format.h"
+#include "mrd/tee.h"
+#include "mrd/binary/shared_memory.h"
 #include "shepp_logan_phantom.h"
 
 #include <iostream>
@@ -33,7 +36,14 @@ int main(int argc, char** argv) {
   uint32_t calib_width = 0;
   bool add_noise_calibration = false;
   bool store_coordinates = false;
+  std::string sample_encoding = "float32";
+  bool checksums = false;
+  bool async_output = false;
+  std::vector<std::string> tee_filenames;
+  std::vector<std::string> tee_drop_filenames;
   std::string filename;
+  std::string shm_name;
+  bool replace_shm = false;
 
   auto bool2str = [](bool b) { return b ? "true" : "false"; };
 
@@ -41,6 +51,8 @@ int main(int argc, char** argv) {
     std::cerr << "Usage: " << argv[0] << std::endl;
     std::cerr << "  -h|--help" << std::endl;
     std::cerr << "  -o|--output       <output stream>   (default: stdout)" << std::endl;
+    std::cerr << "  --output-shm      <shared memory name> (write to a shared memory ring buffer, e.g. /mrd)" << std::endl;
+    std::cerr << "  --replace-shm     (replace an existing shared memory object of that name)" << std::endl;
     std::cerr << "  -c|--coils        <number of coils> (default: " << ncoils << ")" << std::endl;
     std::cerr << "  -m|--matrix       <matrix size>     (default: " << matrix << ")" << std::endl;
     std::cerr << "  -r|--repetitions  <repetitions>     (default: " << repetitions << ")" << std::endl;
@@ -50,6 +62,11 @@ int main(int argc, char** argv) {
     std::cerr << "  -w|--calibration-width  <calibration width>         (default: " << calib_width << ")" << std::endl;
     std::cerr << "  -C|--noise-calibration  <add noise calibration>     (default: " << bool2str(add_noise_calibration) << ")" << std::endl;
     std::cerr << "  -K|--store-coordinates  <add k-space coordinates>   (default: " << bool2str(store_coordinates) << ")" << std::endl;
+    std::cerr << "  -e|--sample-encoding    <float32|float16|bfloat16>  (default: " << sample_encoding << ")" << std::endl;
+    std::cerr << "  -X|--checksums          <add item checksums>        (default: " << bool2str(checksums) << ")" << std::endl;
+    std::cerr << "  --async                 <write on a background thread> (default: " << bool2str(async_output) << ")" << std::endl;
+    std::cerr << "  --tee <filename>        (also write the stream to this file, on a thread of its own)" << std::endl;
+    std::cerr << "  --tee-drop <filename>   (like --tee, but drop items when the file falls behind)" << std::endl;
     std::cerr << "  --output-phantom <filename> (write raw phantom array to file)" << std::endl;
     std::cerr << "  --output-csm <filename> (write coil sensitivities array to file)" << std::endl;
     std::cerr << "  --output-coils <filename> (write coil image array to file)" << std::endl;
@@ -74,6 +91,18 @@ int main(int argc, char** argv) {
       }
       filename = *current_arg;
       current_arg++;
+    } else if (*current_arg == "--output-shm") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing shared memory name" << std::endl;
+        print_usage();
+        return 1;
+      }
+      shm_name = *current_arg;
+      current_arg++;
+    } else if (*current_arg == "--replace-shm") {
+      current_arg++;
+      replace_shm = true;
     } else if (*current_arg == "--coils" || *current_arg == "-c") {
       current_arg++;
       if (current_arg == args.end()) {
@@ -143,6 +172,31 @@ int main(int argc, char** argv) {
     } else if (*current_arg == "--store-coordinates" || *current_arg == "-K") {
       current_arg++;
       store_coordinates = true;
+    } else if (*current_arg == "--sample-encoding" || *current_arg == "-e") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing sample encoding" << std::endl;
+        print_usage();
+        return 1;
+      }
+      sample_encoding = *current_arg;
+      current_arg++;
+    } else if (*current_arg == "--checksums" || *current_arg == "-X") {
+      current_arg++;
+      checksums = true;
+    } else if (*current_arg == "--async") {
+      current_arg++;
+      async_output = true;
+    } else if (*current_arg == "--tee" || *current_arg == "--tee-drop") {
+      auto& filenames = *current_arg == "--tee" ? tee_filenames : tee_drop_filenames;
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing tee output file" << std::endl;
+        print_usage();
+        return 1;
+      }
+      filenames.push_back(*current_arg);
+      current_arg++;
     } else if (*current_arg == "--output-phantom") {
       current_arg++;
       if (current_arg == args.end()) {
@@ -177,12 +231,53 @@ int main(int argc, char** argv) {
     }
   }
 
-  std::unique_ptr<MrdWriterBase> w;
+  mrd::binary::FormatOptions format_options;
+  if (sample_encoding == "float16") {
+    format_options.sample_encoding = mrd::binary::SampleEncoding::kFloat16;
+  } else if (sample_encoding == "bfloat16") {
+    format_options.sample_encoding = mrd::binary::SampleEncoding::kBFloat16;
+  } else if (sample_encoding != "float32") {
+    std::cerr << "Unknown sample encoding: " << sample_encoding << std::endl;
+    print_usage();
+    return 1;
+  }
+  format_options.checksums = checksums;
+
+  std::unique_ptr<mrd::binary::SharedMemoryOutputStream> shm_stream;
+  std::unique_ptr<mrd::binary::MrdFormatWriter> format_writer;
 
-  if (filename.empty()) {
-    w = std::make_unique<mrd::binary::MrdWriter>(std::cout);
+  if (!shm_name.empty()) {
+    shm_stream = std::make_unique<mrd::binary::SharedMemoryOutputStream>(
+        shm_name, mrd::binary::SharedMemoryOutputStream::kDefaultCapacity, replace_shm);
+    format_writer = std::make_unique<mrd::binary::MrdFormatWriter>(*shm_stream, format_options);
+  } else if (filename.empty()) {
+    format_writer = std::make_unique<mrd::binary::MrdFormatWriter>(std::cout, format_options);
   } else {
-    w = std::make_unique<mrd::binary::MrdWriter>(filename);
+    format_writer = std::make_unique<mrd::binary::MrdFormatWriter>(filename, format_options);
+  }
+
+  // Still owned by w, which reports the error of a lossy sample encoding
+  mrd::binary::MrdFormatWriter const& encoding_writer = *format_writer;
+  std::unique_ptr<mrd::MrdWriterBase> w = std::move(format_writer);
+
+  // Sink 0 is the output, followed by the --tee and the --tee-drop files
+  mrd::TeeMrdWriter* tee = nullptr;
+  if (!tee_filenames.empty() || !tee_drop_filenames.empty()) {
+    auto tee_writer = std::make_unique<mrd::TeeMrdWriter>();
+    tee_writer->AddSink(std::move(w));
+    for (auto const& tee_filename : tee_filenames) {
+      tee_writer->AddSink(std::make_unique<mrd::binary::MrdFormatWriter>(tee_filename, format_options));
+    }
+    for (auto const& tee_filename : tee_drop_filenames) {
+      tee_writer->AddSink(std::make_unique<mrd::binary::MrdFormatWriter>(tee_filename, format_options),
+                          mrd::TeeSinkOptions{mrd::TeeSinkPolicy::kDrop});
+    }
+    tee = tee_writer.get();
+    w = std::move(tee_writer);
+  }
+
+  if (async_output) {
+    w = std::make_unique<mrd::AsyncMrdWriter>(std::move(w));
   }
 
   // Parameters
@@ -389,4 +484,21 @@ int main(int argc, char** argv) {
   }
   w->EndData();
   w->Close();
+
+  if (tee != nullptr) {
+    for (size_t i = 0; i < tee_drop_filenames.size(); i++) {
+      auto stats = tee->GetSinkStats(1 + tee_filenames.size() + i);
+      if (stats.items_dropped > 0) {
+        std::cerr << "Dropped " << stats.items_dropped << " items for " << tee_drop_filenames[i] << std::endl;
+      }
+    }
+  }
+
+  if (format_options.sample_encoding != mrd::binary::SampleEncoding::kFloat32) {
+    auto const& report = encoding_writer.GetSampleEncodingReport();
+    std::cerr << "Encoded " << report.value_count << " samples as " << sample_encoding
+              << ": max relative error " << report.max_rel_error
+              << ", relative RMS error " << report.RelativeRmsError()
+              << ", SER " << report.SignalToErrorRatioDb() << " dB" << std::endl;
+  }
 }
@@ -0,0 +1,104 @@
+#include "mrd/binary/format.h"
+#include "mrd/binary/protocols.h"
+#include "mrd/channel/protocols.h"
+
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Interleaves the data streams of several MRD streams with the same header,
+// such as the parts of an acquisition written by different sources, into one
+// stream on stdout. Each file is read on a thread of its own, and its items are
+// moved to the output through an MrdChannel in the order they are read.
+int main(int argc, char** argv) {
+  size_t max_bytes = 64 * 1024 * 1024;
+
+  auto print_usage = [&]() {
+    std::cerr << "Usage: " << argv[0] << " [--max-bytes <bytes>] <filename>..." << std::endl;
+    std::cerr << "  --max-bytes <bytes> (memory of the items read but not yet written, default: " << max_bytes << ")" << std::endl;
+  };
+
+  std::vector<std::string> filenames;
+  std::vector<std::string> args(argv + 1, argv + argc);
+  for (auto current_arg = args.begin(); current_arg != args.end(); current_arg++) {
+    if (*current_arg == "--max-bytes") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing number of bytes" << std::endl;
+        print_usage();
+        return 1;
+      }
+      max_bytes = std::stoull(*current_arg);
+    } else if (*current_arg == "--help" || *current_arg == "-h") {
+      print_usage();
+      return 0;
+    } else {
+      filenames.push_back(*current_arg);
+    }
+  }
+
+  if (filenames.empty()) {
+    print_usage();
+    return 1;
+  }
+
+  auto channel = std::make_shared<mrd::channel::MrdChannel>(64, filenames.size(), max_bytes);
+  auto reader = std::make_unique<mrd::channel::MrdReader>(channel);
+
+  // The first error, which makes the other sides of the channel fail as well
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  auto set_error = [&](std::exception_ptr e) {
+    std::lock_guard<std::mutex> lock(error_mutex);
+    if (!error) {
+      error = e;
+    }
+  };
+
+  std::vector<std::thread> producers;
+  for (size_t i = 0; i < filenames.size(); i++) {
+    producers.emplace_back([&, i]() {
+      try {
+        // Attached first, so that its destruction fails the channel if the file cannot be read
+        mrd::channel::MrdWriter w(channel);
+        mrd::binary::MrdFormatReader r(filenames[i]);
+        std::optional<mrd::Header> header;
+        r.ReadHeader(header);
+        w.WriteHeader(header);
+        mrd::StreamItem item;
+        while (r.ReadData(item)) {
+          w.WriteData(std::move(item));
+        }
+        w.EndData();
+        r.Close();
+      } catch (...) {
+        set_error(std::current_exception());
+      }
+    });
+  }
+
+  try {
+    mrd::binary::MrdWriter w(std::cout);
+    reader->CopyTo(w, 64);
+    reader->Close();
+    w.Close();
+  } catch (...) {
+    set_error(std::current_exception());
+  }
+
+  // Makes the writes of producers still running fail
+  reader.reset();
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return 0;
+}
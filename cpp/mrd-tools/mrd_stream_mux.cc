@@ -0,0 +1,81 @@
+#include "mrd/binary/format.h"
+#include "mrd/binary/mux.h"
+
+#include <exception>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+// Writes each file as a session of a multiplexed stream on stdout, with the
+// file's index as session ID. Sessions are written concurrently.
+int Mux(std::vector<std::string> const& filenames) {
+  mrd::binary::MrdMuxWriter mux(std::cout);
+  std::vector<std::exception_ptr> errors(filenames.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < filenames.size(); i++) {
+    threads.emplace_back([&, i]() {
+      try {
+        mrd::binary::MrdFormatReader r(filenames[i]);
+        auto session = mux.OpenSession(i, r.GetFormatOptions());
+        r.CopyTo(*session, 64);
+        r.Close();
+        session->Close();
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  mux.Close();
+  return 0;
+}
+
+// Writes each session of the multiplexed stream on stdin to
+// <prefix><session ID>.mrd.
+int Demux(std::string const& prefix, mrd::binary::DemuxOptions const& options) {
+  mrd::binary::MrdDemuxer demux(std::cin, [&](uint64_t session_id, mrd::binary::MrdFormatReader& r) {
+    mrd::binary::MrdFormatWriter w(prefix + std::to_string(session_id) + ".mrd", r.GetFormatOptions());
+    r.CopyTo(w, 64);
+    r.Close();
+    w.Close();
+  }, options);
+  demux.Run();
+  std::cerr << "Demultiplexed " << demux.SessionCount() << " sessions" << std::endl;
+  return 0;
+}
+
+void PrintUsage(char const* program) {
+  std::cerr << "Usage: " << program << " <filename>..." << std::endl
+            << "       " << program << " --demux <output prefix> [--max-session-bytes <bytes>]" << std::endl
+            << "  --max-session-bytes  input buffered per session before all sessions wait for it (default: "
+            << mrd::binary::DemuxOptions{}.max_session_buffer_bytes << ", 0 for no limit)" << std::endl;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc >= 3 && std::string(argv[1]) == "--demux") {
+    mrd::binary::DemuxOptions options;
+    if (argc == 5 && std::string(argv[3]) == "--max-session-bytes") {
+      options.max_session_buffer_bytes = std::stoull(argv[4]);
+    } else if (argc != 3) {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+    return Demux(argv[2], options);
+  }
+  if (argc < 2 || std::string(argv[1]).starts_with("-")) {
+    PrintUsage(argv[0]);
+    return 1;
+  }
+
+  return Mux(std::vector<std::string>(argv + 1, argv + argc));
+}
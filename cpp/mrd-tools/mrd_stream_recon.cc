@@ -1,7 +1,28 @@
 #include "fftw_wrappers.h"
-#include "mrd/binary/protocols.h"
+#include "mrd/binary/concurrent_writer.h"
+#include "mrd/binary/format.h"
+#include "mrd/data_range.h"
+#include "mrd/data_visitor.h"
+#include "mrd/moving_writer.h"
+#include "mrd/prefetch.h"
 #include "mrd/protocols.h"
 #include "mrd/types.h"
+#include "mrd/binary/shared_memory.h"
+#include "mrd/concurrency/bounded_queue.h"
+#include "socket_stream.h"
+
+#include <atomic>
+#include <csignal>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+
+#include <pthread.h>
+#include <unistd.h>
 
 #include <xtensor/core/xmath.hpp>
 #include <xtensor/misc/xcomplex.hpp>
@@ -31,72 +52,60 @@ xt::xtensor<std::complex<float>, 4> fftshift(xt::xtensor<std::complex<float>, 4>
   return xt::roll(xt::roll(x, x.shape(3) / 2, 3), x.shape(2) / 2, 2);
 }
 
-void print_usage(std::string program_name) {
-  std::cerr << "Usage: " << program_name << std::endl;
-  std::cerr << "  -i|--input   <input MRD stream> (default: stdin)" << std::endl;
-  std::cerr << "  -o|--output  <output MRD stream> (default: stdout)" << std::endl;
-  std::cerr << "  -h|--help" << std::endl;
-}
+// K-space buffers kept across reconstructions, keyed by their shape (that is,
+// by the matrix size and coil count), so that exams with the same protocol
+// reuse the buffers of earlier ones rather than allocating their own.
+class BufferPool {
+ public:
+  using Buffer = xt::xtensor<std::complex<float>, 6>;
+  using Shape = std::array<size_t, 6>;
 
-int main(int argc, char** argv) {
-  std::string input_path;
-  std::string output_path;
+  explicit BufferPool(size_t max_buffers_per_shape = 1) : max_buffers_per_shape_(max_buffers_per_shape) {}
 
-  std::vector<std::string> args(argv, argv + argc);
-  auto current_arg = args.begin() + 1;
-  while (current_arg != args.end()) {
-    if (*current_arg == "--help" || *current_arg == "-h") {
-      print_usage(args[0]);
-      return 0;
-    } else if (*current_arg == "--input" || *current_arg == "-i") {
-      current_arg++;
-      if (current_arg == args.end()) {
-        std::cerr << "Missing input file" << std::endl;
-        print_usage(args[0]);
-        return 1;
-      }
-      input_path = *current_arg;
-      current_arg++;
-    } else if (*current_arg == "--output" || *current_arg == "-o") {
-      current_arg++;
-      if (current_arg == args.end()) {
-        std::cerr << "Missing output file" << std::endl;
-        print_usage(args[0]);
-        return 1;
+  // Returns a zero-filled buffer of the given shape.
+  Buffer Acquire(Shape const& shape) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = free_buffers_.find(shape);
+      if (it != free_buffers_.end() && !it->second.empty()) {
+        Buffer buffer = std::move(it->second.back());
+        it->second.pop_back();
+        std::fill(buffer.data(), buffer.data() + buffer.size(), std::complex<float>(0));
+        return buffer;
       }
-      output_path = *current_arg;
-      current_arg++;
-    } else {
-      std::cerr << "Unknown argument: " << *current_arg << std::endl;
-      print_usage(args[0]);
-      return 1;
     }
+    return xt::zeros<std::complex<float>>(shape);
   }
 
-  std::unique_ptr<std::ifstream> input_file;
-  if (!input_path.empty()) {
-    input_file = std::make_unique<std::ifstream>(input_path, std::ios::binary | std::ios::in);
-    if (!input_file->good()) {
-      throw std::runtime_error("Failed to open input file for reading.");
+  void Release(Buffer&& buffer) {
+    if (buffer.size() == 0) {
+      return;
     }
-  }
 
-  std::unique_ptr<std::ofstream> output_file;
-  if (!output_path.empty()) {
-    output_file = std::make_unique<std::ofstream>(output_path, std::ios::binary | std::ios::out);
-    if (!output_file->good()) {
-      throw std::runtime_error("Failed to open output file for writing.");
+    Shape shape;
+    std::copy(buffer.shape().begin(), buffer.shape().end(), shape.begin());
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& free_buffers = free_buffers_[shape];
+    if (free_buffers.size() < max_buffers_per_shape_) {
+      free_buffers.push_back(std::move(buffer));
     }
   }
 
-  mrd::binary::MrdReader r(input_path.empty() ? std::cin : *input_file);
-  mrd::binary::MrdWriter w(output_path.empty() ? std::cout : *output_file);
+ private:
+  size_t const max_buffers_per_shape_;
+  std::mutex mutex_;
+  std::map<Shape, std::vector<Buffer>> free_buffers_;
+};
 
+// Reconstructs the Acquisitions of a stream and writes the Images to w. If
+// `repetition` is set, only the Acquisitions of that repetition are
+// reconstructed. Returns false if the stream has no header.
+bool reconstruct(mrd::MrdReaderBase& r, mrd::MrdWriterBase& w, BufferPool& buffers,
+                 std::optional<uint32_t> repetition = std::nullopt) {
   std::optional<mrd::Header> ho;
   r.ReadHeader(ho);
   if (!ho) {
-    std::cerr << "Failed to read header" << std::endl;
-    return 1;
+    return false;
   }
 
   auto h = ho.value();
@@ -138,20 +147,14 @@ int main(int argc, char** argv) {
     ky_offset = ((eNy + 1) / 2) - enc.encoding_limits.kspace_encoding_step_1->center;
   }
 
-  // When we have aliased types, we will use that.
-  mrd::StreamItem v;
-  xt::xtensor<std::complex<float>, 6> buffer;
-  mrd::Acquisition ref_acq;
+  BufferPool::Buffer buffer;
+  std::vector<mrd::AcquisitionHeader> ref_heads(ncontrasts * nslices);
   uint32_t image_index = 0;
-  while (r.ReadData(v)) {
-    if (!std::holds_alternative<mrd::Acquisition>(v)) {
-      continue;
-    }
-    auto acq = std::get<mrd::Acquisition>(v);
 
+  auto handle_acquisition = [&](mrd::Acquisition&& acq) {
     // Currently ignoring noise scans
     if (acq.head.flags.HasFlags(mrd::AcquisitionFlags::kIsNoiseMeasurement)) {
-      continue;
+      return;
     }
 
     // Remove oversampling
@@ -159,78 +162,587 @@ int main(int argc, char** argv) {
       remove_oversampling(acq, enc);
     }
 
-    // If this is the first line, we need to allocate the buffer
+    auto contrast = acq.head.idx.contrast.value_or(0);
+    auto slice_index = acq.head.idx.slice.value_or(0);
+    auto& ref_head = ref_heads.at(contrast * nslices + slice_index);
+
+    // If this is the first line of a slice, we need to allocate the buffer or clear the slice
     if (acq.head.flags.HasFlags(mrd::AcquisitionFlags::kFirstInEncodeStep1) || acq.head.flags.HasFlags(mrd::AcquisitionFlags::kFirstInSlice)) {
       uint32_t readout_length = acq.Samples();
-      std::array<size_t, 6> shape = {ncontrasts, nslices, ncoils, eNz, eNy, readout_length};
-      buffer = xt::zeros<std::complex<float>>(shape);
-      ref_acq = acq;
+      BufferPool::Shape shape = {ncontrasts, nslices, ncoils, eNz, eNy, readout_length};
+      if (!std::equal(shape.begin(), shape.end(), buffer.shape().begin())) {
+        buffers.Release(std::move(buffer));
+        buffer = buffers.Acquire(shape);
+      } else {
+        xt::view(buffer, contrast, slice_index, xt::all(), xt::all(), xt::all(), xt::all()) = std::complex<float>(0);
+      }
+      ref_head = acq.head;
     }
 
     // Copy the data into the buffer
-    auto contrast = acq.head.idx.contrast.value_or(0);
-    auto slice = acq.head.idx.slice.value_or(0);
     auto k1 = acq.head.idx.kspace_encode_step_1.value_or(0);
     auto k2 = acq.head.idx.kspace_encode_step_2.value_or(0);
-    xt::view(buffer, contrast, slice, xt::all(), k2, k1 + ky_offset, xt::all()) = xt::xarray<std::complex<float>>(acq.data);
+    xt::view(buffer, contrast, slice_index, xt::all(), k2, k1 + ky_offset, xt::all()) = xt::xarray<std::complex<float>>(acq.data);
 
-    // If this is the last line, we need to write the buffer
+    // If this is the last line of a slice, we need to reconstruct and write it.
+    // Slices are reconstructed independently, so that (contrast, slice) pairs can
+    // be distributed across processes (see DistributedRecon).
     if (acq.head.flags.HasFlags(mrd::AcquisitionFlags::kLastInEncodeStep1) || acq.head.flags.HasFlags(mrd::AcquisitionFlags::kLastInSlice)) {
-      for (unsigned int c = 0; c < buffer.shape(0); c++) {
-        for (unsigned int s = 0; s < buffer.shape(1); s++) {
-          auto slice = xt::view(buffer, c, s, xt::all(), xt::all(), xt::all(), xt::all());
-          slice = fftshift(slice);
-          for (unsigned int coil = 0; coil < slice.shape(0); coil++) {
-            auto tmp1 = fftw_wrappers::ifft2(xt::xarray<std::complex<float>>(xt::view(slice, coil, 0, xt::all(), xt::all())));
-            tmp1 *= std::sqrt(1.0f * tmp1.size());
-            xt::view(slice, coil, 0, xt::all(), xt::all()) = tmp1;
-          }
-          slice = fftshift(slice);
-
-          std::array<size_t, 4> image_shape = {1, slice.shape(1), slice.shape(2), slice.shape(3)};
-          auto pixel_data = xt::sqrt(xt::abs(xt::sum(slice * xt::conj(slice), 0)));
-
-          auto xoffset = (slice.shape(3) + 1) / 2 - (rNx + 1) / 2;
-          auto yoffset = (slice.shape(2) + 1) / 2 - (rNy + 1) / 2;
-          auto zoffset = (slice.shape(1) + 1) / 2 - (rNz + 1) / 2;
-          auto combined = xt::view(pixel_data,
-                                   xt::range(zoffset, zoffset + rNz),
-                                   xt::range(yoffset, yoffset + rNy),
-                                   xt::range(xoffset, xoffset + rNx));
-
-          mrd::Image<float> im;
-          im.data = xt::zeros<float>(image_shape);
-          xt::view(im.data, 0, xt::all(), xt::all(), xt::all()) = combined;
-
-          im.head.measurement_uid = acq.head.measurement_uid;
-          im.head.field_of_view[0] = rFOVx;
-          im.head.field_of_view[1] = rFOVy;
-          im.head.field_of_view[2] = rFOVz;
-          im.head.position = ref_acq.head.position;
-          im.head.col_dir = ref_acq.head.read_dir;
-          im.head.line_dir = ref_acq.head.phase_dir;
-          im.head.slice_dir = ref_acq.head.slice_dir;
-          im.head.patient_table_position = ref_acq.head.patient_table_position;
-          im.head.average = ref_acq.head.idx.average;
-          im.head.slice = ref_acq.head.idx.slice;
-          im.head.contrast = ref_acq.head.idx.contrast;
-          im.head.phase = ref_acq.head.idx.phase;
-          im.head.repetition = ref_acq.head.idx.repetition;
-          im.head.set = ref_acq.head.idx.set;
-          im.head.acquisition_time_stamp_ns = ref_acq.head.acquisition_time_stamp_ns;
-          im.head.physiology_time_stamp_ns = ref_acq.head.physiology_time_stamp_ns;
-          im.head.image_type = mrd::ImageType::kMagnitude;
-          im.head.image_index = image_index++;
-          im.head.image_series_index = 0;
-          im.head.user_int = ref_acq.head.user_int;
-          im.head.user_float = ref_acq.head.user_float;
-          w.WriteData(im);
-        }
+      auto slice = xt::view(buffer, contrast, slice_index, xt::all(), xt::all(), xt::all(), xt::all());
+      slice = fftshift(slice);
+      for (unsigned int coil = 0; coil < slice.shape(0); coil++) {
+        auto tmp1 = fftw_wrappers::ifft2(xt::xarray<std::complex<float>>(xt::view(slice, coil, 0, xt::all(), xt::all())));
+        tmp1 *= std::sqrt(1.0f * tmp1.size());
+        xt::view(slice, coil, 0, xt::all(), xt::all()) = tmp1;
       }
+      slice = fftshift(slice);
+
+      std::array<size_t, 4> image_shape = {1, slice.shape(1), slice.shape(2), slice.shape(3)};
+      auto pixel_data = xt::sqrt(xt::abs(xt::sum(slice * xt::conj(slice), 0)));
+
+      auto xoffset = (slice.shape(3) + 1) / 2 - (rNx + 1) / 2;
+      auto yoffset = (slice.shape(2) + 1) / 2 - (rNy + 1) / 2;
+      auto zoffset = (slice.shape(1) + 1) / 2 - (rNz + 1) / 2;
+      auto combined = xt::view(pixel_data,
+                               xt::range(zoffset, zoffset + rNz),
+                               xt::range(yoffset, yoffset + rNy),
+                               xt::range(xoffset, xoffset + rNx));
+
+      mrd::Image<float> im;
+      im.data = xt::zeros<float>(image_shape);
+      xt::view(im.data, 0, xt::all(), xt::all(), xt::all()) = combined;
+
+      im.head.measurement_uid = acq.head.measurement_uid;
+      im.head.field_of_view[0] = rFOVx;
+      im.head.field_of_view[1] = rFOVy;
+      im.head.field_of_view[2] = rFOVz;
+      im.head.position = ref_head.position;
+      im.head.col_dir = ref_head.read_dir;
+      im.head.line_dir = ref_head.phase_dir;
+      im.head.slice_dir = ref_head.slice_dir;
+      im.head.patient_table_position = ref_head.patient_table_position;
+      im.head.average = ref_head.idx.average;
+      im.head.slice = ref_head.idx.slice;
+      im.head.contrast = ref_head.idx.contrast;
+      im.head.phase = ref_head.idx.phase;
+      im.head.repetition = ref_head.idx.repetition;
+      im.head.set = ref_head.idx.set;
+      im.head.acquisition_time_stamp_ns = ref_head.acquisition_time_stamp_ns;
+      im.head.physiology_time_stamp_ns = ref_head.physiology_time_stamp_ns;
+      im.head.image_type = mrd::ImageType::kMagnitude;
+      im.head.image_index = image_index++;
+      im.head.image_series_index = 0;
+      im.head.user_int = ref_head.user_int;
+      im.head.user_float = ref_head.user_float;
+      w.WriteData(im);
     }
+  };
+
+  // Acquisitions are decoded straight into the range. Other items are skipped.
+  auto selected = [&](mrd::Acquisition const& acq) {
+    return !repetition || acq.head.idx.repetition.value_or(0) == *repetition;
+  };
+  for (mrd::Acquisition& acq : mrd::Data<mrd::Acquisition>(r) | std::views::filter(selected)) {
+    handle_acquisition(std::move(acq));
   }
 
   w.EndData();
+  buffers.Release(std::move(buffer));
+  return true;
+}
+
+// Reconstructs a stream on worker processes started with --listen, possibly on
+// other machines. Acquisitions are routed to the workers by (repetition,
+// contrast, slice), so that each slice is reconstructed entirely by one worker,
+// and the repetitions of a slice are spread across the workers. The Images the
+// workers send back are encoded on the thread receiving them and written
+// through a ConcurrentMrdWriter, in the order in which a single process would
+// have written them.
+class DistributedRecon {
+ public:
+  explicit DistributedRecon(std::vector<socket_stream::Endpoint> const& endpoints) {
+    if (endpoints.empty()) {
+      throw std::invalid_argument("DistributedRecon needs at least one worker.");
+    }
+    for (auto const& endpoint : endpoints) {
+      workers_.push_back(std::make_unique<Worker>(endpoint));
+    }
+  }
+
+  ~DistributedRecon() {
+    Abort();
+    for (auto& worker : workers_) {
+      if (worker->receiver.joinable()) {
+        worker->receiver.join();
+      }
+    }
+  }
+
+  // Returns false if the stream has no header.
+  bool Run(mrd::MrdReaderBase& r, mrd::binary::MrdFormatWriter& w) {
+    std::optional<mrd::Header> header;
+    r.ReadHeader(header);
+    if (!header) {
+      return false;
+    }
+    w.WriteHeader(header);
+    mrd::binary::ConcurrentMrdWriter output(w);
+
+    uint32_t nslices = 1;
+    uint32_t ncontrasts = 1;
+    auto const& limits = header->encoding[0].encoding_limits;
+    if (limits.slice.has_value()) {
+      nslices = limits.slice->maximum + 1;
+    }
+    if (limits.contrast.has_value()) {
+      ncontrasts = limits.contrast->maximum + 1;
+    }
+
+    for (auto& worker : workers_) {
+      Worker* wk = worker.get();
+      wk->receiver = std::thread([this, wk, &output]() { Receive(*wk, output); });
+    }
+
+    try {
+      for (auto& worker : workers_) {
+        worker->writer.WriteHeader(header);
+      }
+
+      auto route = [&](mrd::Acquisition&& acq) {
+        auto repetition = acq.head.idx.repetition.value_or(0);
+        auto contrast = acq.head.idx.contrast.value_or(0);
+        auto slice = acq.head.idx.slice.value_or(0);
+        size_t index = ((static_cast<size_t>(repetition) * ncontrasts + contrast) * nslices + slice) % workers_.size();
+        // Workers write an Image for each slice they complete, which takes
+        // the next position in the output
+        bool completes_slice = !acq.head.flags.HasFlags(mrd::AcquisitionFlags::kIsNoiseMeasurement) &&
+                               (acq.head.flags.HasFlags(mrd::AcquisitionFlags::kLastInEncodeStep1) ||
+                                acq.head.flags.HasFlags(mrd::AcquisitionFlags::kLastInSlice));
+        if (completes_slice) {
+          workers_[index]->tickets.Push(output.ReserveTicket());
+        }
+        workers_[index]->writer.WriteData(mrd::StreamItem(std::move(acq)));
+      };
+
+      while (mrd::ReadData(r, route)) {
+      }
+
+      for (auto& worker : workers_) {
+        worker->tickets.Close();
+        worker->writer.EndData();
+        worker->writer.Close();
+        worker->stream.ShutdownOutput();
+      }
+    } catch (...) {
+      SetError();
+      Abort();
+    }
+
+    for (auto& worker : workers_) {
+      worker->receiver.join();
+    }
+
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    output.EndData();
+    return true;
+  }
+
+ private:
+  static constexpr size_t kUnbounded = std::numeric_limits<size_t>::max();
+
+  struct Worker {
+    explicit Worker(socket_stream::Endpoint const& endpoint)
+        : stream(socket_stream::Connect(endpoint)), writer(stream.Output()), tickets(kUnbounded) {}
+
+    socket_stream::SocketStream stream;
+    mrd::binary::MrdWriter writer;
+    // The positions in the output of the Images the worker has yet to send
+    mrd::concurrency::BoundedQueue<mrd::binary::ConcurrentMrdWriter::Ticket> tickets;
+    std::thread receiver;
+  };
+
+  // Writes each item received from the worker at the position reserved for
+  // it. Items beyond the reserved positions are appended as they arrive.
+  void Receive(Worker& worker, mrd::binary::ConcurrentMrdWriter& output) {
+    try {
+      mrd::binary::MrdReader reader(worker.stream.Input());
+      std::optional<mrd::Header> header;
+      reader.ReadHeader(header);
+      mrd::binary::ConcurrentMrdWriter::Ticket ticket;
+      mrd::StreamItem item;
+      while (reader.ReadData(item)) {
+        if (!worker.tickets.Pop(ticket)) {
+          ticket = output.ReserveTicket();
+        }
+        if (auto image = std::get_if<mrd::ImageFloat>(&item)) {
+          image->head.image_index = static_cast<uint32_t>(ticket);
+        }
+        output.WriteData(ticket, item);
+      }
+      // Positions reserved for Images the worker did not send
+      while (worker.tickets.Pop(ticket)) {
+        output.Skip(ticket);
+      }
+    } catch (...) {
+      SetError();
+      Abort();
+    }
+  }
+
+  void SetError() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!error_) {
+      error_ = std::current_exception();
+    }
+  }
+
+  // Wakes up all threads blocked on a worker or a queue.
+  void Abort() {
+    for (auto& worker : workers_) {
+      worker->stream.Abort();
+      worker->tickets.Cancel();
+    }
+  }
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::mutex mutex_;
+  std::exception_ptr error_;
+};
+
+std::unique_ptr<mrd::MrdReaderBase> make_reader(std::istream& stream, size_t prefetch_items) {
+  std::unique_ptr<mrd::MrdReaderBase> reader = std::make_unique<mrd::binary::MrdFormatReader>(stream);
+  if (prefetch_items > 0) {
+    reader = std::make_unique<mrd::PrefetchingMrdReader>(std::move(reader), mrd::PrefetchOptions{prefetch_items});
+  }
+  return reader;
+}
+
+// Reconstructs the stream sent over a client connection and sends the Images back.
+void serve_connection(int fd, size_t prefetch_items, BufferPool& buffers) {
+  socket_stream::SocketStream stream(fd);
+  try {
+    auto reader = make_reader(stream.Input(), prefetch_items);
+    mrd::binary::MrdWriter w(stream.Output());
+    if (!reconstruct(*reader, w, buffers)) {
+      throw std::runtime_error("Failed to read header");
+    }
+    reader->Close();
+    w.Close();
+    stream.ShutdownOutput();
+  } catch (...) {
+    // Unblocks a prefetching reader waiting for more input
+    stream.Abort();
+    throw;
+  }
+}
+
+// Accepts connections until SIGINT or SIGTERM, reconstructing up to `threads`
+// sessions at a time, then finishes the sessions in progress, closes the
+// connections still waiting for a thread and returns.
+// FFT plans and k-space buffers are shared by all sessions, so only the first
+// exam with a given protocol pays for them.
+void run_server(socket_stream::Endpoint const& endpoint, size_t threads, size_t prefetch_items) {
+  int listen_fd = socket_stream::Listen(endpoint);
+
+  // The signals are blocked in every thread, and taken by a thread of their own,
+  // which wakes up the accept loop through a pipe.
+  sigset_t stop_signals;
+  sigemptyset(&stop_signals);
+  sigaddset(&stop_signals, SIGINT);
+  sigaddset(&stop_signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+  int stop_pipe[2];
+  if (::pipe(stop_pipe) != 0) {
+    throw socket_stream::SocketError("pipe");
+  }
+
+  BufferPool buffers(threads);
+  mrd::concurrency::BoundedQueue<int> connections(threads);
+  std::atomic<bool> stopping{false};
+  std::atomic<uint64_t> session_count{0};
+
+  // Closing the queue also releases the accept loop if it is waiting for a
+  // thread to become available. The connections still queued are closed right
+  // away rather than once a session in progress ends.
+  std::thread signal_waiter([&]() {
+    int signal;
+    sigwait(&stop_signals, &signal);
+    stopping = true;
+    connections.Close();
+    int fd;
+    while (connections.TryPop(fd)) {
+      ::close(fd);
+    }
+    char byte = 0;
+    (void)!::write(stop_pipe[1], &byte, 1);
+  });
+
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < threads; i++) {
+    workers.emplace_back([&]() {
+      int fd;
+      while (connections.Pop(fd)) {
+        if (stopping) {
+          ::close(fd);
+          continue;
+        }
+        auto session = ++session_count;
+        auto start = std::chrono::steady_clock::now();
+        try {
+          serve_connection(fd, prefetch_items, buffers);
+          std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+          std::cerr << "Session " << session << " finished in " << elapsed.count() << " s" << std::endl;
+        } catch (std::exception const& e) {
+          std::cerr << "Session " << session << " failed: " << e.what() << std::endl;
+        }
+      }
+    });
+  }
+
+  std::cerr << "Listening on " << (endpoint.tcp ? endpoint.host + ":" + std::to_string(endpoint.port) : endpoint.path)
+            << " with " << threads << " threads" << std::endl;
+  std::exception_ptr error;
+  try {
+    int fd;
+    while ((fd = socket_stream::Accept(listen_fd, stop_pipe[0])) >= 0) {
+      if (!connections.Push(std::move(fd))) {
+        ::close(fd);
+      }
+    }
+    std::cerr << "Stopping after the sessions in progress" << std::endl;
+  } catch (...) {
+    error = std::current_exception();
+    pthread_kill(signal_waiter.native_handle(), SIGTERM);
+  }
+
+  ::close(listen_fd);
+  if (!endpoint.tcp) {
+    ::unlink(endpoint.path.c_str());
+  }
+  connections.Close();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  signal_waiter.join();
+  ::close(stop_pipe[0]);
+  ::close(stop_pipe[1]);
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  std::cerr << "Served " << session_count << " sessions" << std::endl;
+}
+
+// Sends the input stream to a server and writes the Images it sends back to the output.
+void run_client(socket_stream::Endpoint const& endpoint, std::istream& input, std::ostream& output) {
+  socket_stream::SocketStream stream(socket_stream::Connect(endpoint));
+  std::thread sender([&]() {
+    stream.Output() << input.rdbuf();
+    // The server reads in large blocks, so it needs to see the end of the input
+    stream.ShutdownOutput();
+  });
+  output << stream.Input().rdbuf();
+  sender.join();
+  output.flush();
+}
+
+void print_usage(std::string program_name) {
+  std::cerr << "Usage: " << program_name << std::endl;
+  std::cerr << "  -i|--input   <input MRD stream> (default: stdin)" << std::endl;
+  std::cerr << "  --input-shm  <shared memory name> (read from a shared memory ring buffer written by mrd_phantom --output-shm)" << std::endl;
+  std::cerr << "  -o|--output  <output MRD stream> (default: stdout)" << std::endl;
+  std::cerr << "  --prefetch   <number of items> (decode up to this many items ahead on a background thread)" << std::endl;
+  std::cerr << "  --repetition <repetition> (reconstruct only the acquisitions of this repetition)" << std::endl;
+  std::cerr << "  --listen     <socket path or tcp:port> (run as a server reconstructing each connection's stream)" << std::endl;
+  std::cerr << "  --threads    <number of threads> (sessions reconstructed concurrently by the server, default: 4)" << std::endl;
+  std::cerr << "  --connect    <socket path or tcp:port> (send the input to a server and write its output)" << std::endl;
+  std::cerr << "  --workers    <socket path or tcp:[host:]port>[,...] (distribute slices across servers and merge their output)" << std::endl;
+  std::cerr << "  -h|--help" << std::endl;
+}
+
+int main(int argc, char** argv) {
+  std::string input_path;
+  std::string input_shm_name;
+  std::string output_path;
+  size_t prefetch_items = 0;
+  std::optional<uint32_t> repetition;
+  std::string listen_endpoint;
+  std::string connect_endpoint;
+  size_t threads = 4;
+  std::vector<socket_stream::Endpoint> worker_endpoints;
+
+  std::vector<std::string> args(argv, argv + argc);
+  auto current_arg = args.begin() + 1;
+  while (current_arg != args.end()) {
+    if (*current_arg == "--help" || *current_arg == "-h") {
+      print_usage(args[0]);
+      return 0;
+    } else if (*current_arg == "--input" || *current_arg == "-i") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing input file" << std::endl;
+        print_usage(args[0]);
+        return 1;
+      }
+      input_path = *current_arg;
+      current_arg++;
+    } else if (*current_arg == "--input-shm") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing shared memory name" << std::endl;
+        print_usage(args[0]);
+        return 1;
+      }
+      input_shm_name = *current_arg;
+      current_arg++;
+    } else if (*current_arg == "--output" || *current_arg == "-o") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing output file" << std::endl;
+        print_usage(args[0]);
+        return 1;
+      }
+      output_path = *current_arg;
+      current_arg++;
+    } else if (*current_arg == "--prefetch") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing prefetch item count" << std::endl;
+        print_usage(args[0]);
+        return 1;
+      }
+      prefetch_items = std::stoul(*current_arg);
+      current_arg++;
+    } else if (*current_arg == "--repetition") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing repetition" << std::endl;
+        print_usage(args[0]);
+        return 1;
+      }
+      repetition = std::stoul(*current_arg);
+      current_arg++;
+    } else if (*current_arg == "--listen") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing listen endpoint" << std::endl;
+        print_usage(args[0]);
+        return 1;
+      }
+      listen_endpoint = *current_arg;
+      current_arg++;
+    } else if (*current_arg == "--threads") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing thread count" << std::endl;
+        print_usage(args[0]);
+        return 1;
+      }
+      threads = std::stoul(*current_arg);
+      if (threads == 0) {
+        std::cerr << "Thread count must be greater than zero" << std::endl;
+        return 1;
+      }
+      current_arg++;
+    } else if (*current_arg == "--connect") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing server endpoint" << std::endl;
+        print_usage(args[0]);
+        return 1;
+      }
+      connect_endpoint = *current_arg;
+      current_arg++;
+    } else if (*current_arg == "--workers") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing worker endpoints" << std::endl;
+        print_usage(args[0]);
+        return 1;
+      }
+      std::stringstream endpoints(*current_arg);
+      std::string endpoint;
+      while (std::getline(endpoints, endpoint, ',')) {
+        worker_endpoints.push_back(socket_stream::Endpoint::Parse(endpoint));
+      }
+      current_arg++;
+    } else {
+      std::cerr << "Unknown argument: " << *current_arg << std::endl;
+      print_usage(args[0]);
+      return 1;
+    }
+  }
+
+  if (repetition && (!listen_endpoint.empty() || !connect_endpoint.empty() || !worker_endpoints.empty())) {
+    std::cerr << "--repetition cannot be combined with --listen, --connect or --workers" << std::endl;
+    return 1;
+  }
+
+  if (!listen_endpoint.empty()) {
+    run_server(socket_stream::Endpoint::Parse(listen_endpoint), threads, prefetch_items);
+    return 0;
+  }
+
+  std::unique_ptr<std::ifstream> input_file;
+  if (!input_path.empty()) {
+    input_file = std::make_unique<std::ifstream>(input_path, std::ios::binary | std::ios::in);
+    if (!input_file->good()) {
+      throw std::runtime_error("Failed to open input file for reading.");
+    }
+  }
+
+  std::unique_ptr<mrd::binary::SharedMemoryInputStream> input_shm;
+  if (!input_shm_name.empty()) {
+    input_shm = std::make_unique<mrd::binary::SharedMemoryInputStream>(input_shm_name);
+  }
+
+  std::unique_ptr<std::ofstream> output_file;
+  if (!output_path.empty()) {
+    output_file = std::make_unique<std::ofstream>(output_path, std::ios::binary | std::ios::out);
+    if (!output_file->good()) {
+      throw std::runtime_error("Failed to open output file for writing.");
+    }
+  }
+
+  if (!connect_endpoint.empty()) {
+    run_client(socket_stream::Endpoint::Parse(connect_endpoint),
+               input_path.empty() ? std::cin : static_cast<std::istream&>(*input_file),
+               output_path.empty() ? std::cout : static_cast<std::ostream&>(*output_file));
+    return 0;
+  }
+
+  std::unique_ptr<mrd::MrdReaderBase> reader = std::make_unique<mrd::binary::MrdFormatReader>(
+      input_shm ? *input_shm : input_path.empty() ? std::cin : static_cast<std::istream&>(*input_file));
+  mrd::PrefetchingMrdReader* prefetching_reader = nullptr;
+  if (prefetch_items > 0) {
+    auto prefetching = std::make_unique<mrd::PrefetchingMrdReader>(std::move(reader), mrd::PrefetchOptions{prefetch_items});
+    prefetching_reader = prefetching.get();
+    reader = std::move(prefetching);
+  }
+  mrd::MrdReaderBase& r = *reader;
+  mrd::binary::MrdFormatWriter w(output_path.empty() ? std::cout : *output_file);
+  BufferPool buffers;
+
+  bool has_header;
+  if (!worker_endpoints.empty()) {
+    DistributedRecon recon(worker_endpoints);
+    has_header = recon.Run(r, w);
+  } else {
+    has_header = reconstruct(r, w, buffers, repetition);
+  }
+  if (!has_header) {
+    std::cerr << "Failed to read header" << std::endl;
+    return 1;
+  }
+
+  if (prefetching_reader) {
+    using seconds = std::chrono::duration<double>;
+    auto stats = prefetching_reader->GetStats();
+    std::cerr << "Prefetched " << stats.items << " items: waited "
+              << seconds(stats.consumer_wait_time).count() << " s for input, spent "
+              << seconds(stats.consumer_time).count() << " s reconstructing" << std::endl;
+  }
 
   return 0;
 }
@@ -1,16 +1,73 @@
-#include "mrd/binary/protocols.h"
-#include "mrd/hdf5/protocols.h"
+#include "mrd/binary/format.h"
+#include "mrd/hdf5/file.h"
+#include "mrd/pipelined_copy.h"
+
+#include <iostream>
 
 int main(int argc, char** argv) {
+  auto print_usage = [&]() {
+    std::cerr << "Usage: " << argv[0] << " <filename> [options]" << std::endl;
+    std::cerr << "  --stats                      (report the throughput of the copy)" << std::endl;
+    std::cerr << "  --dense                      (store arrays in dense datasets under Mrd/arrays)" << std::endl;
+    std::cerr << "  --compression <deflate|zstd> (compress datasets with fixed-size elements)" << std::endl;
+    std::cerr << "  --key-tables                 (write key tables for selecting acquisitions and images)" << std::endl;
+    std::cerr << "  --swmr                       (let mrd_hdf5_to_stream --swmr read the file while it is written;" << std::endl;
+    std::cerr << "                                only items of fixed size, such as Pulseq events, can be written)" << std::endl;
+  };
+
   if (argc < 2) {
-    std::cerr << "Usage: " << argv[0] << " <filename>" << std::endl;
+    print_usage();
     return 1;
   }
 
   std::string filename = argv[1];
+  bool print_stats = false;
+  mrd::hdf5::MrdWriterOptions mrd_options;
+  mrd::hdf5::Hdf5Options options;
 
-  mrd::binary::MrdReader r(std::cin);
-  mrd::hdf5::MrdWriter w(filename);
-  r.CopyTo(w);
+  std::vector<std::string> args(argv + 2, argv + argc);
+  for (auto current_arg = args.begin(); current_arg != args.end(); current_arg++) {
+    if (*current_arg == "--stats") {
+      print_stats = true;
+    } else if (*current_arg == "--dense") {
+      mrd_options.array_layout = mrd::hdf5::ArrayLayout::kDense;
+    } else if (*current_arg == "--key-tables") {
+      mrd_options.key_tables = true;
+    } else if (*current_arg == "--swmr") {
+      options.swmr = true;
+    } else if (*current_arg == "--compression") {
+      current_arg++;
+      if (current_arg == args.end()) {
+        std::cerr << "Missing compression" << std::endl;
+        print_usage();
+        return 1;
+      }
+      if (*current_arg == "deflate") {
+        options.compression = mrd::hdf5::Compression::kDeflate;
+      } else if (*current_arg == "zstd") {
+        options.compression = mrd::hdf5::Compression::kZstd;
+      } else {
+        std::cerr << "Unknown compression: " << *current_arg << std::endl;
+        print_usage();
+        return 1;
+      }
+    } else {
+      std::cerr << "Unknown option: " << *current_arg << std::endl;
+      print_usage();
+      return 1;
+    }
+  }
+
+  mrd::binary::MrdFormatReader r(std::cin);
+  mrd::hdf5::MrdFileWriter w(filename, mrd_options, options);
+  auto stats = mrd::CopyToPipelined(r, w, 64);
+  if (print_stats) {
+    std::cerr << "Copied " << stats.items << " items in " << stats.elapsed.count() << " s ("
+              << stats.ItemsPerSecond() << " items/s)" << std::endl
+              << "  reader: " << stats.read_time.count() << " s reading, "
+              << stats.reader_wait_time.count() << " s waiting for the writer" << std::endl
+              << "  writer: " << stats.write_time.count() << " s writing, "
+              << stats.writer_wait_time.count() << " s waiting for the reader" << std::endl;
+  }
   return 0;
 }
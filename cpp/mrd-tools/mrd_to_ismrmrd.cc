@@ -1,5 +1,5 @@
 #include "converters.h"
-#include "mrd/binary/protocols.h"
+#include "mrd/binary/format.h"
 #include <exception>
 #include <iostream>
 #include <ismrmrd/dataset.h>
@@ -69,7 +69,7 @@ int main(int argc, char** argv) {
 
   ISMRMRD::OStreamView ws(output_path.empty() ? std::cout : *output_file);
   ISMRMRD::ProtocolSerializer serializer(ws);
-  mrd::binary::MrdReader r(input_path.empty() ? std::cin : *input_file);
+  mrd::binary::MrdFormatReader r(input_path.empty() ? std::cin : *input_file);
 
   using namespace mrd::converters;
 
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace socket_stream {
+
+// A buffered streambuf reading from and writing to a connected socket.
+class SocketBuffer : public std::streambuf {
+ public:
+  explicit SocketBuffer(int fd, size_t buffer_size = 65536)
+      : fd_(fd), input_(buffer_size), output_(buffer_size) {
+    setp(output_.data(), output_.data() + output_.size());
+  }
+
+  ~SocketBuffer() override {
+    sync();
+  }
+
+ protected:
+  int_type underflow() override {
+    ssize_t n;
+    do {
+      n = ::recv(fd_, input_.data(), input_.size(), 0);
+    } while (n < 0 && errno == EINTR);
+    if (n <= 0) {
+      return traits_type::eof();
+    }
+    setg(input_.data(), input_.data(), input_.data() + n);
+    return traits_type::to_int_type(*gptr());
+  }
+
+  int_type overflow(int_type ch) override {
+    if (!FlushOutput()) {
+      return traits_type::eof();
+    }
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+    }
+    return traits_type::not_eof(ch);
+  }
+
+  std::streamsize xsputn(char const* s, std::streamsize count) override {
+    // Large writes go straight to the socket
+    if (count >= static_cast<std::streamsize>(output_.size())) {
+      if (!FlushOutput() || !SendAll(s, count)) {
+        return 0;
+      }
+      return count;
+    }
+    return std::streambuf::xsputn(s, count);
+  }
+
+  int sync() override {
+    return FlushOutput() ? 0 : -1;
+  }
+
+ private:
+  bool FlushOutput() {
+    bool ok = SendAll(pbase(), pptr() - pbase());
+    setp(output_.data(), output_.data() + output_.size());
+    return ok;
+  }
+
+  bool SendAll(char const* data, size_t size) {
+    while (size > 0) {
+      ssize_t n = ::send(fd_, data, size, MSG_NOSIGNAL);
+      if (n < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+      data += n;
+      size -= n;
+    }
+    return true;
+  }
+
+  int fd_;
+  std::vector<char> input_;
+  std::vector<char> output_;
+};
+
+// A connected socket with an input and an output stream, which it closes on
+// destruction. The two streams share a buffer but not their state, so that
+// reaching the end of the input does not fail later writes, and each can be
+// used from a different thread.
+class SocketStream {
+ public:
+  explicit SocketStream(int fd) : fd_(fd), buffer_(fd), input_(&buffer_), output_(&buffer_) {}
+
+  ~SocketStream() {
+    output_.flush();
+    ::close(fd_);
+  }
+
+  SocketStream(SocketStream const&) = delete;
+  SocketStream& operator=(SocketStream const&) = delete;
+
+  std::istream& Input() {
+    return input_;
+  }
+
+  std::ostream& Output() {
+    return output_;
+  }
+
+  // Flushes the output and signals the end of it to the peer, which can still send.
+  void ShutdownOutput() {
+    output_.flush();
+    ::shutdown(fd_, SHUT_WR);
+  }
+
+  // Shuts down both directions, waking up any thread blocked on the socket.
+  void Abort() {
+    ::shutdown(fd_, SHUT_RDWR);
+  }
+
+ private:
+  int fd_;
+  SocketBuffer buffer_;
+  std::istream input_;
+  std::ostream output_;
+};
+
+inline std::system_error SocketError(std::string const& what) {
+  return std::system_error(errno, std::generic_category(), what);
+}
+
+// Endpoints are either a Unix domain socket path or "tcp:<port>" for a TCP
+// port on the loopback interface, or "tcp:<host>:<port>" to connect elsewhere.
+struct Endpoint {
+  bool tcp = false;
+  std::string path;
+  std::string host = "127.0.0.1";
+  uint16_t port = 0;
+
+  static Endpoint Parse(std::string const& spec) {
+    Endpoint endpoint;
+    if (spec.rfind("tcp:", 0) != 0) {
+      endpoint.path = spec;
+      return endpoint;
+    }
+
+    endpoint.tcp = true;
+    std::string rest = spec.substr(4);
+    auto colon = rest.rfind(':');
+    if (colon != std::string::npos) {
+      endpoint.host = rest.substr(0, colon);
+      rest = rest.substr(colon + 1);
+    }
+    endpoint.port = static_cast<uint16_t>(std::stoul(rest));
+    return endpoint;
+  }
+};
+
+inline int Listen(Endpoint const& endpoint, int backlog = 64) {
+  int fd;
+  if (endpoint.tcp) {
+    fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+      throw SocketError("socket");
+    }
+    int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(endpoint.port);
+    if (::inet_pton(AF_INET, endpoint.host.c_str(), &addr.sin_addr) != 1) {
+      ::close(fd);
+      throw std::runtime_error("Invalid IPv4 address: " + endpoint.host);
+    }
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+      ::close(fd);
+      throw SocketError("bind");
+    }
+  } else {
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+      throw SocketError("socket");
+    }
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    if (endpoint.path.size() >= sizeof(addr.sun_path)) {
+      ::close(fd);
+      throw std::runtime_error("Socket path is too long: " + endpoint.path);
+    }
+    std::strncpy(addr.sun_path, endpoint.path.c_str(), sizeof(addr.sun_path) - 1);
+    ::unlink(endpoint.path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+      ::close(fd);
+      throw SocketError("bind");
+    }
+  }
+
+  if (::listen(fd, backlog) < 0) {
+    ::close(fd);
+    throw SocketError("listen");
+  }
+  return fd;
+}
+
+inline int Accept(int listen_fd) {
+  int fd;
+  do {
+    fd = ::accept(listen_fd, nullptr, nullptr);
+  } while (fd < 0 && errno == EINTR);
+  if (fd < 0) {
+    throw SocketError("accept");
+  }
+  return fd;
+}
+
+// Like Accept(), but returns -1 once `stop_fd` becomes readable and no more
+// connections are pending.
+inline int Accept(int listen_fd, int stop_fd) {
+  pollfd fds[2] = {{listen_fd, POLLIN, 0}, {stop_fd, POLLIN, 0}};
+  while (true) {
+    if (::poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw SocketError("poll");
+    }
+    if (fds[0].revents != 0) {
+      return Accept(listen_fd);
+    }
+    if (fds[1].revents != 0) {
+      return -1;
+    }
+  }
+}
+
+inline int Connect(Endpoint const& endpoint) {
+  int fd;
+  int result;
+  if (endpoint.tcp) {
+    fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+      throw SocketError("socket");
+    }
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(endpoint.port);
+    if (::inet_pton(AF_INET, endpoint.host.c_str(), &addr.sin_addr) != 1) {
+      ::close(fd);
+      throw std::runtime_error("Invalid IPv4 address: " + endpoint.host);
+    }
+    result = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  } else {
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+      throw SocketError("socket");
+    }
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, endpoint.path.c_str(), sizeof(addr.sun_path) - 1);
+    result = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+  }
+
+  if (result < 0) {
+    ::close(fd);
+    throw SocketError("connect");
+  }
+  return fd;
+}
+
+} // namespace socket_stream
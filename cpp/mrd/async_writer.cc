@@ -0,0 +1,69 @@
+#include "async_writer.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "byte_size.h"
+
+namespace mrd {
+
+namespace {
+using Event = detail::WriterWorker::Event;
+} // namespace
+
+AsyncMrdWriter::AsyncMrdWriter(std::unique_ptr<MrdWriterBase> writer, AsyncWriterOptions options) {
+  if (!writer) {
+    throw std::invalid_argument("AsyncMrdWriter writer must not be null.");
+  }
+
+  worker_ = std::make_unique<detail::WriterWorker>(std::move(writer), options.max_items, options.max_bytes);
+}
+
+AsyncMrdWriter::~AsyncMrdWriter() = default;
+
+AsyncWriterStats AsyncMrdWriter::GetStats() const {
+  AsyncWriterStats stats;
+  stats.items_written = worker_->ItemsWritten();
+  stats.write_time = worker_->WriteTime();
+  stats.wait_time = worker_->PushWaitTime();
+  return stats;
+}
+
+void AsyncMrdWriter::Flush() {
+  auto flushed = worker_->Flush();
+  worker_->Wait(flushed);
+}
+
+void AsyncMrdWriter::WriteHeaderImpl(std::optional<mrd::Header> const& value) {
+  Enqueue(detail::WriterWorker::HeaderEvent{std::make_shared<std::optional<mrd::Header> const>(value)}, 0);
+}
+
+void AsyncMrdWriter::WriteDataImpl(mrd::StreamItem&& value) {
+  size_t bytes = sizeof(mrd::StreamItem) + yardl::ByteSize(value);
+  Enqueue(detail::WriterWorker::ItemEvent{std::move(value)}, bytes);
+}
+
+void AsyncMrdWriter::WriteDataImpl(std::vector<mrd::StreamItem>&& values) {
+  size_t bytes = 0;
+  for (auto const& value : values) {
+    bytes += sizeof(mrd::StreamItem) + yardl::ByteSize(value);
+  }
+
+  Enqueue(detail::WriterWorker::ItemsEvent{std::move(values)}, bytes);
+}
+
+void AsyncMrdWriter::EndDataImpl() {
+  Enqueue(detail::WriterWorker::EndDataEvent{}, 0);
+}
+
+void AsyncMrdWriter::CloseImpl() {
+  worker_->Close();
+}
+
+void AsyncMrdWriter::Enqueue(Event&& event, size_t bytes) {
+  if (!worker_->Push(std::move(event), bytes)) {
+    throw std::runtime_error("AsyncMrdWriter is closed.");
+  }
+}
+
+} // namespace mrd
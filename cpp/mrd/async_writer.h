@@ -0,0 +1,69 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "moving_writer.h"
+#include "writer_worker.h"
+
+namespace mrd {
+struct AsyncWriterOptions {
+  // Maximum number of writes queued for the background thread.
+  size_t max_items = 1024;
+
+  // Maximum in-memory size of the queued items, as given by yardl::ByteSize(),
+  // or 0 for no limit.
+  size_t max_bytes = size_t{256} << 20;
+};
+
+struct AsyncWriterStats {
+  uint64_t items_written = 0;
+
+  // Time the background thread spent in the underlying writer.
+  std::chrono::steady_clock::duration write_time{};
+
+  // Time callers were blocked because the queue was at its limits.
+  std::chrono::steady_clock::duration wait_time{};
+};
+
+// Writer for the Mrd protocol that hands everything written to it to another
+// writer on a background thread, so that producers are not blocked by slow
+// backends such as mrd::hdf5::MrdWriter. For example:
+//   mrd::AsyncMrdWriter w(std::make_unique<mrd::hdf5::MrdWriter>("capture.h5"));
+//
+// Items written as rvalues are moved into the queue; lvalues are copied.
+// Writes return as soon as the item is queued, and only block once the queue
+// holds AsyncWriterOptions::max_items writes or max_bytes bytes.
+// An exception thrown by the underlying writer is rethrown by the next call,
+// at the latest by Close().
+//
+// Close() waits for all queued writes to complete and then closes the
+// underlying writer. Destroying the writer without calling Close() discards
+// the writes still queued.
+class AsyncMrdWriter : public MrdMovingWriterBase {
+  public:
+  AsyncMrdWriter(std::unique_ptr<MrdWriterBase> writer, AsyncWriterOptions options = {});
+  ~AsyncMrdWriter() override;
+
+  AsyncWriterStats GetStats() const;
+
+  // Waits until all queued writes are complete and flushes the underlying writer.
+  void Flush() override;
+
+  protected:
+  void WriteHeaderImpl(std::optional<mrd::Header> const& value) override;
+  void WriteDataImpl(mrd::StreamItem&& value) override;
+  void WriteDataImpl(std::vector<mrd::StreamItem>&& values) override;
+  void EndDataImpl() override;
+  void CloseImpl() override;
+
+  private:
+  void Enqueue(detail::WriterWorker::Event&& event, size_t bytes);
+
+  std::unique_ptr<detail::WriterWorker> worker_;
+};
+
+} // namespace mrd
@@ -0,0 +1,178 @@
+#include "codec.h"
+
+#include <array>
+#include <cstring>
+#include <streambuf>
+#include <utility>
+
+namespace mrd::binary {
+namespace {
+// Appends what is written to a byte vector, dropping a given number of bytes
+// first and everything written while there is no vector.
+class VectorOutput : public std::streambuf {
+  public:
+  void Reset(std::vector<uint8_t>* bytes, size_t skip) {
+    bytes_ = bytes;
+    skip_ = skip;
+  }
+
+  protected:
+  std::streamsize xsputn(char const* s, std::streamsize count) override {
+    std::streamsize skipped = std::min<std::streamsize>(count, static_cast<std::streamsize>(skip_));
+    skip_ -= static_cast<size_t>(skipped);
+    if (bytes_ != nullptr) {
+      bytes_->insert(bytes_->end(), s + skipped, s + count);
+    }
+    return count;
+  }
+
+  int_type overflow(int_type ch) override {
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+      char c = traits_type::to_char_type(ch);
+      xsputn(&c, 1);
+    }
+    return traits_type::not_eof(ch);
+  }
+
+  private:
+  std::vector<uint8_t>* bytes_ = nullptr;
+  size_t skip_ = 0;
+};
+
+// The encoding of a header that is not set
+constexpr std::array<uint8_t, 1> kNoHeader = {0};
+} // namespace
+
+// Receives the output of the generated writer. The stream's preamble and the
+// block count of each item are dropped.
+class ItemEncoder::Output : public VectorOutput {};
+
+ItemEncoder::ItemEncoder(Version version)
+    : version_(version), output_(std::make_unique<Output>()), stream_(output_.get()), writer_(stream_, version) {
+  writer_.WriteHeader(std::nullopt);
+  writer_.Flush();
+}
+
+ItemEncoder::~ItemEncoder() = default;
+
+void ItemEncoder::EncodeHeader(std::optional<mrd::Header> const& value, std::vector<uint8_t>& bytes) {
+  VectorOutput output;
+  std::ostream stream(&output);
+  mrd::binary::MrdWriter writer(stream, version_);
+  writer.Flush();
+
+  output.Reset(&bytes, 0);
+  writer.WriteHeader(value);
+  writer.Flush();
+}
+
+void ItemEncoder::Encode(mrd::StreamItem const& value, std::vector<uint8_t>& bytes) {
+  // Each item is written as a block of one item, whose count is one byte
+  output_->Reset(&bytes, 1);
+  try {
+    writer_.WriteData(value);
+    writer_.Flush();
+  } catch (...) {
+    output_->Reset(nullptr, 0);
+    throw;
+  }
+  output_->Reset(nullptr, 0);
+}
+
+// Presents the preamble, the header and the items of the source to the
+// generated reader as a binary stream with blocks of one item each.
+class ItemDecoder::Input : public std::streambuf {
+  public:
+  Input(std::vector<uint8_t> const& preamble, Source& source, uint8_t const* header, size_t header_size)
+      : preamble_(preamble), source_(source), header_(header), header_size_(header_size) {}
+
+  protected:
+  int_type underflow() override {
+    while (gptr() == egptr()) {
+      switch (next_) {
+        case Part::kPreamble:
+          Show(preamble_.data(), preamble_.size());
+          next_ = Part::kHeader;
+          break;
+        case Part::kHeader:
+          Show(header_, header_size_);
+          next_ = Part::kItemCount;
+          break;
+        case Part::kItemCount:
+          if (source_.NextItem(item_, item_size_)) {
+            Show(&kItemCount, 1);
+            next_ = Part::kItem;
+          } else {
+            Show(&kEndCount, 1);
+            next_ = Part::kEnd;
+          }
+          break;
+        case Part::kItem:
+          Show(item_, item_size_);
+          next_ = Part::kItemCount;
+          break;
+        case Part::kEnd:
+          return traits_type::eof();
+      }
+    }
+    return traits_type::to_int_type(*gptr());
+  }
+
+  private:
+  enum class Part {
+    kPreamble,
+    kHeader,
+    kItemCount,
+    kItem,
+    kEnd,
+  };
+
+  static constexpr uint8_t kItemCount = 1;
+  static constexpr uint8_t kEndCount = 0;
+
+  void Show(uint8_t const* data, size_t size) {
+    char* begin = reinterpret_cast<char*>(const_cast<uint8_t*>(data));
+    setg(begin, begin, begin + size);
+  }
+
+  std::vector<uint8_t> const& preamble_;
+  Source& source_;
+  uint8_t const* header_;
+  size_t header_size_;
+  Part next_ = Part::kPreamble;
+  uint8_t const* item_ = nullptr;
+  size_t item_size_ = 0;
+};
+
+std::vector<uint8_t> ItemDecoder::Preamble(std::string const& schema) {
+  std::vector<uint8_t> bytes;
+  VectorOutput output;
+  output.Reset(&bytes, 0);
+  std::ostream stream(&output);
+  // The generated writer writes the preamble of its own schema, so write it here
+  yardl::binary::CodedOutputStream coded(stream);
+  yardl::binary::WriteHeader(coded, schema);
+  coded.Flush();
+  return bytes;
+}
+
+ItemDecoder::ItemDecoder(std::vector<uint8_t> const& preamble, Source& source, uint8_t const* header, size_t header_size)
+    : input_(std::make_unique<Input>(preamble, source, header, header_size)), stream_(input_.get()), reader_(stream_) {}
+
+ItemDecoder::ItemDecoder(std::vector<uint8_t> const& preamble, Source& source)
+    : ItemDecoder(preamble, source, kNoHeader.data(), kNoHeader.size()) {
+  std::optional<mrd::Header> unused;
+  reader_.ReadHeader(unused);
+}
+
+ItemDecoder::~ItemDecoder() = default;
+
+void ItemDecoder::ReadHeader(std::optional<mrd::Header>& value) {
+  reader_.ReadHeader(value);
+}
+
+bool ItemDecoder::Read(mrd::StreamItem& value) {
+  return reader_.ReadData(value);
+}
+
+} // namespace mrd::binary
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "protocols.h"
+
+namespace mrd::binary {
+// Encodes the header and the items of the `data` stream of the Mrd protocol,
+// one at a time, as the generated MrdWriter writes them to a binary stream,
+// but without the stream's preamble and block counts. MrdFormatWriter frames
+// and transforms these encodings before writing them.
+class ItemEncoder {
+  public:
+  explicit ItemEncoder(Version version = Version::Current);
+  ~ItemEncoder();
+
+  ItemEncoder(ItemEncoder const&) = delete;
+  ItemEncoder& operator=(ItemEncoder const&) = delete;
+
+  // Appends the encoding of the header to `bytes`.
+  void EncodeHeader(std::optional<mrd::Header> const& value, std::vector<uint8_t>& bytes);
+
+  // Appends the encoding of an item to `bytes`.
+  void Encode(mrd::StreamItem const& value, std::vector<uint8_t>& bytes);
+
+  private:
+  class Output;
+
+  Version version_;
+  std::unique_ptr<Output> output_;
+  std::ostream stream_;
+  mrd::binary::MrdWriter writer_;
+};
+
+// Decodes the header and the items of the `data` stream of the Mrd protocol
+// from the encodings produced by ItemEncoder, with the generated MrdReader.
+// The generated reader reads ahead, so the decoder pulls the encodings of the
+// items from a Source as the reader asks for more input, usually before the
+// items are returned by Read().
+class ItemDecoder {
+  public:
+  class Source {
+    public:
+    virtual ~Source() = default;
+
+    // Sets `data` and `size` to the encoding of the next item, which must stay
+    // valid until the next call, or returns false to end the items of this
+    // decoder.
+    virtual bool NextItem(uint8_t const*& data, size_t& size) = 0;
+  };
+
+  // The beginning of a binary stream with the given schema, which decoders
+  // for the stream share.
+  static std::vector<uint8_t> Preamble(std::string const& schema);
+
+  // A decoder for the encoded header and the following items. Call
+  // ReadHeader() first.
+  ItemDecoder(std::vector<uint8_t> const& preamble, Source& source, uint8_t const* header, size_t header_size);
+
+  // A decoder for items only, e.g. once a previous decoder has ended.
+  ItemDecoder(std::vector<uint8_t> const& preamble, Source& source);
+
+  ~ItemDecoder();
+
+  ItemDecoder(ItemDecoder const&) = delete;
+  ItemDecoder& operator=(ItemDecoder const&) = delete;
+
+  void ReadHeader(std::optional<mrd::Header>& value);
+
+  // Returns false once the source has ended this decoder's items.
+  [[nodiscard]] bool Read(mrd::StreamItem& value);
+
+  private:
+  class Input;
+
+  std::unique_ptr<Input> input_;
+  std::istream stream_;
+  mrd::binary::MrdReader reader_;
+};
+
+} // namespace mrd::binary
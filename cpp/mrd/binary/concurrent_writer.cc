@@ -0,0 +1,121 @@
+#include "concurrent_writer.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace mrd::binary {
+
+ConcurrentMrdWriter::ConcurrentMrdWriter(MrdFormatWriter& writer, CommitOrder order)
+    : writer_(writer), order_(order) {}
+
+ConcurrentMrdWriter::Ticket ConcurrentMrdWriter::ReserveTicket() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ThrowIfFailed();
+  return next_ticket_++;
+}
+
+void ConcurrentMrdWriter::WriteData(Ticket ticket, std::vector<mrd::StreamItem> const& values) {
+  MrdEncodedData data;
+  try {
+    data = writer_.EncodeData(values);
+  } catch (...) {
+    try {
+      Skip(ticket);
+    } catch (...) {
+    }
+    throw;
+  }
+
+  Commit(ticket, std::move(data));
+}
+
+void ConcurrentMrdWriter::WriteData(Ticket ticket, mrd::StreamItem const& value) {
+  MrdEncodedData data;
+  try {
+    data = writer_.EncodeData(value);
+  } catch (...) {
+    try {
+      Skip(ticket);
+    } catch (...) {
+    }
+    throw;
+  }
+
+  Commit(ticket, std::move(data));
+}
+
+void ConcurrentMrdWriter::WriteData(std::vector<mrd::StreamItem> const& values) {
+  WriteData(ReserveTicket(), values);
+}
+
+void ConcurrentMrdWriter::WriteData(mrd::StreamItem const& value) {
+  WriteData(ReserveTicket(), value);
+}
+
+void ConcurrentMrdWriter::Skip(Ticket ticket) {
+  Commit(ticket, MrdEncodedData{});
+}
+
+void ConcurrentMrdWriter::EndData() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  all_committed_.wait(lock, [this] { return committed_ == next_ticket_ || error_; });
+  ThrowIfFailed();
+  writer_.EndData();
+}
+
+size_t ConcurrentMrdWriter::PendingBlocks() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pending_.size();
+}
+
+void ConcurrentMrdWriter::Commit(Ticket ticket, MrdEncodedData&& data) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ThrowIfFailed();
+  if (ticket >= next_ticket_) {
+    throw std::runtime_error("Ticket " + std::to_string(ticket) + " was not reserved.");
+  }
+  if (IsCommitted(ticket)) {
+    throw std::runtime_error("Ticket " + std::to_string(ticket) + " was already committed.");
+  }
+
+  committed_above_.insert(ticket);
+  for (auto lowest = committed_above_.begin(); lowest != committed_above_.end() && *lowest == committed_below_;
+       lowest = committed_above_.erase(lowest)) {
+    committed_below_++;
+  }
+
+  try {
+    if (order_ == CommitOrder::kCompletion) {
+      writer_.WriteEncodedData(data);
+    } else {
+      pending_.emplace(ticket, std::move(data));
+      for (auto next = pending_.begin(); next != pending_.end() && next->first == next_to_write_;
+           next = pending_.erase(next)) {
+        writer_.WriteEncodedData(next->second);
+        next_to_write_++;
+      }
+    }
+  } catch (...) {
+    // The underlying stream is now in an unknown state
+    error_ = std::current_exception();
+    all_committed_.notify_all();
+    throw;
+  }
+
+  if (++committed_ == next_ticket_) {
+    all_committed_.notify_all();
+  }
+}
+
+bool ConcurrentMrdWriter::IsCommitted(Ticket ticket) const {
+  return ticket < committed_below_ || committed_above_.count(ticket) != 0;
+}
+
+void ConcurrentMrdWriter::ThrowIfFailed() const {
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+} // namespace mrd::binary
@@ -0,0 +1,91 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "format.h"
+
+namespace mrd::binary {
+// The order in which a ConcurrentMrdWriter writes the blocks submitted to it.
+enum class CommitOrder {
+  // In the order their tickets were reserved, holding back blocks that
+  // complete early until all earlier tickets have been committed.
+  kSubmission,
+  // As soon as each block has been encoded.
+  kCompletion,
+};
+
+// A thread-safe front-end to an MrdFormatWriter, for writing the `data` stream
+// from several threads, e.g. recon workers each producing the images of one slice.
+//
+// Each thread encodes its items into a private buffer on its own, and only
+// the write of the finished block to the underlying writer is serialized, so
+// encoding scales with the number of threads.
+//
+// Write the header to the underlying writer first. Then, with kSubmission
+// order, reserve a ticket for each unit of work in the order its output should
+// appear in the stream (typically when dispatching it), and pass the ticket to
+// WriteData() when the work is done:
+//   auto ticket = concurrent_writer.ReserveTicket();
+//   pool.Submit([&, ticket] { concurrent_writer.WriteData(ticket, ReconSlice(...)); });
+// Every reserved ticket must be committed exactly once, with WriteData() or
+// Skip(). Finally, EndData() waits for all tickets to be committed and ends the
+// `data` stream of the underlying writer.
+class ConcurrentMrdWriter {
+  public:
+  using Ticket = uint64_t;
+
+  ConcurrentMrdWriter(MrdFormatWriter& writer, CommitOrder order = CommitOrder::kSubmission);
+
+  ConcurrentMrdWriter(ConcurrentMrdWriter const&) = delete;
+  ConcurrentMrdWriter& operator=(ConcurrentMrdWriter const&) = delete;
+
+  // Reserves the position of a block in the stream.
+  Ticket ReserveTicket();
+
+  // Encodes the values on the calling thread and commits them as one block.
+  // If encoding fails, the ticket is skipped so later blocks are not held back,
+  // and the exception is rethrown.
+  void WriteData(Ticket ticket, std::vector<mrd::StreamItem> const& values);
+  void WriteData(Ticket ticket, mrd::StreamItem const& value);
+
+  // Like the above, reserving a ticket at the time of the call.
+  void WriteData(std::vector<mrd::StreamItem> const& values);
+  void WriteData(mrd::StreamItem const& value);
+
+  // Commits a ticket without writing anything.
+  void Skip(Ticket ticket);
+
+  // Waits until all reserved tickets are committed, then ends the `data` stream.
+  void EndData();
+
+  // Number of blocks that are encoded but held back waiting for earlier tickets.
+  size_t PendingBlocks() const;
+
+  private:
+  void Commit(Ticket ticket, MrdEncodedData&& data);
+  bool IsCommitted(Ticket ticket) const;
+  void ThrowIfFailed() const;
+
+  MrdFormatWriter& writer_;
+  CommitOrder const order_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable all_committed_;
+  Ticket next_ticket_ = 0;
+  Ticket next_to_write_ = 0;
+  size_t committed_ = 0;
+  // The tickets below committed_below_ and those in committed_above_ have
+  // been committed.
+  Ticket committed_below_ = 0;
+  std::set<Ticket> committed_above_;
+  std::map<Ticket, MrdEncodedData> pending_;
+  std::exception_ptr error_;
+};
+
+} // namespace mrd::binary
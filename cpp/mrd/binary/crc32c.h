@@ -0,0 +1,150 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MRD_CRC32C_X86 1
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#define MRD_CRC32C_ARM 1
+#include <arm_acle.h>
+#endif
+
+// CRC-32C (Castagnoli), as used by iSCSI, ext4 and many storage formats.
+// Uses the SSE4.2 crc32 instruction (or the ARMv8 CRC32 extension) when
+// available and a slicing-by-8 table otherwise.
+namespace mrd::binary {
+
+namespace crc32c_detail {
+static constexpr uint32_t kPolynomial = 0x82F63B78;  // reflected 0x1EDC6F41
+
+using Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+constexpr Tables MakeTables() {
+  Tables tables{};
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (kPolynomial & (0u - (crc & 1)));
+    }
+    tables[0][i] = crc;
+  }
+
+  for (uint32_t i = 0; i < 256; i++) {
+    for (size_t t = 1; t < tables.size(); t++) {
+      uint32_t prev = tables[t - 1][i];
+      tables[t][i] = (prev >> 8) ^ tables[0][prev & 0xFF];
+    }
+  }
+
+  return tables;
+}
+
+static inline constexpr Tables kTables = MakeTables();
+
+inline uint32_t ExtendPortable(uint32_t crc, uint8_t const* data, size_t size) {
+  while (size >= 8) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+#if __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    word ^= crc;
+    crc = kTables[7][word & 0xFF] ^
+          kTables[6][(word >> 8) & 0xFF] ^
+          kTables[5][(word >> 16) & 0xFF] ^
+          kTables[4][(word >> 24) & 0xFF] ^
+          kTables[3][(word >> 32) & 0xFF] ^
+          kTables[2][(word >> 40) & 0xFF] ^
+          kTables[1][(word >> 48) & 0xFF] ^
+          kTables[0][word >> 56];
+    data += 8;
+    size -= 8;
+  }
+
+  while (size-- > 0) {
+    crc = (crc >> 8) ^ kTables[0][(crc ^ *data++) & 0xFF];
+  }
+
+  return crc;
+}
+
+#if defined(MRD_CRC32C_X86)
+__attribute__((target("sse4.2"))) inline uint32_t ExtendSse42(uint32_t crc, uint8_t const* data,
+                                                             size_t size) {
+#if defined(__x86_64__)
+  uint64_t crc64 = crc;
+  while (size >= 8) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+    data += 8;
+    size -= 8;
+  }
+  crc = static_cast<uint32_t>(crc64);
+#endif
+
+  while (size >= 4) {
+    uint32_t word;
+    std::memcpy(&word, data, sizeof(word));
+    crc = _mm_crc32_u32(crc, word);
+    data += 4;
+    size -= 4;
+  }
+
+  while (size-- > 0) {
+    crc = _mm_crc32_u8(crc, *data++);
+  }
+
+  return crc;
+}
+
+inline bool HasSse42() {
+  static bool const supported = []() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2") != 0;
+  }();
+  return supported;
+}
+#elif defined(MRD_CRC32C_ARM)
+inline uint32_t ExtendArm(uint32_t crc, uint8_t const* data, size_t size) {
+  while (size >= 8) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    crc = __crc32cd(crc, word);
+    data += 8;
+    size -= 8;
+  }
+
+  while (size-- > 0) {
+    crc = __crc32cb(crc, *data++);
+  }
+
+  return crc;
+}
+#endif
+} // namespace crc32c_detail
+
+// Extends `crc`, the CRC-32C of some preceding data (0 for none), with
+// `size` more bytes.
+inline uint32_t Crc32cExtend(uint32_t crc, void const* data, size_t size) {
+  uint8_t const* bytes = static_cast<uint8_t const*>(data);
+  crc = ~crc;
+#if defined(MRD_CRC32C_X86)
+  if (crc32c_detail::HasSse42()) {
+    return ~crc32c_detail::ExtendSse42(crc, bytes, size);
+  }
+#elif defined(MRD_CRC32C_ARM)
+  return ~crc32c_detail::ExtendArm(crc, bytes, size);
+#endif
+  return ~crc32c_detail::ExtendPortable(crc, bytes, size);
+}
+
+inline uint32_t Crc32c(void const* data, size_t size) {
+  return Crc32cExtend(0, data, size);
+}
+
+} // namespace mrd::binary
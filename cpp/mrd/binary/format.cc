@@ -0,0 +1,658 @@
+#include "format.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+
+#include "crc32c.h"
+
+namespace mrd::binary {
+namespace {
+// The preamble of a binary stream is the magic bytes, the format version
+// (fixed uint32) and the schema (string). Version 2 adds the format options
+// (varint) before the schema.
+constexpr std::array<uint8_t, 5> kMagicBytes = {'y', 'a', 'r', 'd', 'l'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kFormatVersionWithOptions = 2;
+constexpr uint64_t kSampleEncodingMask = 0xFF;
+constexpr uint64_t kChecksumsBit = 1 << 8;
+
+// Each checksummed item is preceded by its length (fixed uint64), the CRC-32C
+// of the length field and the CRC-32C of the item (both fixed uint32).
+constexpr size_t kChecksummedItemPrefixBytes = 16;
+
+// Output of streams with format options is written in chunks of this size.
+constexpr size_t kOutputChunkBytes = 64 * 1024;
+
+uint64_t EncodeFormatOptions(FormatOptions const& options) {
+  uint64_t encoded = static_cast<uint64_t>(options.sample_encoding);
+  if (options.checksums) {
+    encoded |= kChecksumsBit;
+  }
+  return encoded;
+}
+
+FormatOptions DecodeFormatOptions(uint64_t encoded) {
+  FormatOptions options;
+  uint64_t sample_encoding = encoded & kSampleEncodingMask;
+  if (sample_encoding > static_cast<uint64_t>(SampleEncoding::kBFloat16)) {
+    throw std::runtime_error("Data in the stream uses an unsupported sample encoding.");
+  }
+  options.sample_encoding = static_cast<SampleEncoding>(sample_encoding);
+  options.checksums = (encoded & kChecksumsBit) != 0;
+
+  if ((encoded & ~(kSampleEncodingMask | kChecksumsBit)) != 0) {
+    throw std::runtime_error("Data in the stream uses unsupported format options.");
+  }
+  return options;
+}
+
+void AppendVarInt(std::vector<uint8_t>& bytes, uint64_t value) {
+  while (value > 0x7F) {
+    bytes.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<uint8_t>(value));
+}
+
+template <typename T>
+void AppendFixed(std::vector<uint8_t>& bytes, T value) {
+  static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Unsupported byte order");
+  uint8_t const* p = reinterpret_cast<uint8_t const*>(&value);
+  bytes.insert(bytes.end(), p, p + sizeof(value));
+}
+
+template <typename T>
+T ReadFixed(uint8_t const* data) {
+  T value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+// Reserves the prefix of a checksummed item at the end of `bytes` and returns
+// its offset. The item follows.
+size_t BeginChecksummedItem(std::vector<uint8_t>& bytes) {
+  size_t prefix_offset = bytes.size();
+  bytes.resize(prefix_offset + kChecksummedItemPrefixBytes);
+  return prefix_offset;
+}
+
+// Fills in the prefix of a checksummed item once the item has been appended.
+void EndChecksummedItem(std::vector<uint8_t>& bytes, size_t prefix_offset) {
+  size_t item_offset = prefix_offset + kChecksummedItemPrefixBytes;
+  uint64_t length = bytes.size() - item_offset;
+  uint32_t length_crc = Crc32c(&length, sizeof(length));
+  uint32_t item_crc = Crc32c(bytes.data() + item_offset, length);
+  uint8_t* prefix = bytes.data() + prefix_offset;
+  std::memcpy(prefix, &length, sizeof(length));
+  std::memcpy(prefix + 8, &length_crc, sizeof(length_crc));
+  std::memcpy(prefix + 12, &item_crc, sizeof(item_crc));
+}
+
+// Checks that decoding a checksummed item consumed exactly the bytes the
+// writer framed as the item.
+void EndChecksummedItem(size_t item_index, uint64_t length, size_t consumed) {
+  if (consumed != length) {
+    throw std::runtime_error("Stream item " + std::to_string(item_index) + " is framed with " + std::to_string(length) +
+                             " bytes but its encoding has " + std::to_string(consumed) + ".");
+  }
+}
+
+std::unique_ptr<std::ofstream> OpenFileForWriting(std::string const& file_name) {
+  auto file_stream = std::make_unique<std::ofstream>(file_name, std::ios::binary | std::ios::out);
+  if (!file_stream->good()) {
+    throw std::runtime_error("Failed to open file for writing.");
+  }
+  return file_stream;
+}
+
+std::unique_ptr<std::ifstream> OpenFileForReading(std::string const& file_name) {
+  auto file_stream = std::make_unique<std::ifstream>(file_name, std::ios::binary | std::ios::in);
+  if (!file_stream->good()) {
+    throw std::runtime_error("Failed to open file for reading.");
+  }
+  return file_stream;
+}
+} // namespace
+
+struct MrdFormatWriter::Encoder {
+  explicit Encoder(Version version) : item(version) {}
+
+  ItemEncoder item;
+  // The encoding of an item before its samples are narrowed
+  std::vector<uint8_t> scratch;
+};
+
+MrdFormatWriter::MrdFormatWriter(std::ostream& stream, FormatOptions const& options, Version version)
+    : version_(version), stream_(stream), options_(options) {
+  WritePreamble();
+}
+
+MrdFormatWriter::MrdFormatWriter(std::string file_name, FormatOptions const& options, Version version)
+    : version_(version), owned_file_(OpenFileForWriting(file_name)), stream_(*owned_file_), options_(options) {
+  WritePreamble();
+}
+
+MrdFormatWriter::~MrdFormatWriter() = default;
+
+void MrdFormatWriter::WritePreamble() {
+  if (options_.IsDefault()) {
+    plain_writer_ = std::make_unique<mrd::binary::MrdWriter>(stream_, version_);
+    return;
+  }
+
+  std::string const& schema = mrd::MrdWriterBase::SchemaFromVersion(version_);
+  if (options_.sample_encoding != SampleEncoding::kFloat32) {
+    // The schema of the items as the encoder produces them, with float32 samples
+    schema_ = EncodedSchema::Get(schema, false);
+    item_type_ = &schema_->StepType("data");
+  }
+  encoder_ = std::make_unique<Encoder>(version_);
+
+  output_.insert(output_.end(), kMagicBytes.begin(), kMagicBytes.end());
+  AppendFixed(output_, kFormatVersionWithOptions);
+  AppendVarInt(output_, EncodeFormatOptions(options_));
+  AppendVarInt(output_, schema.size());
+  output_.insert(output_.end(), schema.begin(), schema.end());
+}
+
+void MrdFormatWriter::EncodeItem(Encoder& encoder, mrd::StreamItem const& value, std::vector<uint8_t>& bytes,
+                                 SampleEncodingReport& report) const {
+  size_t prefix_offset = options_.checksums ? BeginChecksummedItem(bytes) : 0;
+
+  if (item_type_ != nullptr && item_type_->items[value.index()]->has_samples) {
+    // Narrow the samples of acquisition data while copying the item
+    std::vector<uint8_t>& scratch = encoder.scratch;
+    scratch.clear();
+    encoder.item.Encode(value, scratch);
+
+    MemoryInput input(scratch.data(), scratch.size());
+    size_t copied = 0;
+    WalkEncodedValue(*schema_, *item_type_, input, 0, [&](EncodedSamples const& samples) {
+      bytes.insert(bytes.end(), scratch.data() + copied, scratch.data() + samples.data);
+      if (samples.data != samples.end) {
+        EncodeReducedPrecisionRows(options_.sample_encoding, scratch.data() + samples.data, samples.rows,
+                                   samples.columns * 2, bytes, report);
+      }
+      copied = samples.end;
+    });
+    bytes.insert(bytes.end(), scratch.data() + copied, scratch.data() + scratch.size());
+
+    if (scratch.capacity() > 4 * kOutputChunkBytes) {
+      std::vector<uint8_t>().swap(scratch);
+    }
+  } else {
+    encoder.item.Encode(value, bytes);
+  }
+
+  if (options_.checksums) {
+    EndChecksummedItem(bytes, prefix_offset);
+  }
+}
+
+void MrdFormatWriter::WriteHeaderImpl(std::optional<mrd::Header> const& value) {
+  if (plain_writer_) {
+    plain_writer_->WriteHeader(value);
+    return;
+  }
+
+  encoder_->item.EncodeHeader(value, output_);
+  FlushOutput(false);
+}
+
+void MrdFormatWriter::WriteDataImpl(mrd::StreamItem const& value) {
+  if (plain_writer_) {
+    plain_writer_->WriteData(value);
+    return;
+  }
+
+  AppendVarInt(output_, 1);
+  EncodeItem(*encoder_, value, output_, report_);
+  FlushOutput(false);
+}
+
+void MrdFormatWriter::WriteDataImpl(std::vector<mrd::StreamItem> const& values) {
+  if (encoded_ != nullptr) {
+    if (plain_writer_) {
+      // Everything the generated writer buffered goes first
+      plain_writer_->Flush();
+    }
+    AppendVarInt(output_, encoded_->item_count_);
+    WriteOutput(encoded_->bytes_.data(), encoded_->bytes_.size());
+    FlushOutput(plain_writer_ != nullptr);
+    report_.Merge(encoded_->sample_encoding_report_);
+    return;
+  }
+
+  if (plain_writer_) {
+    plain_writer_->WriteData(values);
+    return;
+  }
+
+  if (!values.empty()) {
+    AppendVarInt(output_, values.size());
+    for (auto const& value : values) {
+      EncodeItem(*encoder_, value, output_, report_);
+      FlushOutput(false);
+    }
+  }
+}
+
+void MrdFormatWriter::EndDataImpl() {
+  if (plain_writer_) {
+    plain_writer_->EndData();
+    return;
+  }
+
+  AppendVarInt(output_, 0);
+}
+
+MrdEncodedData MrdFormatWriter::EncodeData(mrd::StreamItem const& value) const {
+  return EncodeItems(&value, 1);
+}
+
+MrdEncodedData MrdFormatWriter::EncodeData(std::vector<mrd::StreamItem> const& values) const {
+  return EncodeItems(values.data(), values.size());
+}
+
+MrdEncodedData MrdFormatWriter::EncodeItems(mrd::StreamItem const* values, size_t count) const {
+  MrdEncodedData data;
+  data.format_options_ = options_;
+  data.item_count_ = count;
+
+  auto encoder = AcquireEncoder();
+  for (size_t i = 0; i < count; i++) {
+    EncodeItem(*encoder, values[i], data.bytes_, data.sample_encoding_report_);
+  }
+  ReleaseEncoder(std::move(encoder));
+  return data;
+}
+
+std::unique_ptr<MrdFormatWriter::Encoder> MrdFormatWriter::AcquireEncoder() const {
+  {
+    std::lock_guard<std::mutex> lock(encoders_mutex_);
+    if (!encoders_.empty()) {
+      auto encoder = std::move(encoders_.back());
+      encoders_.pop_back();
+      return encoder;
+    }
+  }
+  return std::make_unique<Encoder>(version_);
+}
+
+void MrdFormatWriter::ReleaseEncoder(std::unique_ptr<Encoder> encoder) const {
+  std::lock_guard<std::mutex> lock(encoders_mutex_);
+  encoders_.push_back(std::move(encoder));
+}
+
+void MrdFormatWriter::WriteEncodedData(MrdEncodedData const& data) {
+  // Empty data, e.g. of a skipped ticket, is written the same way by any writer
+  if (data.item_count_ != 0 && data.format_options_ != options_) {
+    throw std::runtime_error("Encoded data was encoded with different format options than those of the writer.");
+  }
+
+  static std::vector<mrd::StreamItem> const no_values;
+  encoded_ = data.item_count_ != 0 ? &data : nullptr;
+  try {
+    MrdWriterBase::WriteData(no_values);
+  } catch (...) {
+    encoded_ = nullptr;
+    throw;
+  }
+  encoded_ = nullptr;
+}
+
+void MrdFormatWriter::WriteOutput(uint8_t const* data, size_t size) {
+  if (size < kOutputChunkBytes) {
+    output_.insert(output_.end(), data, data + size);
+    FlushOutput(false);
+    return;
+  }
+
+  // Large data is written without copying it
+  FlushOutput(true);
+  stream_.write(reinterpret_cast<char const*>(data), static_cast<std::streamsize>(size));
+  if (stream_.bad()) {
+    throw std::runtime_error("Failed to write to stream");
+  }
+}
+
+void MrdFormatWriter::FlushOutput(bool force) {
+  if (output_.empty() || (!force && output_.size() < kOutputChunkBytes)) {
+    return;
+  }
+
+  stream_.write(reinterpret_cast<char const*>(output_.data()), static_cast<std::streamsize>(output_.size()));
+  if (stream_.bad()) {
+    throw std::runtime_error("Failed to write to stream");
+  }
+  output_.clear();
+
+  // So that one large item does not hold on to its memory for the rest of the stream
+  if (output_.capacity() > 4 * kOutputChunkBytes) {
+    std::vector<uint8_t>().swap(output_);
+  }
+}
+
+void MrdFormatWriter::Flush() {
+  if (plain_writer_) {
+    plain_writer_->Flush();
+    return;
+  }
+
+  FlushOutput(true);
+  stream_.flush();
+}
+
+void MrdFormatWriter::CloseImpl() {
+  if (plain_writer_) {
+    plain_writer_->Close();
+    return;
+  }
+
+  FlushOutput(true);
+  stream_.flush();
+}
+
+// The bytes of the stream being read, buffered so that the encoding of an item
+// can be walked and checked before it is decoded. Offsets are relative to the
+// first byte not yet consumed.
+class MrdFormatReader::Input {
+  public:
+  explicit Input(std::istream& stream) : stream_(stream), buffer_(kReadBytes) {}
+
+  uint8_t const* Bytes(size_t offset, size_t count) {
+    size_t end = detail::CheckedSum(offset, count);
+    if (end > end_ - begin_) {
+      Fill(end);
+    }
+    return buffer_.data() + begin_ + offset;
+  }
+
+  void Consume(size_t count) {
+    begin_ += count;
+  }
+
+  // Whether all bytes of the stream have been consumed.
+  bool AtEnd() {
+    if (begin_ < end_) {
+      return false;
+    }
+    try {
+      Bytes(0, 1);
+      return false;
+    } catch (yardl::binary::EndOfStreamException const&) {
+      return true;
+    }
+  }
+
+  private:
+  static constexpr size_t kReadBytes = 64 * 1024;
+
+  void Fill(size_t size) {
+    size_t available = end_ - begin_;
+    size_t capacity = std::max(size, kReadBytes);
+    if (buffer_.size() < capacity || buffer_.size() > 4 * capacity) {
+      std::vector<uint8_t> resized(buffer_.size() < capacity ? std::max(capacity, 2 * buffer_.size()) : capacity);
+      std::memcpy(resized.data(), buffer_.data() + begin_, available);
+      buffer_.swap(resized);
+    } else if (begin_ > 0) {
+      std::memmove(buffer_.data(), buffer_.data() + begin_, available);
+    }
+    begin_ = 0;
+    end_ = available;
+
+    while (end_ < size) {
+      if (at_eof_) {
+        throw yardl::binary::EndOfStreamException();
+      }
+      size_t count = std::min(buffer_.size() - end_, std::max(size - end_, kReadBytes));
+      stream_.read(reinterpret_cast<char*>(buffer_.data() + end_), static_cast<std::streamsize>(count));
+      at_eof_ = stream_.eof();
+      end_ += static_cast<size_t>(stream_.gcount());
+    }
+  }
+
+  std::istream& stream_;
+  std::vector<uint8_t> buffer_;
+  size_t begin_ = 0;
+  size_t end_ = 0;
+  bool at_eof_ = false;
+};
+
+MrdFormatReader::MrdFormatReader(std::istream& stream, bool skip_completed_check)
+    : mrd::MrdVisitingReaderBase(skip_completed_check), input_(std::make_unique<Input>(stream)) {
+  ReadPreamble();
+}
+
+MrdFormatReader::MrdFormatReader(std::string file_name, bool skip_completed_check)
+    : mrd::MrdVisitingReaderBase(skip_completed_check), owned_file_(OpenFileForReading(file_name)),
+      input_(std::make_unique<Input>(*owned_file_)) {
+  ReadPreamble();
+}
+
+MrdFormatReader::~MrdFormatReader() = default;
+
+void MrdFormatReader::ReadPreamble() {
+  size_t offset = 0;
+  if (std::memcmp(input_->Bytes(offset, kMagicBytes.size()), kMagicBytes.data(), kMagicBytes.size()) != 0) {
+    throw std::runtime_error("Data in the stream is not in the expected format.");
+  }
+  offset += kMagicBytes.size();
+
+  uint32_t format_version = ReadFixed<uint32_t>(input_->Bytes(offset, sizeof(uint32_t)));
+  offset += sizeof(uint32_t);
+  if (format_version == kFormatVersionWithOptions) {
+    options_ = DecodeFormatOptions(detail::WalkVarInt(*input_, offset));
+  } else if (format_version != kFormatVersion) {
+    throw std::runtime_error("Data in the stream is not in the expected format. Unsupported version.");
+  }
+
+  size_t schema_size = detail::WalkVarInt(*input_, offset);
+  uint8_t const* schema_bytes = input_->Bytes(offset, schema_size);
+  std::string schema(reinterpret_cast<char const*>(schema_bytes), schema_size);
+  offset += schema_size;
+  input_->Consume(offset);
+
+  version_ = mrd::MrdReaderBase::VersionFromSchema(schema);
+  schema_ = EncodedSchema::Get(schema, options_.sample_encoding != SampleEncoding::kFloat32);
+  item_type_ = &schema_->StepType("data");
+  preamble_ = ItemDecoder::Preamble(schema);
+}
+
+void MrdFormatReader::ReadHeaderImpl(std::optional<mrd::Header>& value) {
+  size_t size = WalkEncodedValue(*schema_, schema_->StepType("header"), *input_, 0);
+  uint8_t const* bytes = input_->Bytes(0, size);
+  header_.assign(bytes, bytes + size);
+  input_->Consume(size);
+
+  // The data stream is not provided to this decoder, see NextItem()
+  ended_ = true;
+  ItemDecoder decoder(preamble_, static_cast<ItemDecoder::Source&>(*this), header_.data(), header_.size());
+  decoder.ReadHeader(value);
+  ended_ = false;
+}
+
+// Locates the encoding of the next item of the `data` stream, which starts at
+// `offset` once the item is verified, and returns its size.
+size_t MrdFormatReader::LocateItem(size_t& offset) {
+  samples_.clear();
+  auto on_samples = [this](EncodedSamples const& samples) { samples_.push_back(samples); };
+  if (!options_.checksums) {
+    offset = 0;
+    if (!schema_->ReducedSamples()) {
+      return WalkEncodedValue(*schema_, *item_type_, *input_, 0);
+    }
+    return WalkEncodedValue(*schema_, *item_type_, *input_, 0, on_samples);
+  }
+
+  size_t item_index = items_provided_;
+  uint8_t const* prefix = input_->Bytes(0, kChecksummedItemPrefixBytes);
+  uint64_t length = ReadFixed<uint64_t>(prefix);
+  uint32_t length_crc = ReadFixed<uint32_t>(prefix + 8);
+  uint32_t item_crc = ReadFixed<uint32_t>(prefix + 12);
+  if (verify_checksums_ && Crc32c(&length, sizeof(length)) != length_crc) {
+    throw ChecksumMismatchException(item_index);
+  }
+
+  offset = kChecksummedItemPrefixBytes;
+  uint8_t const* item = input_->Bytes(offset, length);
+  if (verify_checksums_ && Crc32c(item, length) != item_crc) {
+    throw ChecksumMismatchException(item_index);
+  }
+
+  // The item is decoded from its framed bytes only, so an item whose length
+  // disagrees with its encoding is reported here rather than misread.
+  MemoryInput memory(item, length);
+  size_t consumed = schema_->ReducedSamples() ? WalkEncodedValue(*schema_, *item_type_, memory, 0, on_samples)
+                                              : WalkEncodedValue(*schema_, *item_type_, memory, 0);
+  EndChecksummedItem(item_index, length, consumed);
+  return length;
+}
+
+// Widens reduced-precision samples of acquisition data into expanded_.
+void MrdFormatReader::ExpandSamples(uint8_t const* data, size_t size) {
+  expanded_.clear();
+  size_t copied = 0;
+  for (auto const& samples : samples_) {
+    expanded_.insert(expanded_.end(), data + copied, data + samples.data);
+    if (samples.data != samples.end) {
+      DecodeReducedPrecisionRows(options_.sample_encoding, data + samples.data, samples.rows, samples.columns * 2,
+                                 expanded_);
+    }
+    copied = samples.end;
+  }
+  expanded_.insert(expanded_.end(), data + copied, data + size);
+}
+
+// Provides the decoder with the encodings of the items, in the encoding of the
+// generated serializers. Errors are raised once the decoder has returned the
+// items before the failing one.
+bool MrdFormatReader::NextItem(uint8_t const*& data, size_t& size) {
+  if (ended_ || error_ || rejected_bytes_ != 0) {
+    return false;
+  }
+
+  try {
+    // The decoder has consumed the previous item
+    input_->Consume(provided_bytes_);
+    provided_bytes_ = 0;
+
+    if (block_remaining_ == 0) {
+      size_t offset = 0;
+      block_remaining_ = detail::WalkVarInt(*input_, offset);
+      input_->Consume(offset);
+      if (block_remaining_ == 0) {
+        ended_ = true;
+        return false;
+      }
+    }
+
+    size_t offset;
+    size_t length = LocateItem(offset);
+    if (filter_ != nullptr) {
+      size_t index_offset = offset;
+      size_t index = detail::WalkVarInt(*input_, index_offset);
+      if (!filter_->Handles(index)) {
+        rejected_bytes_ = offset + length;
+        rejected_index_ = index;
+        return false;
+      }
+    }
+
+    data = input_->Bytes(offset, length);
+    size = length;
+    if (!samples_.empty()) {
+      ExpandSamples(data, size);
+      data = expanded_.data();
+      size = expanded_.size();
+    }
+
+    provided_bytes_ = offset + length;
+    block_remaining_--;
+    items_provided_++;
+    return true;
+  } catch (...) {
+    error_ = std::current_exception();
+    return false;
+  }
+}
+
+// Skips the item that ended the last decoder if the current visitor does not
+// handle it either. Otherwise the item is located again for the next decoder.
+// Returns whether an item was skipped.
+bool MrdFormatReader::SkipRejectedItem() {
+  if (rejected_bytes_ == 0) {
+    return false;
+  }
+
+  bool skip = filter_ != nullptr && !filter_->Handles(rejected_index_);
+  if (skip) {
+    input_->Consume(rejected_bytes_);
+    block_remaining_--;
+    items_provided_++;
+  }
+  rejected_bytes_ = 0;
+  return skip;
+}
+
+bool MrdFormatReader::ReadItemImpl(mrd::StreamItem& value) {
+  while (true) {
+    if (!decoder_) {
+      if (SkipRejectedItem()) {
+        continue;
+      }
+      if (ended_ || error_) {
+        break;
+      }
+      decoder_ = std::make_unique<ItemDecoder>(preamble_, static_cast<ItemDecoder::Source&>(*this));
+    }
+
+    if (decoder_->Read(value)) {
+      return true;
+    }
+    decoder_.reset();
+  }
+
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+  return false;
+}
+
+bool MrdFormatReader::ReadItemImpl(mrd::MrdDataVisitor& visitor) {
+  filter_ = &visitor;
+  bool read;
+  try {
+    read = ReadItemImpl(item_);
+  } catch (...) {
+    filter_ = nullptr;
+    throw;
+  }
+  filter_ = nullptr;
+  if (!read) {
+    return false;
+  }
+
+  // Items decoded ahead of this call may not be handled by the visitor
+  if (visitor.Handles(item_.index())) {
+    std::visit([&visitor](auto& v) { visitor.Visit(std::move(v)); }, item_);
+  }
+  return true;
+}
+
+void MrdFormatReader::CloseImpl() {
+  decoder_.reset();
+  if (!skip_completed_check_) {
+    input_->Consume(provided_bytes_);
+    provided_bytes_ = 0;
+    if (!input_->AtEnd()) {
+      throw std::runtime_error("Stream was not completely read");
+    }
+  }
+}
+
+} // namespace mrd::binary
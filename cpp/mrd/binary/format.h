@@ -0,0 +1,217 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../data_visitor.h"
+#include "codec.h"
+#include "protocols.h"
+#include "reduced_precision.h"
+#include "schema.h"
+
+namespace mrd::binary {
+// Optional features of a binary stream written by MrdFormatWriter. They are
+// recorded in the stream's preamble, so readers pick them up without being told.
+struct FormatOptions {
+  // The encoding of the samples of acquisition data (mrd::Acquisition::data).
+  // Other arrays always keep their full precision.
+  SampleEncoding sample_encoding = SampleEncoding::kFloat32;
+
+  // Whether each item of the `data` stream is framed with its length and a
+  // CRC-32C checksum, allowing readers to detect corruption before decoding it.
+  bool checksums = false;
+
+  bool IsDefault() const {
+    return sample_encoding == SampleEncoding::kFloat32 && !checksums;
+  }
+
+  bool operator==(FormatOptions const& other) const {
+    return sample_encoding == other.sample_encoding && checksums == other.checksums;
+  }
+
+  bool operator!=(FormatOptions const& other) const {
+    return !(*this == other);
+  }
+};
+
+// Thrown when a checksummed item of the `data` stream is corrupt.
+class ChecksumMismatchException : public std::exception {
+  public:
+  explicit ChecksumMismatchException(size_t item_index)
+      : item_index_(item_index), message_("Checksum mismatch in stream item " + std::to_string(item_index)) {}
+
+  char const* what() const noexcept override { return message_.c_str(); }
+
+  // The zero-based index of the corrupt item in the `data` stream.
+  size_t ItemIndex() const { return item_index_; }
+
+  private:
+  size_t item_index_;
+  std::string message_;
+};
+
+// Items of the `data` stream of the Mrd protocol, encoded by MrdFormatWriter::EncodeData()
+// and not yet written.
+class MrdEncodedData {
+  public:
+  size_t ItemCount() const { return item_count_; }
+  size_t ByteSize() const { return bytes_.size(); }
+
+  private:
+  std::vector<uint8_t> bytes_;
+  size_t item_count_ = 0;
+  FormatOptions format_options_{};
+  SampleEncodingReport sample_encoding_report_{};
+
+  friend class MrdFormatWriter;
+};
+
+// Binary writer for the Mrd protocol that writes the stream with the given
+// format options, such as a reduced-precision sample encoding for acquisition
+// data or per-item checksums. Streams written with default options are those
+// of the generated MrdWriter, which this writer uses to encode the items.
+//
+// A stream with other options starts with format version 2 followed by the
+// options, so that readers which predate them reject the stream rather than
+// misinterpret it. MrdFormatReader reads both.
+class MrdFormatWriter : public mrd::MrdWriterBase {
+  public:
+  MrdFormatWriter(std::ostream& stream, FormatOptions const& options = {}, Version version = Version::Current);
+  MrdFormatWriter(std::string file_name, FormatOptions const& options = {}, Version version = Version::Current);
+  ~MrdFormatWriter() override;
+
+  void Flush() override;
+
+  FormatOptions const& GetFormatOptions() const { return options_; }
+
+  // The error introduced so far by a lossy sample encoding.
+  SampleEncodingReport const& GetSampleEncodingReport() const { return report_; }
+
+  // Encodes items of the `data` stream with this writer's format options, without
+  // writing them. Does not modify the writer, so several threads can encode
+  // concurrently, also while another thread writes.
+  MrdEncodedData EncodeData(mrd::StreamItem const& value) const;
+  MrdEncodedData EncodeData(std::vector<mrd::StreamItem> const& values) const;
+
+  // Writes items encoded by EncodeData() as one block of the `data` stream.
+  void WriteEncodedData(MrdEncodedData const& data);
+
+  protected:
+  void WriteHeaderImpl(std::optional<mrd::Header> const& value) override;
+  void WriteDataImpl(mrd::StreamItem const& value) override;
+  void WriteDataImpl(std::vector<mrd::StreamItem> const& values) override;
+  void EndDataImpl() override;
+  void CloseImpl() override;
+
+  Version version_;
+
+  private:
+  struct Encoder;
+
+  void WritePreamble();
+  void EncodeItem(Encoder& encoder, mrd::StreamItem const& value, std::vector<uint8_t>& bytes,
+                  SampleEncodingReport& report) const;
+  MrdEncodedData EncodeItems(mrd::StreamItem const* values, size_t count) const;
+  std::unique_ptr<Encoder> AcquireEncoder() const;
+  void ReleaseEncoder(std::unique_ptr<Encoder> encoder) const;
+  void WriteOutput(uint8_t const* data, size_t size);
+  void FlushOutput(bool force);
+
+  std::unique_ptr<std::ofstream> owned_file_;
+  std::ostream& stream_;
+  FormatOptions options_;
+  SampleEncodingReport report_;
+
+  // Writes streams with default options
+  std::unique_ptr<mrd::binary::MrdWriter> plain_writer_;
+
+  // Streams with other options are encoded here before they are written
+  std::shared_ptr<EncodedSchema const> schema_;
+  EncodedType const* item_type_ = nullptr;
+  std::unique_ptr<Encoder> encoder_;
+  std::vector<uint8_t> output_;
+
+  mutable std::mutex encoders_mutex_;
+  mutable std::vector<std::unique_ptr<Encoder>> encoders_;
+
+  // The data of the WriteEncodedData() call in progress, which reaches
+  // WriteDataImpl() through the state checks of MrdWriterBase::WriteData().
+  MrdEncodedData const* encoded_ = nullptr;
+};
+
+// Binary reader for the Mrd protocol that reads streams written by
+// MrdFormatWriter with any format options, as well as streams written by the
+// generated MrdWriter. It can also decode items of the `data` stream straight
+// into an MrdDataVisitor (see mrd::ReadData()). Items the visitor does not
+// handle are skipped.
+class MrdFormatReader : public mrd::MrdVisitingReaderBase, ItemDecoder::Source {
+  public:
+  MrdFormatReader(std::istream& stream, bool skip_completed_check=false);
+  MrdFormatReader(std::string file_name, bool skip_completed_check=false);
+  ~MrdFormatReader() override;
+
+  Version GetVersion() { return version_; }
+
+  FormatOptions const& GetFormatOptions() const { return options_; }
+
+  // Whether the checksums of a stream written with FormatOptions::checksums
+  // are verified (the default). A corrupt item raises a
+  // ChecksumMismatchException naming the item's index.
+  bool GetVerifyChecksums() const { return verify_checksums_; }
+  void SetVerifyChecksums(bool verify) { verify_checksums_ = verify; }
+
+  protected:
+  void ReadHeaderImpl(std::optional<mrd::Header>& value) override;
+  bool ReadItemImpl(mrd::StreamItem& value) override;
+  bool ReadItemImpl(mrd::MrdDataVisitor& visitor) override;
+  void CloseImpl() override;
+
+  Version version_;
+
+  private:
+  class Input;
+
+  void ReadPreamble();
+  bool NextItem(uint8_t const*& data, size_t& size) override;
+  size_t LocateItem(size_t& offset);
+  void ExpandSamples(uint8_t const* data, size_t size);
+  bool SkipRejectedItem();
+
+  std::unique_ptr<std::ifstream> owned_file_;
+  std::unique_ptr<Input> input_;
+  FormatOptions options_;
+  bool verify_checksums_ = true;
+  std::shared_ptr<EncodedSchema const> schema_;
+  EncodedType const* item_type_ = nullptr;
+  std::vector<uint8_t> preamble_;
+  std::vector<uint8_t> header_;
+  std::unique_ptr<ItemDecoder> decoder_;
+
+  // The state of the `data` stream as provided to the decoder
+  size_t block_remaining_ = 0;
+  size_t items_provided_ = 0;
+  size_t provided_bytes_ = 0;
+  bool ended_ = false;
+  std::exception_ptr error_;
+
+  // The visitor of the ReadData() call in progress. Items it does not handle
+  // end the decoder before they reach it, and are skipped without decoding.
+  mrd::MrdDataVisitor const* filter_ = nullptr;
+  size_t rejected_bytes_ = 0;
+  size_t rejected_index_ = 0;
+
+  std::vector<EncodedSamples> samples_;
+  std::vector<uint8_t> expanded_;
+
+  mrd::StreamItem item_;
+};
+
+} // namespace mrd::binary
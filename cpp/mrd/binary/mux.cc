@@ -0,0 +1,326 @@
+#include "mux.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "../concurrency/bounded_queue.h"
+
+namespace mrd::binary {
+
+namespace {
+// The multiplexed stream starts with these bytes and a varint format version,
+// followed by frames. Each frame starts with its kind and a varint session ID.
+// A data frame continues with a varint length and that many bytes of the
+// session's binary stream, at most kMaxFrameBytes, so that a corrupt length
+// cannot make the demultiplexer allocate an arbitrary amount of memory.
+constexpr std::array<char, 6> kMuxMagicBytes = {'M', 'R', 'D', 'M', 'U', 'X'};
+constexpr uint32_t kMuxFormatVersion = 1;
+constexpr size_t kMaxFrameBytes = 1024 * 1024;
+
+enum class FrameKind : uint8_t {
+  kEndOfStream = 0,
+  kData = 1,
+  kEndSession = 2,
+};
+} // namespace
+
+// Forwards everything written to a session's stream to the multiplexer as
+// data frames, without buffering of its own: the session's MrdFormatWriter already
+// writes in large chunks.
+class MrdMuxWriter::SessionOutputBuffer : public std::streambuf {
+  public:
+  SessionOutputBuffer(MrdMuxWriter& mux, uint64_t session_id) : mux_(mux), session_id_(session_id) {}
+
+  protected:
+  std::streamsize xsputn(char const* s, std::streamsize count) override {
+    if (count > 0) {
+      mux_.WriteFrame(session_id_, s, static_cast<size_t>(count));
+    }
+    return count;
+  }
+
+  int_type overflow(int_type ch) override {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+      return traits_type::not_eof(ch);
+    }
+    char c = traits_type::to_char_type(ch);
+    mux_.WriteFrame(session_id_, &c, 1);
+    return ch;
+  }
+
+  int sync() override {
+    mux_.Flush();
+    return 0;
+  }
+
+  private:
+  MrdMuxWriter& mux_;
+  uint64_t session_id_;
+};
+
+// Holds a session's output stream. As a base class of SessionWriter listed
+// before MrdFormatWriter, it is destroyed after the MrdFormatWriter has flushed its
+// remaining output, and only then ends the session.
+class MrdMuxWriter::SessionOutput {
+  public:
+  SessionOutput(MrdMuxWriter& mux, uint64_t session_id)
+      : mux_(mux), session_id_(session_id), buffer_(mux, session_id), stream_(&buffer_) {}
+
+  ~SessionOutput() {
+    mux_.EndSession(session_id_);
+  }
+
+  protected:
+  MrdMuxWriter& mux_;
+  uint64_t session_id_;
+  SessionOutputBuffer buffer_;
+  std::ostream stream_;
+};
+
+class MrdMuxWriter::SessionWriter : private SessionOutput, public MrdFormatWriter {
+  public:
+  SessionWriter(MrdMuxWriter& mux, uint64_t session_id, FormatOptions const& options)
+      : SessionOutput(mux, session_id), MrdFormatWriter(SessionOutput::stream_, options) {}
+};
+
+MrdMuxWriter::MrdMuxWriter(std::ostream& stream) : stream_(stream) {
+  stream_.WriteBytes(kMuxMagicBytes.data(), kMuxMagicBytes.size());
+  stream_.WriteVarInt32(kMuxFormatVersion);
+}
+
+std::unique_ptr<MrdFormatWriter> MrdMuxWriter::OpenSession(uint64_t session_id,
+                                                     FormatOptions const& options) {
+  BeginSession(session_id);
+  return std::make_unique<SessionWriter>(*this, session_id, options);
+}
+
+void MrdMuxWriter::Flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stream_.Flush();
+}
+
+void MrdMuxWriter::Close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closed_) {
+    return;
+  }
+  if (!open_sessions_.empty()) {
+    throw std::runtime_error("MrdMuxWriter::Close() called while session " +
+                             std::to_string(*open_sessions_.begin()) + " is still open.");
+  }
+
+  stream_.WriteByte(static_cast<uint8_t>(FrameKind::kEndOfStream));
+  stream_.Flush();
+  closed_ = true;
+}
+
+void MrdMuxWriter::BeginSession(uint64_t session_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (closed_) {
+    throw std::runtime_error("Cannot open a session on a closed MrdMuxWriter.");
+  }
+  if (!open_sessions_.insert(session_id).second) {
+    throw std::runtime_error("Session " + std::to_string(session_id) + " is already open.");
+  }
+}
+
+void MrdMuxWriter::WriteFrame(uint64_t session_id, char const* data, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Large payloads bypass the session writer's buffer, so split them up
+  while (size > 0) {
+    size_t frame_size = std::min(size, kMaxFrameBytes);
+    stream_.WriteByte(static_cast<uint8_t>(FrameKind::kData));
+    stream_.WriteVarInt64(session_id);
+    stream_.WriteVarInt64(static_cast<uint64_t>(frame_size));
+    stream_.WriteBytes(data, frame_size);
+    data += frame_size;
+    size -= frame_size;
+  }
+}
+
+void MrdMuxWriter::EndSession(uint64_t session_id) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (open_sessions_.erase(session_id) == 0) {
+    return;
+  }
+  stream_.WriteByte(static_cast<uint8_t>(FrameKind::kEndSession));
+  stream_.WriteVarInt64(session_id);
+}
+
+// A session's input stream, fed with the chunks of its data frames by the
+// demultiplexer and read by the session's MrdFormatReader.
+class MrdDemuxer::SessionInputBuffer : public std::streambuf {
+  public:
+  explicit SessionInputBuffer(size_t max_bytes) : chunks_(std::numeric_limits<size_t>::max(), max_bytes) {}
+
+  void Push(std::vector<char>&& chunk) {
+    size_t size = chunk.size();
+    chunks_.Push(std::move(chunk), size);
+  }
+
+  // Marks the end of the session's stream.
+  void Close() {
+    chunks_.Close();
+  }
+
+  // Called when the handler has returned: discards the remaining input.
+  void Detach() {
+    chunks_.Cancel();
+  }
+
+  protected:
+  int_type underflow() override {
+    if (gptr() < egptr()) {
+      return traits_type::to_int_type(*gptr());
+    }
+
+    if (!chunks_.Pop(current_)) {
+      return traits_type::eof();
+    }
+
+    setg(current_.data(), current_.data(), current_.data() + current_.size());
+    return traits_type::to_int_type(*gptr());
+  }
+
+  private:
+  concurrency::BoundedQueue<std::vector<char>> chunks_;
+  std::vector<char> current_;
+};
+
+struct MrdDemuxer::Session {
+  Session(uint64_t id, size_t max_bytes) : id(id), buffer(max_bytes), stream(&buffer) {}
+
+  uint64_t id;
+  SessionInputBuffer buffer;
+  std::istream stream;
+  std::thread thread;
+};
+
+MrdDemuxer::MrdDemuxer(std::istream& stream, SessionHandler handler, DemuxOptions options)
+    : stream_(stream), handler_(std::move(handler)), options_(options) {
+  if (!handler_) {
+    throw std::invalid_argument("MrdDemuxer session handler must not be empty.");
+  }
+}
+
+MrdDemuxer::~MrdDemuxer() {
+  Stop();
+}
+
+void MrdDemuxer::Run() {
+  std::map<uint64_t, Session*> active;
+  try {
+    std::array<char, kMuxMagicBytes.size()> magic;
+    stream_.ReadBytes(magic.data(), magic.size());
+    if (magic != kMuxMagicBytes) {
+      throw std::runtime_error("Data in the stream is not in the expected MRD multiplexed format.");
+    }
+    uint32_t version;
+    stream_.ReadVarInt32(version);
+    if (version != kMuxFormatVersion) {
+      throw std::runtime_error("Unsupported MRD multiplexed format version " + std::to_string(version) + ".");
+    }
+
+    while (true) {
+      uint8_t kind;
+      stream_.ReadByte(kind);
+      if (kind == static_cast<uint8_t>(FrameKind::kEndOfStream)) {
+        break;
+      }
+
+      uint64_t session_id;
+      stream_.ReadVarInt64(session_id);
+      if (kind == static_cast<uint8_t>(FrameKind::kData)) {
+        uint64_t size;
+        stream_.ReadVarInt64(size);
+        if (size > kMaxFrameBytes) {
+          throw std::runtime_error("Data frame of " + std::to_string(size) + " bytes in MRD multiplexed stream exceeds the maximum of " +
+                                   std::to_string(kMaxFrameBytes) + " bytes.");
+        }
+        std::vector<char> chunk(size);
+        stream_.ReadBytes(chunk.data(), chunk.size());
+
+        auto it = active.find(session_id);
+        if (it == active.end()) {
+          auto session = std::make_unique<Session>(session_id, options_.max_session_buffer_bytes);
+          Session* s = session.get();
+          {
+            std::lock_guard<std::mutex> lock(mutex_);
+            sessions_.push_back(std::move(session));
+          }
+          s->thread = std::thread([this, s]() { HandleSession(*s); });
+          it = active.emplace(session_id, s).first;
+        }
+        it->second->buffer.Push(std::move(chunk));
+      } else if (kind == static_cast<uint8_t>(FrameKind::kEndSession)) {
+        auto it = active.find(session_id);
+        if (it != active.end()) {
+          it->second->buffer.Close();
+          active.erase(it);
+        }
+      } else {
+        throw std::runtime_error("Unknown frame kind " + std::to_string(kind) + " in MRD multiplexed stream.");
+      }
+    }
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!error_) {
+      error_ = std::current_exception();
+    }
+  }
+
+  // Sessions that have not ended see the end of their stream, and their
+  // readers fail unless they have read everything they need.
+  for (auto& [id, session] : active) {
+    session->buffer.Close();
+  }
+
+  Stop();
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+size_t MrdDemuxer::SessionCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sessions_.size();
+}
+
+void MrdDemuxer::HandleSession(Session& session) {
+  try {
+    MrdFormatReader reader(session.stream);
+    handler_(session.id, reader);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!error_) {
+      error_ = std::current_exception();
+    }
+  }
+  session.buffer.Detach();
+}
+
+void MrdDemuxer::Stop() {
+  std::vector<Session*> sessions;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& session : sessions_) {
+      sessions.push_back(session.get());
+    }
+  }
+
+  for (Session* session : sessions) {
+    session->buffer.Close();
+    if (session->thread.joinable()) {
+      session->thread.join();
+    }
+  }
+}
+
+} // namespace mrd::binary
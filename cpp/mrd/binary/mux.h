@@ -0,0 +1,120 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <vector>
+
+#include "format.h"
+
+namespace mrd::binary {
+// Writes several Mrd binary streams ("sessions"), each with its own header and
+// `data` stream, interleaved over a single stream such as a socket connection.
+// Each session is identified by a session ID, for instance the measurement UID.
+//
+// The multiplexed stream consists of frames carrying chunks of each session's
+// binary stream. Session writers may be used from different threads; writing
+// a frame is serialized with a mutex, and each session writer buffers its
+// output so that frames are typically 64 KiB.
+//
+// Sessions must be closed or destroyed before the MrdMuxWriter, and Close()
+// must be called to mark the end of the multiplexed stream. For example:
+//   mrd::binary::MrdMuxWriter mux(socket_stream);
+//   auto session = mux.OpenSession(measurement_uid);
+//   session->WriteHeader(header);
+//   ...
+//   session->EndData();
+//   session->Close();
+//   mux.Close();
+class MrdMuxWriter {
+  public:
+  explicit MrdMuxWriter(std::ostream& stream);
+
+  MrdMuxWriter(MrdMuxWriter const&) = delete;
+  MrdMuxWriter& operator=(MrdMuxWriter const&) = delete;
+
+  // Starts a session. The session ends when the returned writer is destroyed.
+  // Session IDs can be reused once the previous session with the ID has ended.
+  std::unique_ptr<MrdFormatWriter> OpenSession(uint64_t session_id,
+                                         FormatOptions const& options = {});
+
+  // Flushes all frames written so far to the underlying stream.
+  void Flush();
+
+  // Marks the end of the multiplexed stream. All sessions must have ended.
+  void Close();
+
+  private:
+  class SessionOutputBuffer;
+  class SessionOutput;
+  class SessionWriter;
+
+  void BeginSession(uint64_t session_id);
+  void WriteFrame(uint64_t session_id, char const* data, size_t size);
+  void EndSession(uint64_t session_id);
+
+  std::mutex mutex_;
+  yardl::binary::CodedOutputStream stream_;
+  std::set<uint64_t> open_sessions_;
+  bool closed_ = false;
+};
+
+struct DemuxOptions {
+  // Maximum number of bytes buffered for a session whose handler has not yet
+  // consumed them, or 0 for no limit. When a session reaches the limit, the
+  // demultiplexer stops reading until the handler catches up. As the sessions
+  // share one stream, this also holds up all other sessions (head-of-line
+  // blocking), so the limit trades the memory a slow session can take for
+  // the throughput of the others. Without a limit, a session whose handler
+  // falls behind buffers the rest of its stream in memory.
+  size_t max_session_buffer_bytes = 64 * 1024 * 1024;
+};
+
+// Reads a stream written by MrdMuxWriter and hands each session to a handler
+// running on a thread of its own, so that sessions are processed in parallel.
+// A slow session holds up the others only once its input buffer is full (see
+// DemuxOptions). For example:
+//   mrd::binary::MrdDemuxer demux(socket_stream, [](uint64_t session_id, mrd::binary::MrdFormatReader& reader) {
+//     // Read the session as usual
+//   });
+//   demux.Run();
+class MrdDemuxer {
+  public:
+  using SessionHandler = std::function<void(uint64_t session_id, MrdFormatReader& reader)>;
+
+  MrdDemuxer(std::istream& stream, SessionHandler handler, DemuxOptions options = {});
+  ~MrdDemuxer();
+
+  MrdDemuxer(MrdDemuxer const&) = delete;
+  MrdDemuxer& operator=(MrdDemuxer const&) = delete;
+
+  // Reads the multiplexed stream to its end, then waits for all session
+  // handlers to return. Rethrows the first exception thrown by a handler or
+  // raised while reading the stream.
+  void Run();
+
+  // Number of sessions started so far.
+  size_t SessionCount() const;
+
+  private:
+  class SessionInputBuffer;
+  struct Session;
+
+  void HandleSession(Session& session);
+  void Stop();
+
+  yardl::binary::CodedInputStream stream_;
+  SessionHandler handler_;
+  DemuxOptions options_;
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Session>> sessions_;
+  std::exception_ptr error_;
+};
+
+} // namespace mrd::binary
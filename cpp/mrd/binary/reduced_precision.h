@@ -0,0 +1,374 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MRD_BINARY_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+// Lossy transport of the samples of acquisition data (mrd::Acquisition::data)
+// as IEEE 754 half precision (float16) or bfloat16 values. Each row of the
+// array (one coil) is multiplied by a power-of-two scale before narrowing, so
+// scaling itself is exact and only the narrowing rounds. With
+// round-to-nearest-even, the error of every component is bounded by 2^-11
+// (float16) or 2^-8 (bfloat16) times its magnitude, down to 2^-24 of the row
+// peak, below which float16 values become subnormal.
+//
+// In a stream written with a reduced-precision SampleEncoding, the array is
+// encoded as its shape, as usual, followed for each row by a float32 scale and
+// the row's real and imaginary parts as 16-bit values. MrdFormatWriter and
+// MrdFormatReader convert between this and the regular encoding (see format.h).
+namespace mrd::binary {
+
+// The on-the-wire representation of the samples of acquisition data.
+enum class SampleEncoding : uint8_t {
+  kFloat32 = 0,
+  kFloat16 = 1,
+  kBFloat16 = 2,
+};
+
+// The error introduced by a lossy SampleEncoding, measured against the
+// original float32 samples as they are written.
+struct SampleEncodingReport {
+  // Number of float components (real and imaginary parts) encoded.
+  uint64_t value_count = 0;
+  // Largest absolute error of a single component.
+  double max_abs_error = 0;
+  // Largest error of a single component relative to the peak magnitude of
+  // the row it belongs to.
+  double max_rel_error = 0;
+  // Sums of squared errors and squared original values.
+  double error_energy = 0;
+  double signal_energy = 0;
+
+  double RelativeRmsError() const {
+    return signal_energy > 0 ? std::sqrt(error_energy / signal_energy) : 0;
+  }
+
+  double SignalToErrorRatioDb() const {
+    if (error_energy == 0) {
+      return std::numeric_limits<double>::infinity();
+    }
+    return 10 * std::log10(signal_energy / error_energy);
+  }
+
+  // Accumulates the errors of another report, e.g. from data encoded separately.
+  void Merge(SampleEncodingReport const& other) {
+    value_count += other.value_count;
+    max_abs_error = std::max(max_abs_error, other.max_abs_error);
+    max_rel_error = std::max(max_rel_error, other.max_rel_error);
+    error_energy += other.error_energy;
+    signal_energy += other.signal_energy;
+  }
+};
+
+inline uint16_t FloatToHalf(float value) {
+  uint32_t f;
+  std::memcpy(&f, &value, sizeof(f));
+  uint32_t sign = f & 0x80000000u;
+  f ^= sign;
+
+  uint16_t h;
+  if (f >= (127u + 16u) << 23) {
+    // Overflow, infinity or NaN
+    h = f > 0x7F800000u ? 0x7E00 : 0x7C00;
+  } else if (f < (127u - 14u) << 23) {
+    // Subnormal or zero: let the FPU do the rounding
+    uint32_t const magic_bits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+    float magic;
+    std::memcpy(&magic, &magic_bits, sizeof(magic));
+    float shifted;
+    std::memcpy(&shifted, &f, sizeof(shifted));
+    shifted += magic;
+    uint32_t shifted_bits;
+    std::memcpy(&shifted_bits, &shifted, sizeof(shifted_bits));
+    h = static_cast<uint16_t>(shifted_bits - magic_bits);
+  } else {
+    uint32_t mantissa_odd = (f >> 13) & 1;
+    f += ((15u - 127u) << 23) + 0xFFF + mantissa_odd;
+    h = static_cast<uint16_t>(f >> 13);
+  }
+
+  return static_cast<uint16_t>(h | (sign >> 16));
+}
+
+inline float HalfToFloat(uint16_t value) {
+  uint32_t const shifted_exponent = 0x7C00u << 13;
+  uint32_t f = (value & 0x7FFFu) << 13;
+  uint32_t exponent = f & shifted_exponent;
+  f += (127u - 15u) << 23;
+
+  if (exponent == shifted_exponent) {
+    // Infinity or NaN
+    f += (128u - 16u) << 23;
+  } else if (exponent == 0) {
+    // Subnormal or zero: renormalize
+    uint32_t const magic_bits = 113u << 23;
+    float magic;
+    std::memcpy(&magic, &magic_bits, sizeof(magic));
+    f += 1u << 23;
+    float renormalized;
+    std::memcpy(&renormalized, &f, sizeof(renormalized));
+    renormalized -= magic;
+    std::memcpy(&f, &renormalized, sizeof(f));
+  }
+
+  f |= static_cast<uint32_t>(value & 0x8000u) << 16;
+  float result;
+  std::memcpy(&result, &f, sizeof(result));
+  return result;
+}
+
+inline uint16_t FloatToBFloat16(float value) {
+  uint32_t f;
+  std::memcpy(&f, &value, sizeof(f));
+  if ((f & 0x7FFFFFFFu) > 0x7F800000u) {
+    // Keep NaNs quiet rather than letting rounding turn them into infinity
+    return static_cast<uint16_t>((f >> 16) | 0x0040u);
+  }
+
+  f += 0x7FFFu + ((f >> 16) & 1);
+  return static_cast<uint16_t>(f >> 16);
+}
+
+inline float BFloat16ToFloat(uint16_t value) {
+  uint32_t f = static_cast<uint32_t>(value) << 16;
+  float result;
+  std::memcpy(&result, &f, sizeof(result));
+  return result;
+}
+
+#ifdef MRD_BINARY_X86_SIMD
+__attribute__((target("avx,f16c"))) inline void EncodeHalfF16c(float const* src, size_t count,
+                                                               float scale, uint16_t* dst) {
+  __m256 s = _mm256_set1_ps(scale);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 v = _mm256_mul_ps(_mm256_loadu_ps(src + i), s);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+  }
+  for (; i < count; i++) {
+    dst[i] = FloatToHalf(src[i] * scale);
+  }
+}
+
+__attribute__((target("avx,f16c"))) inline void DecodeHalfF16c(uint16_t const* src, size_t count,
+                                                               float inverse_scale, float* dst) {
+  __m256 s = _mm256_set1_ps(inverse_scale);
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 v = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i)));
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(v, s));
+  }
+  for (; i < count; i++) {
+    dst[i] = HalfToFloat(src[i]) * inverse_scale;
+  }
+}
+
+// The unmasked AVX-512 conversions trip -Wmaybe-uninitialized in some GCC
+// versions, so these use the zero-masked forms with a full mask.
+__attribute__((target("avx512f"))) inline void EncodeHalfAvx512(float const* src, size_t count,
+                                                                float scale, uint16_t* dst) {
+  __m512 s = _mm512_set1_ps(scale);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m512 v = _mm512_mul_ps(_mm512_loadu_ps(src + i), s);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm512_maskz_cvtps_ph(0xFFFF, v, _MM_FROUND_TO_NEAREST_INT));
+  }
+  for (; i < count; i++) {
+    dst[i] = FloatToHalf(src[i] * scale);
+  }
+}
+
+__attribute__((target("avx512f"))) inline void DecodeHalfAvx512(uint16_t const* src, size_t count,
+                                                                float inverse_scale, float* dst) {
+  __m512 s = _mm512_set1_ps(inverse_scale);
+  size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    __m512 v = _mm512_maskz_cvtph_ps(0xFFFF, _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + i)));
+    _mm512_storeu_ps(dst + i, _mm512_mul_ps(v, s));
+  }
+  for (; i < count; i++) {
+    dst[i] = HalfToFloat(src[i]) * inverse_scale;
+  }
+}
+#endif
+
+enum class HalfConversionLevel {
+  kScalar,
+  kF16c,
+  kAvx512,
+};
+
+inline HalfConversionLevel DetectHalfConversionLevel() {
+#ifdef MRD_BINARY_X86_SIMD
+  static HalfConversionLevel const level = []() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+      return HalfConversionLevel::kAvx512;
+    }
+    if (__builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c")) {
+      return HalfConversionLevel::kF16c;
+    }
+    return HalfConversionLevel::kScalar;
+  }();
+  return level;
+#else
+  return HalfConversionLevel::kScalar;
+#endif
+}
+
+// Narrows `count` floats, each multiplied by `scale`, to 16-bit values.
+inline void EncodeReducedPrecision(SampleEncoding encoding, float const* src, size_t count,
+                                   float scale, uint16_t* dst) {
+  if (encoding == SampleEncoding::kBFloat16) {
+    for (size_t i = 0; i < count; i++) {
+      dst[i] = FloatToBFloat16(src[i] * scale);
+    }
+    return;
+  }
+
+#ifdef MRD_BINARY_X86_SIMD
+  switch (DetectHalfConversionLevel()) {
+    case HalfConversionLevel::kAvx512:
+      EncodeHalfAvx512(src, count, scale, dst);
+      return;
+    case HalfConversionLevel::kF16c:
+      EncodeHalfF16c(src, count, scale, dst);
+      return;
+    default:
+      break;
+  }
+#endif
+
+  for (size_t i = 0; i < count; i++) {
+    dst[i] = FloatToHalf(src[i] * scale);
+  }
+}
+
+// Widens `count` 16-bit values to floats, each multiplied by `inverse_scale`.
+inline void DecodeReducedPrecision(SampleEncoding encoding, uint16_t const* src, size_t count,
+                                   float inverse_scale, float* dst) {
+  if (encoding == SampleEncoding::kBFloat16) {
+    for (size_t i = 0; i < count; i++) {
+      dst[i] = BFloat16ToFloat(src[i]) * inverse_scale;
+    }
+    return;
+  }
+
+#ifdef MRD_BINARY_X86_SIMD
+  switch (DetectHalfConversionLevel()) {
+    case HalfConversionLevel::kAvx512:
+      DecodeHalfAvx512(src, count, inverse_scale, dst);
+      return;
+    case HalfConversionLevel::kF16c:
+      DecodeHalfF16c(src, count, inverse_scale, dst);
+      return;
+    default:
+      break;
+  }
+#endif
+
+  for (size_t i = 0; i < count; i++) {
+    dst[i] = HalfToFloat(src[i]) * inverse_scale;
+  }
+}
+
+// Returns the power of two that brings a row with the given peak magnitude
+// close to the top of the float16 range without overflowing it. bfloat16
+// shares the exponent range of float32 and is never scaled.
+inline float ReducedPrecisionScale(SampleEncoding encoding, float peak) {
+  if (encoding == SampleEncoding::kBFloat16 || !(peak > 0) || !std::isfinite(peak)) {
+    return 1.0f;
+  }
+
+  // peak is in [2^e, 2^(e+1)), so peak * 2^(14 - e) is in [2^14, 2^15),
+  // below the largest finite float16 (65504).
+  int shift = std::clamp(14 - std::ilogb(peak), -120, 120);
+  return std::ldexp(1.0f, shift);
+}
+
+// The number of bytes of a row of `row_length` floats in the reduced-precision encoding.
+inline constexpr size_t ReducedPrecisionRowBytes(size_t row_length) {
+  return sizeof(float) + row_length * sizeof(uint16_t);
+}
+
+// Appends the reduced-precision encoding of `rows` rows of `row_length` floats
+// (the real and imaginary parts of the samples), which need not be aligned, to
+// `out`, and adds the error it introduces to `report`.
+inline void EncodeReducedPrecisionRows(SampleEncoding encoding, uint8_t const* data, size_t rows, size_t row_length,
+                                       std::vector<uint8_t>& out, SampleEncodingReport& report) {
+  thread_local std::vector<float> row;
+  thread_local std::vector<uint16_t> encoded;
+  thread_local std::vector<float> decoded;
+  row.resize(row_length);
+  encoded.resize(row_length);
+  decoded.resize(row_length);
+
+  size_t offset = out.size();
+  out.resize(offset + rows * ReducedPrecisionRowBytes(row_length));
+  uint8_t* dst = out.data() + offset;
+  for (size_t r = 0; r < rows; r++) {
+    std::memcpy(row.data(), data + r * row_length * sizeof(float), row_length * sizeof(float));
+    float peak = 0;
+    for (size_t i = 0; i < row_length; i++) {
+      peak = std::max(peak, std::fabs(row[i]));
+    }
+
+    float scale = ReducedPrecisionScale(encoding, peak);
+    EncodeReducedPrecision(encoding, row.data(), row_length, scale, encoded.data());
+    std::memcpy(dst, &scale, sizeof(scale));
+    std::memcpy(dst + sizeof(scale), encoded.data(), row_length * sizeof(uint16_t));
+    dst += ReducedPrecisionRowBytes(row_length);
+
+    // Measure what the reader will see
+    DecodeReducedPrecision(encoding, encoded.data(), row_length, 1.0f / scale, decoded.data());
+    double max_abs_error = 0;
+    for (size_t i = 0; i < row_length; i++) {
+      double error = static_cast<double>(decoded[i]) - row[i];
+      report.error_energy += error * error;
+      report.signal_energy += static_cast<double>(row[i]) * row[i];
+      max_abs_error = std::max(max_abs_error, std::fabs(error));
+    }
+    report.value_count += row_length;
+    report.max_abs_error = std::max(report.max_abs_error, max_abs_error);
+    if (peak > 0) {
+      report.max_rel_error = std::max(report.max_rel_error, max_abs_error / peak);
+    }
+  }
+}
+
+// Appends the floats of `rows` rows encoded by EncodeReducedPrecisionRows() to `out`.
+inline void DecodeReducedPrecisionRows(SampleEncoding encoding, uint8_t const* data, size_t rows, size_t row_length,
+                                       std::vector<uint8_t>& out) {
+  thread_local std::vector<uint16_t> encoded;
+  thread_local std::vector<float> row;
+  encoded.resize(row_length);
+  row.resize(row_length);
+
+  size_t offset = out.size();
+  out.resize(offset + rows * row_length * sizeof(float));
+  uint8_t* dst = out.data() + offset;
+  for (size_t r = 0; r < rows; r++) {
+    float scale;
+    std::memcpy(&scale, data, sizeof(scale));
+    if (!(scale > 0) || !std::isfinite(scale)) {
+      throw std::runtime_error("Data in the stream has an invalid reduced-precision scale.");
+    }
+
+    std::memcpy(encoded.data(), data + sizeof(scale), row_length * sizeof(uint16_t));
+    DecodeReducedPrecision(encoding, encoded.data(), row_length, 1.0f / scale, row.data());
+    std::memcpy(dst, row.data(), row_length * sizeof(float));
+    data += ReducedPrecisionRowBytes(row_length);
+    dst += row_length * sizeof(float);
+  }
+}
+
+} // namespace mrd::binary
@@ -0,0 +1,278 @@
+#include "schema.h"
+
+#include <mutex>
+#include <set>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+namespace mrd::binary {
+namespace {
+using json = nlohmann::ordered_json;
+
+// The sizes of primitive types encoded in a fixed number of bytes. All other
+// integers and temporal types are varints.
+std::map<std::string, size_t> const kFixedPrimitiveSizes = {
+    {"bool", 1},
+    {"int8", 1},
+    {"uint8", 1},
+    {"float32", 4},
+    {"float64", 8},
+    {"complexfloat32", 8},
+    {"complexfloat64", 16},
+};
+
+std::set<std::string> const kVarIntPrimitives = {
+    "int16", "uint16", "int32", "uint32", "int64", "uint64", "size", "date", "time", "datetime",
+};
+} // namespace
+
+class EncodedSchema::Builder {
+  public:
+  Builder(EncodedSchema& schema, json const& root) : schema_(schema) {
+    for (auto const& definition : root.at("types")) {
+      // Some types are listed more than once
+      definitions_.emplace(definition.at("name").get<std::string>(), &definition);
+    }
+  }
+
+  using Environment = std::map<std::string, EncodedType const*>;
+
+  EncodedType const* Build(json const& type, Environment const& environment) {
+    if (type.is_null()) {
+      return nullptr;
+    }
+
+    if (type.is_string()) {
+      std::string name = type.get<std::string>();
+      if (auto it = environment.find(name); it != environment.end()) {
+        return it->second;
+      }
+      if (auto it = primitives_.find(name); it != primitives_.end()) {
+        return it->second;
+      }
+      if (auto it = kFixedPrimitiveSizes.find(name); it != kFixedPrimitiveSizes.end()) {
+        auto* t = New(EncodedType::Kind::kFixed);
+        t->fixed_size = it->second;
+        t->is_fixed = true;
+        return primitives_[name] = t;
+      }
+      if (kVarIntPrimitives.count(name) != 0) {
+        return primitives_[name] = New(EncodedType::Kind::kVarInt);
+      }
+      if (name == "string") {
+        return primitives_[name] = New(EncodedType::Kind::kString);
+      }
+      return Named(name, {});
+    }
+
+    if (type.is_array()) {
+      std::vector<EncodedType const*> alternatives;
+      bool has_null = false;
+      for (auto const& alternative : type) {
+        auto const& alternative_type = alternative.is_object() && alternative.contains("tag") ? alternative.at("type") : alternative;
+        has_null |= alternative_type.is_null();
+        alternatives.push_back(Build(alternative_type, environment));
+      }
+
+      if (has_null && alternatives.size() == 2 && alternatives[0] == nullptr) {
+        auto* t = New(EncodedType::Kind::kOptional);
+        t->items = {alternatives[1]};
+        t->has_samples = alternatives[1]->has_samples;
+        return t;
+      }
+
+      auto* t = New(EncodedType::Kind::kUnion);
+      t->items = std::move(alternatives);
+      for (auto const* alternative : t->items) {
+        t->has_samples |= alternative != nullptr && alternative->has_samples;
+      }
+      return t;
+    }
+
+    if (type.contains("typeArguments")) {
+      std::vector<EncodedType const*> arguments;
+      for (auto const& argument : type.at("typeArguments")) {
+        arguments.push_back(Build(argument, environment));
+      }
+      return Named(type.at("name").get<std::string>(), arguments);
+    }
+
+    if (type.contains("vector")) {
+      auto const& vector = type.at("vector");
+      auto const* items = Build(vector.at("items"), environment);
+      if (vector.contains("length")) {
+        return Repeated(EncodedType::Kind::kFixedVector, items, vector.at("length").get<size_t>());
+      }
+      return Repeated(EncodedType::Kind::kVector, items, 0);
+    }
+
+    if (type.contains("array")) {
+      auto const& array = type.at("array");
+      auto const* items = Build(array.at("items"), environment);
+      if (!array.contains("dimensions")) {
+        return Repeated(EncodedType::Kind::kDynamicArray, items, 0);
+      }
+
+      auto const& dimensions = array.at("dimensions");
+      if (dimensions.is_number()) {
+        return Repeated(EncodedType::Kind::kArray, items, dimensions.get<size_t>());
+      }
+
+      size_t length = 1;
+      for (auto const& dimension : dimensions) {
+        if (!dimension.contains("length")) {
+          return Repeated(EncodedType::Kind::kArray, items, dimensions.size());
+        }
+        length *= dimension.at("length").get<size_t>();
+      }
+      return Repeated(EncodedType::Kind::kFixedVector, items, length);
+    }
+
+    if (type.contains("map")) {
+      auto const& map = type.at("map");
+      auto* t = New(EncodedType::Kind::kMap);
+      t->items = {Build(map.at("keys"), environment), Build(map.at("values"), environment)};
+      t->has_samples = t->items[0]->has_samples || t->items[1]->has_samples;
+      return t;
+    }
+
+    if (type.contains("stream")) {
+      return Build(type.at("stream").at("items"), environment);
+    }
+
+    throw std::runtime_error("Unsupported type in schema: " + type.dump());
+  }
+
+  private:
+  EncodedType* New(EncodedType::Kind kind) {
+    schema_.types_.push_back(std::make_unique<EncodedType>());
+    schema_.types_.back()->kind = kind;
+    return schema_.types_.back().get();
+  }
+
+  EncodedType const* Repeated(EncodedType::Kind kind, EncodedType const* items, size_t length) {
+    auto* t = New(kind);
+    t->items = {items};
+    t->length = length;
+    t->has_samples = items->has_samples;
+    if (kind == EncodedType::Kind::kFixedVector && items->is_fixed) {
+      t->is_fixed = true;
+      t->fixed_size = length * items->fixed_size;
+    }
+    return t;
+  }
+
+  // A type defined in the schema, with the given type arguments by position.
+  EncodedType const* Named(std::string name, std::vector<EncodedType const*> const& arguments) {
+    if (auto dot = name.find('.'); dot != std::string::npos) {
+      name = name.substr(dot + 1);
+    }
+
+    std::string key = name;
+    for (auto const* argument : arguments) {
+      key += "," + std::to_string(reinterpret_cast<uintptr_t>(argument));
+    }
+    if (auto it = built_.find(key); it != built_.end()) {
+      return it->second;
+    }
+
+    auto it = definitions_.find(name);
+    if (it == definitions_.end()) {
+      throw std::runtime_error("Unknown type in schema: " + name);
+    }
+    json const& definition = *it->second;
+
+    Environment environment;
+    if (definition.contains("typeParameters")) {
+      auto const& parameters = definition.at("typeParameters");
+      if (parameters.size() != arguments.size()) {
+        throw std::runtime_error("Wrong number of type arguments for " + name + " in schema.");
+      }
+      for (size_t i = 0; i < parameters.size(); i++) {
+        environment.emplace(parameters[i].get<std::string>(), arguments[i]);
+      }
+    }
+
+    EncodedType const* t;
+    if (definition.contains("fields")) {
+      t = Record(name, definition.at("fields"), environment);
+    } else if (definition.contains("values")) {
+      std::string base = definition.value("base", "int32");
+      t = Build(base, {});
+    } else {
+      t = Build(definition.at("type"), environment);
+    }
+
+    built_.emplace(key, t);
+    return t;
+  }
+
+  EncodedType const* Record(std::string const& name, json const& fields, Environment const& environment) {
+    auto* t = New(EncodedType::Kind::kRecord);
+    t->is_fixed = true;
+    for (auto const& field : fields) {
+      EncodedType const* field_type = Build(field.at("type"), environment);
+      if (name == "Acquisition" && field.at("name") == "data") {
+        field_type = Samples(field_type);
+      }
+
+      t->items.push_back(field_type);
+      t->has_samples |= field_type->has_samples;
+      t->is_fixed &= field_type->is_fixed;
+      t->fixed_size += field_type->fixed_size;
+    }
+    if (!t->is_fixed) {
+      t->fixed_size = 0;
+    }
+    return t;
+  }
+
+  // Only acquisition data is transported in reduced precision, so that other
+  // complex float arrays keep their full precision.
+  EncodedType const* Samples(EncodedType const* data) {
+    if (data->kind != EncodedType::Kind::kArray || data->length != 2 || !data->items[0]->is_fixed ||
+        data->items[0]->fixed_size != 2 * sizeof(float)) {
+      throw std::runtime_error("Unexpected type of acquisition data in schema.");
+    }
+
+    auto* t = New(EncodedType::Kind::kSamples);
+    t->has_samples = true;
+    return t;
+  }
+
+  EncodedSchema& schema_;
+  std::map<std::string, json const*> definitions_;
+  std::map<std::string, EncodedType const*> primitives_;
+  std::map<std::string, EncodedType const*> built_;
+};
+
+std::shared_ptr<EncodedSchema const> EncodedSchema::Get(std::string const& schema, bool reduced_samples) {
+  static std::mutex mutex;
+  static std::map<std::pair<std::string, bool>, std::shared_ptr<EncodedSchema const>> schemas;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& encoded = schemas[{schema, reduced_samples}];
+  if (!encoded) {
+    encoded = std::make_shared<EncodedSchema>(schema, reduced_samples);
+  }
+  return encoded;
+}
+
+EncodedSchema::EncodedSchema(std::string const& schema, bool reduced_samples) : reduced_samples_(reduced_samples) {
+  json root = json::parse(schema);
+  Builder builder(*this, root);
+  for (auto const& step : root.at("protocol").at("sequence")) {
+    steps_.emplace(step.at("name").get<std::string>(), builder.Build(step.at("type"), {}));
+  }
+}
+
+EncodedType const& EncodedSchema::StepType(std::string const& name) const {
+  auto it = steps_.find(name);
+  if (it == steps_.end() || it->second == nullptr) {
+    throw std::runtime_error("Protocol step " + name + " is not in the schema.");
+  }
+  return *it->second;
+}
+
+} // namespace mrd::binary
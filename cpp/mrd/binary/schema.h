@@ -0,0 +1,261 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace mrd::binary {
+// The binary encoding of a type of the protocol's schema, as far as needed to
+// find where an encoded value ends and where the samples of acquisition data
+// are within it, without decoding the value.
+struct EncodedType {
+  enum class Kind : uint8_t {
+    // `fixed_size` bytes, e.g. floating-point numbers or 1-byte integers and enums
+    kFixed,
+    // A varint, e.g. wider integers, enums and dates
+    kVarInt,
+    // A varint length followed by that many bytes
+    kString,
+    // A byte telling whether the value (items[0]) follows
+    kOptional,
+    // A varint index followed by the alternative with that index (items), or
+    // nothing for a null alternative
+    kUnion,
+    // A varint count followed by that many items[0]
+    kVector,
+    // `length` items[0], without a count (fixed vectors and arrays)
+    kFixedVector,
+    // `length` varint dimensions followed by their product of items[0]
+    kArray,
+    // A varint rank, that many varint dimensions and their product of items[0]
+    kDynamicArray,
+    // A varint count followed by that many pairs of items[0] and items[1]
+    kMap,
+    // The fields, in order
+    kRecord,
+    // The samples of acquisition data: two varint dimensions followed by the
+    // complex float samples, in the stream's SampleEncoding
+    kSamples,
+  };
+
+  Kind kind = Kind::kFixed;
+  // The number of bytes of every value of the type, if it does not depend on
+  // the value, or 0 (see is_fixed).
+  size_t fixed_size = 0;
+  bool is_fixed = false;
+  size_t length = 0;
+  // Whether values of the type can contain samples of acquisition data.
+  bool has_samples = false;
+  // Nullptr for a null union alternative.
+  std::vector<EncodedType const*> items;
+};
+
+// The location of the samples of acquisition data within an encoded value.
+struct EncodedSamples {
+  // Offset of the dimensions and of the first sample
+  size_t begin = 0;
+  size_t data = 0;
+  // Offset just past the last sample
+  size_t end = 0;
+  size_t rows = 0;
+  size_t columns = 0;
+};
+
+// The schema of the Mrd protocol as written in the header of binary streams,
+// describing the encoding of the header and of the items of the `data` stream.
+// Acquisition data (the `data` field of the Acquisition record) is described
+// in the given sample encoding (see reduced_precision.h); the encodings are
+// otherwise those of the generated serializers.
+class EncodedSchema {
+  public:
+  // Returns the schema for the given JSON schema and whether acquisition data
+  // is in a reduced-precision encoding. Schemas are parsed once per process.
+  static std::shared_ptr<EncodedSchema const> Get(std::string const& schema, bool reduced_samples);
+
+  EncodedSchema(std::string const& schema, bool reduced_samples);
+
+  EncodedSchema(EncodedSchema const&) = delete;
+  EncodedSchema& operator=(EncodedSchema const&) = delete;
+
+  // The type of the protocol step with the given name, or the type of its
+  // items if it is a stream.
+  EncodedType const& StepType(std::string const& name) const;
+
+  bool ReducedSamples() const { return reduced_samples_; }
+
+  private:
+  class Builder;
+
+  bool reduced_samples_;
+  std::vector<std::unique_ptr<EncodedType>> types_;
+  std::map<std::string, EncodedType const*> steps_;
+};
+
+// Bytes of an encoded value in memory.
+class MemoryInput {
+  public:
+  MemoryInput(uint8_t const* data, size_t size) : data_(data), size_(size) {}
+
+  uint8_t const* Bytes(size_t offset, size_t count) {
+    if (count > size_ || offset > size_ - count) {
+      throw std::runtime_error("Encoded value ends prematurely.");
+    }
+    return data_ + offset;
+  }
+
+  private:
+  uint8_t const* data_;
+  size_t size_;
+};
+
+namespace detail {
+template <typename Input>
+uint64_t WalkVarInt(Input& input, size_t& offset) {
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    uint8_t byte = *input.Bytes(offset++, 1);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  throw std::runtime_error("Encoded value has an invalid varint.");
+}
+
+inline size_t CheckedProduct(uint64_t a, uint64_t b) {
+  size_t product;
+  if (__builtin_mul_overflow(a, b, &product)) {
+    throw std::runtime_error("Encoded value has an invalid size.");
+  }
+  return product;
+}
+
+inline size_t CheckedSum(size_t a, size_t b) {
+  size_t sum;
+  if (__builtin_add_overflow(a, b, &sum)) {
+    throw std::runtime_error("Encoded value has an invalid size.");
+  }
+  return sum;
+}
+
+template <typename Input, typename OnSamples>
+size_t WalkItems(EncodedType const& item, uint64_t count, Input& input, size_t offset, bool reduced_samples,
+                 OnSamples& on_samples);
+
+template <typename Input, typename OnSamples>
+size_t Walk(EncodedType const& type, Input& input, size_t offset, bool reduced_samples, OnSamples& on_samples) {
+  if (type.is_fixed) {
+    input.Bytes(offset, type.fixed_size);
+    return offset + type.fixed_size;
+  }
+
+  switch (type.kind) {
+    case EncodedType::Kind::kFixed:
+      input.Bytes(offset, type.fixed_size);
+      return offset + type.fixed_size;
+    case EncodedType::Kind::kVarInt:
+      WalkVarInt(input, offset);
+      return offset;
+    case EncodedType::Kind::kString: {
+      size_t size = WalkVarInt(input, offset);
+      input.Bytes(offset, size);
+      return CheckedSum(offset, size);
+    }
+    case EncodedType::Kind::kOptional: {
+      uint8_t has_value = *input.Bytes(offset++, 1);
+      return has_value ? Walk(*type.items[0], input, offset, reduced_samples, on_samples) : offset;
+    }
+    case EncodedType::Kind::kUnion: {
+      uint64_t index = WalkVarInt(input, offset);
+      if (index >= type.items.size()) {
+        throw std::runtime_error("Encoded value has an invalid union index.");
+      }
+      return type.items[index] ? Walk(*type.items[index], input, offset, reduced_samples, on_samples) : offset;
+    }
+    case EncodedType::Kind::kVector: {
+      uint64_t count = WalkVarInt(input, offset);
+      return WalkItems(*type.items[0], count, input, offset, reduced_samples, on_samples);
+    }
+    case EncodedType::Kind::kFixedVector:
+      return WalkItems(*type.items[0], type.length, input, offset, reduced_samples, on_samples);
+    case EncodedType::Kind::kArray:
+    case EncodedType::Kind::kDynamicArray: {
+      uint64_t rank = type.kind == EncodedType::Kind::kArray ? type.length : WalkVarInt(input, offset);
+      uint64_t count = 1;
+      for (uint64_t i = 0; i < rank; i++) {
+        count = CheckedProduct(count, WalkVarInt(input, offset));
+      }
+      return WalkItems(*type.items[0], count, input, offset, reduced_samples, on_samples);
+    }
+    case EncodedType::Kind::kMap: {
+      uint64_t count = WalkVarInt(input, offset);
+      for (uint64_t i = 0; i < count; i++) {
+        offset = Walk(*type.items[0], input, offset, reduced_samples, on_samples);
+        offset = Walk(*type.items[1], input, offset, reduced_samples, on_samples);
+      }
+      return offset;
+    }
+    case EncodedType::Kind::kRecord:
+      for (auto const* field : type.items) {
+        offset = Walk(*field, input, offset, reduced_samples, on_samples);
+      }
+      return offset;
+    case EncodedType::Kind::kSamples: {
+      EncodedSamples samples;
+      samples.begin = offset;
+      samples.rows = WalkVarInt(input, offset);
+      samples.columns = WalkVarInt(input, offset);
+      samples.data = offset;
+      size_t count = CheckedProduct(samples.rows, samples.columns);
+      size_t size = 0;
+      if (count != 0) {
+        size = reduced_samples
+                   ? CheckedProduct(samples.rows, CheckedSum(sizeof(float), CheckedProduct(samples.columns, 2 * sizeof(uint16_t))))
+                   : CheckedProduct(count, 2 * sizeof(float));
+      }
+      input.Bytes(offset, size);
+      samples.end = CheckedSum(offset, size);
+      on_samples(samples);
+      return samples.end;
+    }
+  }
+  throw std::runtime_error("Invalid encoded type.");
+}
+
+template <typename Input, typename OnSamples>
+size_t WalkItems(EncodedType const& item, uint64_t count, Input& input, size_t offset, bool reduced_samples,
+                 OnSamples& on_samples) {
+  if (item.is_fixed) {
+    size_t size = CheckedProduct(count, item.fixed_size);
+    input.Bytes(offset, size);
+    return CheckedSum(offset, size);
+  }
+
+  for (uint64_t i = 0; i < count; i++) {
+    offset = Walk(item, input, offset, reduced_samples, on_samples);
+  }
+  return offset;
+}
+} // namespace detail
+
+// Returns the offset just past the value of the given type encoded at
+// `offset` in `input`, calling `on_samples(EncodedSamples const&)` for the
+// samples of acquisition data within the value. `input` provides the bytes
+// with `uint8_t const* Bytes(size_t offset, size_t count)`, throwing if the
+// value is truncated.
+template <typename Input, typename OnSamples>
+size_t WalkEncodedValue(EncodedSchema const& schema, EncodedType const& type, Input& input, size_t offset,
+                        OnSamples&& on_samples) {
+  return detail::Walk(type, input, offset, schema.ReducedSamples(), on_samples);
+}
+
+template <typename Input>
+size_t WalkEncodedValue(EncodedSchema const& schema, EncodedType const& type, Input& input, size_t offset) {
+  auto ignore = [](EncodedSamples const&) {};
+  return detail::Walk(type, input, offset, schema.ReducedSamples(), ignore);
+}
+
+} // namespace mrd::binary
@@ -0,0 +1,441 @@
+#pragma once
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#endif
+
+// A single-producer/single-consumer byte ring buffer in POSIX shared memory,
+// exposed as std::streambufs so that binary writers and readers in two
+// processes on the same host can use it in place of a pipe or file.
+//
+// The writer creates the shared memory object, failing if the name is taken
+// unless asked to replace it; the reader opens it (waiting for it to appear)
+// and unlinks its name, so the memory is released once both
+// sides have closed. Each side blocks on a futex in the shared segment while
+// the ring is full (writer) or empty (reader), and only makes a system call
+// to wake the other side when it is actually sleeping.
+namespace mrd::binary {
+
+namespace shm_detail {
+static constexpr uint32_t kMagic = 0x4D524452;  // "MRDR"
+static constexpr uint32_t kLayoutVersion = 1;
+static constexpr size_t kMinimumCapacity = 4096;
+static constexpr int kSpinCount = 256;
+
+// How often a blocked side checks whether its peer process is still alive.
+static constexpr std::chrono::milliseconds kLivenessInterval{100};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+              "Shared memory transport requires address-free atomics");
+
+struct RingHeader {
+  std::atomic<uint32_t> magic;
+  uint32_t layout_version;
+  uint64_t capacity;
+  int32_t writer_pid;
+  std::atomic<int32_t> reader_pid;
+
+  // Written by the writer.
+  alignas(64) std::atomic<uint64_t> write_position;
+  std::atomic<uint32_t> data_futex;
+  std::atomic<uint32_t> writer_closed;
+  std::atomic<uint32_t> writer_waiting;
+
+  // Written by the reader.
+  alignas(64) std::atomic<uint64_t> read_position;
+  std::atomic<uint32_t> space_futex;
+  std::atomic<uint32_t> reader_closed;
+  std::atomic<uint32_t> reader_waiting;
+};
+
+static constexpr size_t kDataOffset = (sizeof(RingHeader) + 63) / 64 * 64;
+
+inline void FutexWait(std::atomic<uint32_t>& word, uint32_t expected) {
+#if defined(__linux__)
+  auto seconds = std::chrono::duration_cast<std::chrono::seconds>(kLivenessInterval);
+  struct timespec timeout {};
+  timeout.tv_sec = seconds.count();
+  timeout.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(kLivenessInterval - seconds).count();
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+#else
+  if (word.load(std::memory_order_acquire) == expected) {
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+#endif
+}
+
+inline void FutexWake(std::atomic<uint32_t>& word) {
+#if defined(__linux__)
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr, 0);
+#else
+  (void)word;
+#endif
+}
+
+// Bumps the futex word and wakes the peer if it is (about to be) asleep on it.
+inline void Signal(std::atomic<uint32_t>& word, std::atomic<uint32_t>& peer_waiting) {
+  word.fetch_add(1, std::memory_order_seq_cst);
+  if (peer_waiting.load(std::memory_order_seq_cst) != 0) {
+    FutexWake(word);
+  }
+}
+
+// Blocks until `ready()` or `stop()` returns true, spinning briefly first.
+// `alive()` is polled every kLivenessInterval while asleep.
+template <typename Ready, typename Stop, typename Alive>
+bool Wait(std::atomic<uint32_t>& word, std::atomic<uint32_t>& waiting, Ready ready, Stop stop, Alive alive) {
+  for (int i = 0; i < kSpinCount; i++) {
+    if (ready()) {
+      return true;
+    }
+    if (stop()) {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+
+  while (true) {
+    waiting.store(1, std::memory_order_seq_cst);
+    uint32_t expected = word.load(std::memory_order_seq_cst);
+    if (ready()) {
+      waiting.store(0, std::memory_order_relaxed);
+      return true;
+    }
+    if (stop() || !alive()) {
+      waiting.store(0, std::memory_order_relaxed);
+      return ready();
+    }
+    FutexWait(word, expected);
+    waiting.store(0, std::memory_order_relaxed);
+  }
+}
+
+inline bool ProcessAlive(int32_t pid) {
+  return pid == 0 || kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+inline std::runtime_error SystemError(std::string const& what, std::string const& name) {
+  return std::runtime_error(what + " '" + name + "': " + std::strerror(errno));
+}
+
+class Mapping {
+  public:
+  Mapping() = default;
+  Mapping(Mapping const&) = delete;
+  Mapping& operator=(Mapping const&) = delete;
+
+  ~Mapping() {
+    if (address_ != nullptr) {
+      munmap(address_, size_);
+    }
+  }
+
+  void Map(int fd, size_t size, std::string const& name) {
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+      auto error = SystemError("Failed to map shared memory", name);
+      close(fd);
+      throw error;
+    }
+    close(fd);
+    address_ = address;
+    size_ = size;
+  }
+
+  RingHeader* Header() const { return static_cast<RingHeader*>(address_); }
+  uint8_t* Data() const { return static_cast<uint8_t*>(address_) + kDataOffset; }
+
+  private:
+  void* address_ = nullptr;
+  size_t size_ = 0;
+};
+} // namespace shm_detail
+
+// The writing end of a shared memory ring buffer. Creates the shared memory
+// object `name` (e.g. "/mrd-recon"), and fails if an object of that name
+// already exists, such as one left behind by a writer whose reader never
+// opened it, unless `replace_existing` is set.
+// Writes block while the ring is full, and fail once the reader has closed
+// its end or its process has exited.
+class SharedMemoryOutputBuffer : public std::streambuf {
+  public:
+  SharedMemoryOutputBuffer(std::string const& name, size_t capacity, bool replace_existing = false) {
+    size_t ring_capacity = shm_detail::kMinimumCapacity;
+    while (ring_capacity < capacity) {
+      ring_capacity <<= 1;
+    }
+
+    if (replace_existing) {
+      shm_unlink(name.c_str());
+    }
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+      if (errno == EEXIST) {
+        throw std::runtime_error("Shared memory '" + name + "' already exists.");
+      }
+      throw shm_detail::SystemError("Failed to create shared memory", name);
+    }
+
+    size_t size = shm_detail::kDataOffset + ring_capacity;
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+      auto error = shm_detail::SystemError("Failed to size shared memory", name);
+      close(fd);
+      shm_unlink(name.c_str());
+      throw error;
+    }
+
+    mapping_.Map(fd, size, name);
+    header_ = new (mapping_.Header()) shm_detail::RingHeader{};
+    data_ = mapping_.Data();
+    mask_ = ring_capacity - 1;
+
+    header_->layout_version = shm_detail::kLayoutVersion;
+    header_->capacity = ring_capacity;
+    header_->writer_pid = static_cast<int32_t>(getpid());
+    header_->magic.store(shm_detail::kMagic, std::memory_order_release);
+  }
+
+  ~SharedMemoryOutputBuffer() override {
+    Close();
+  }
+
+  // Marks the end of the stream. The reader sees end-of-file once it has
+  // consumed everything written before this call.
+  void Close() {
+    if (header_ != nullptr && header_->writer_closed.load(std::memory_order_relaxed) == 0) {
+      header_->writer_closed.store(1, std::memory_order_seq_cst);
+      shm_detail::Signal(header_->data_futex, header_->reader_waiting);
+    }
+  }
+
+  protected:
+  std::streamsize xsputn(char const* s, std::streamsize n) override {
+    std::streamsize written = 0;
+    uint64_t write_position = header_->write_position.load(std::memory_order_relaxed);
+    while (written < n) {
+      uint64_t read_position = header_->read_position.load(std::memory_order_acquire);
+      size_t free = header_->capacity - (write_position - read_position);
+      if (free == 0) {
+        auto has_space = [&] {
+          return header_->read_position.load(std::memory_order_acquire) != read_position;
+        };
+        auto reader_closed = [&] { return header_->reader_closed.load(std::memory_order_acquire) != 0; };
+        auto reader_alive = [&] {
+          return shm_detail::ProcessAlive(header_->reader_pid.load(std::memory_order_relaxed));
+        };
+        if (!shm_detail::Wait(header_->space_futex, header_->writer_waiting, has_space, reader_closed, reader_alive)) {
+          break;
+        }
+        continue;
+      }
+
+      if (header_->reader_closed.load(std::memory_order_relaxed) != 0) {
+        break;
+      }
+
+      size_t offset = write_position & mask_;
+      size_t count = std::min({free, static_cast<size_t>(n - written), mask_ + 1 - offset});
+      std::memcpy(data_ + offset, s + written, count);
+      written += count;
+      write_position += count;
+      header_->write_position.store(write_position, std::memory_order_release);
+      shm_detail::Signal(header_->data_futex, header_->reader_waiting);
+    }
+
+    return written;
+  }
+
+  int_type overflow(int_type ch) override {
+    if (traits_type::eq_int_type(ch, traits_type::eof())) {
+      return traits_type::not_eof(ch);
+    }
+
+    char c = traits_type::to_char_type(ch);
+    return xsputn(&c, 1) == 1 ? ch : traits_type::eof();
+  }
+
+  private:
+  shm_detail::Mapping mapping_;
+  shm_detail::RingHeader* header_ = nullptr;
+  uint8_t* data_ = nullptr;
+  size_t mask_ = 0;
+};
+
+// The reading end of a shared memory ring buffer. Waits up to `timeout` for
+// the writer to create the shared memory object `name`.
+//
+// Bytes are read directly out of the shared segment, which is handed out as
+// the streambuf's get area in chunks of up to a quarter of the ring, so the
+// writer can keep filling the rest of the ring in the meantime.
+class SharedMemoryInputBuffer : public std::streambuf {
+  public:
+  SharedMemoryInputBuffer(std::string const& name,
+                          std::chrono::milliseconds timeout = std::chrono::seconds(10)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    int fd;
+    while ((fd = shm_open(name.c_str(), O_RDWR, 0)) < 0) {
+      if (errno != ENOENT || std::chrono::steady_clock::now() >= deadline) {
+        throw shm_detail::SystemError("Failed to open shared memory", name);
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    struct stat info {};
+    while (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) < shm_detail::kDataOffset) {
+      if (std::chrono::steady_clock::now() >= deadline) {
+        close(fd);
+        throw std::runtime_error("Shared memory '" + name + "' was not initialized by its writer.");
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    mapping_.Map(fd, static_cast<size_t>(info.st_size), name);
+    header_ = mapping_.Header();
+    while (header_->magic.load(std::memory_order_acquire) != shm_detail::kMagic) {
+      if (std::chrono::steady_clock::now() >= deadline) {
+        throw std::runtime_error("Shared memory '" + name + "' was not initialized by its writer.");
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    if (header_->layout_version != shm_detail::kLayoutVersion ||
+        shm_detail::kDataOffset + header_->capacity > static_cast<size_t>(info.st_size)) {
+      throw std::runtime_error("Shared memory '" + name + "' has an unsupported layout.");
+    }
+
+    int32_t no_reader = 0;
+    if (!header_->reader_pid.compare_exchange_strong(no_reader, static_cast<int32_t>(getpid()))) {
+      throw std::runtime_error("Shared memory '" + name + "' already has a reader.");
+    }
+
+    // The segment stays alive until both sides unmap it.
+    shm_unlink(name.c_str());
+
+    data_ = mapping_.Data();
+    mask_ = header_->capacity - 1;
+    chunk_size_ = std::max<size_t>(header_->capacity / 4, 1);
+    read_position_ = header_->read_position.load(std::memory_order_relaxed);
+  }
+
+  ~SharedMemoryInputBuffer() override {
+    if (header_ != nullptr) {
+      Release();
+      header_->reader_closed.store(1, std::memory_order_seq_cst);
+      shm_detail::Signal(header_->space_futex, header_->writer_waiting);
+    }
+  }
+
+  protected:
+  int_type underflow() override {
+    Release();
+
+    uint64_t write_position = header_->write_position.load(std::memory_order_acquire);
+    if (write_position == read_position_) {
+      auto has_data = [&] {
+        return header_->write_position.load(std::memory_order_acquire) != read_position_;
+      };
+      auto writer_closed = [&] { return header_->writer_closed.load(std::memory_order_acquire) != 0; };
+      auto writer_alive = [&] { return shm_detail::ProcessAlive(header_->writer_pid); };
+      if (!shm_detail::Wait(header_->data_futex, header_->reader_waiting, has_data, writer_closed, writer_alive)) {
+        return traits_type::eof();
+      }
+      write_position = header_->write_position.load(std::memory_order_acquire);
+    }
+
+    size_t offset = read_position_ & mask_;
+    size_t count = std::min({static_cast<size_t>(write_position - read_position_), mask_ + 1 - offset, chunk_size_});
+    char* begin = reinterpret_cast<char*>(data_ + offset);
+    setg(begin, begin, begin + count);
+    return traits_type::to_int_type(*begin);
+  }
+
+  std::streamsize showmanyc() override {
+    return static_cast<std::streamsize>(header_->write_position.load(std::memory_order_acquire) - read_position_);
+  }
+
+  private:
+  // Hands the bytes consumed from the get area back to the writer.
+  void Release() {
+    if (gptr() == nullptr) {
+      return;
+    }
+
+    size_t consumed = gptr() - eback();
+    setg(nullptr, nullptr, nullptr);
+    if (consumed > 0) {
+      read_position_ += consumed;
+      header_->read_position.store(read_position_, std::memory_order_release);
+      shm_detail::Signal(header_->space_futex, header_->writer_waiting);
+    }
+  }
+
+  shm_detail::Mapping mapping_;
+  shm_detail::RingHeader* header_ = nullptr;
+  uint8_t* data_ = nullptr;
+  size_t mask_ = 0;
+  size_t chunk_size_ = 0;
+  uint64_t read_position_ = 0;
+};
+
+// An std::ostream writing to a new shared memory ring buffer, for use with
+// binary writers:
+//   yardl::binary::SharedMemoryOutputStream stream("/mrd-recon");
+//   mrd::binary::MrdWriter writer(stream);
+class SharedMemoryOutputStream : public std::ostream {
+  public:
+  static constexpr size_t kDefaultCapacity = 16 * 1024 * 1024;
+
+  explicit SharedMemoryOutputStream(std::string const& name, size_t capacity = kDefaultCapacity,
+                                    bool replace_existing = false)
+      : std::ostream(nullptr), buffer_(name, capacity, replace_existing) {
+    rdbuf(&buffer_);
+  }
+
+  // Marks the end of the stream. Also done on destruction.
+  void Close() {
+    flush();
+    buffer_.Close();
+  }
+
+  private:
+  SharedMemoryOutputBuffer buffer_;
+};
+
+// An std::istream reading from a shared memory ring buffer created by a
+// SharedMemoryOutputStream, for use with binary readers.
+class SharedMemoryInputStream : public std::istream {
+  public:
+  explicit SharedMemoryInputStream(std::string const& name,
+                                   std::chrono::milliseconds timeout = std::chrono::seconds(10))
+      : std::istream(nullptr), buffer_(name, timeout) {
+    rdbuf(&buffer_);
+  }
+
+  private:
+  SharedMemoryInputBuffer buffer_;
+};
+
+} // namespace mrd::binary
@@ -0,0 +1,431 @@
+#include "byte_size.h"
+
+namespace yardl {
+size_t ByteSize(mrd::EncodingCounters const& value) {
+  return yardl::ByteSize(value.kspace_encode_step_1) +
+         yardl::ByteSize(value.kspace_encode_step_2) +
+         yardl::ByteSize(value.average) +
+         yardl::ByteSize(value.slice) +
+         yardl::ByteSize(value.contrast) +
+         yardl::ByteSize(value.phase) +
+         yardl::ByteSize(value.repetition) +
+         yardl::ByteSize(value.set) +
+         yardl::ByteSize(value.segment) +
+         yardl::ByteSize(value.user);
+}
+
+size_t ByteSize(mrd::AcquisitionHeader const& value) {
+  return yardl::ByteSize(value.flags) +
+         yardl::ByteSize(value.idx) +
+         yardl::ByteSize(value.measurement_uid) +
+         yardl::ByteSize(value.scan_counter) +
+         yardl::ByteSize(value.acquisition_center_frequency) +
+         yardl::ByteSize(value.acquisition_time_stamp_ns) +
+         yardl::ByteSize(value.physiology_time_stamp_ns) +
+         yardl::ByteSize(value.channel_order) +
+         yardl::ByteSize(value.discard_pre) +
+         yardl::ByteSize(value.discard_post) +
+         yardl::ByteSize(value.center_sample) +
+         yardl::ByteSize(value.encoding_space_ref) +
+         yardl::ByteSize(value.sample_time_ns) +
+         yardl::ByteSize(value.position) +
+         yardl::ByteSize(value.read_dir) +
+         yardl::ByteSize(value.phase_dir) +
+         yardl::ByteSize(value.slice_dir) +
+         yardl::ByteSize(value.patient_table_position) +
+         yardl::ByteSize(value.user_int) +
+         yardl::ByteSize(value.user_float);
+}
+
+size_t ByteSize(mrd::Acquisition const& value) {
+  return yardl::ByteSize(value.head) +
+         yardl::ByteSize(value.data) +
+         yardl::ByteSize(value.phase) +
+         yardl::ByteSize(value.trajectory);
+}
+
+size_t ByteSize(mrd::AcquisitionPrototype const& value) {
+  return yardl::ByteSize(value.head) +
+         yardl::ByteSize(value.data_sample_counts);
+}
+
+size_t ByteSize(mrd::SubjectInformationType const& value) {
+  return yardl::ByteSize(value.patient_name) +
+         yardl::ByteSize(value.patient_weight_kg) +
+         yardl::ByteSize(value.patient_height_m) +
+         yardl::ByteSize(value.patient_id) +
+         yardl::ByteSize(value.patient_birthdate) +
+         yardl::ByteSize(value.patient_gender);
+}
+
+size_t ByteSize(mrd::StudyInformationType const& value) {
+  return yardl::ByteSize(value.study_date) +
+         yardl::ByteSize(value.study_time) +
+         yardl::ByteSize(value.study_id) +
+         yardl::ByteSize(value.accession_number) +
+         yardl::ByteSize(value.referring_physician_name) +
+         yardl::ByteSize(value.study_description) +
+         yardl::ByteSize(value.study_instance_uid) +
+         yardl::ByteSize(value.body_part_examined);
+}
+
+size_t ByteSize(mrd::ThreeDimensionalFloat const& value) {
+  return yardl::ByteSize(value.x) +
+         yardl::ByteSize(value.y) +
+         yardl::ByteSize(value.z);
+}
+
+size_t ByteSize(mrd::MeasurementDependencyType const& value) {
+  return yardl::ByteSize(value.dependency_type) +
+         yardl::ByteSize(value.measurement_id);
+}
+
+size_t ByteSize(mrd::ReferencedImageSequenceType const& value) {
+  return yardl::ByteSize(value.referenced_sop_instance_uid);
+}
+
+size_t ByteSize(mrd::MeasurementInformationType const& value) {
+  return yardl::ByteSize(value.measurement_id) +
+         yardl::ByteSize(value.series_date) +
+         yardl::ByteSize(value.series_time) +
+         yardl::ByteSize(value.patient_position) +
+         yardl::ByteSize(value.relative_table_position) +
+         yardl::ByteSize(value.initial_series_number) +
+         yardl::ByteSize(value.protocol_name) +
+         yardl::ByteSize(value.sequence_name) +
+         yardl::ByteSize(value.series_description) +
+         yardl::ByteSize(value.measurement_dependency) +
+         yardl::ByteSize(value.series_instance_uid_root) +
+         yardl::ByteSize(value.frame_of_reference_uid) +
+         yardl::ByteSize(value.referenced_image_sequence);
+}
+
+size_t ByteSize(mrd::CoilLabelType const& value) {
+  return yardl::ByteSize(value.coil_number) +
+         yardl::ByteSize(value.coil_name);
+}
+
+size_t ByteSize(mrd::AcquisitionSystemInformationType const& value) {
+  return yardl::ByteSize(value.system_vendor) +
+         yardl::ByteSize(value.system_model) +
+         yardl::ByteSize(value.system_field_strength_t) +
+         yardl::ByteSize(value.relative_receiver_noise_bandwidth) +
+         yardl::ByteSize(value.receiver_channels) +
+         yardl::ByteSize(value.coil_label) +
+         yardl::ByteSize(value.institution_name) +
+         yardl::ByteSize(value.station_name) +
+         yardl::ByteSize(value.device_id) +
+         yardl::ByteSize(value.device_serial_number);
+}
+
+size_t ByteSize(mrd::ExperimentalConditionsType const& value) {
+  return yardl::ByteSize(value.h1resonance_frequency_hz);
+}
+
+size_t ByteSize(mrd::MatrixSizeType const& value) {
+  return yardl::ByteSize(value.x) +
+         yardl::ByteSize(value.y) +
+         yardl::ByteSize(value.z);
+}
+
+size_t ByteSize(mrd::FieldOfViewMm const& value) {
+  return yardl::ByteSize(value.x) +
+         yardl::ByteSize(value.y) +
+         yardl::ByteSize(value.z);
+}
+
+size_t ByteSize(mrd::EncodingSpaceType const& value) {
+  return yardl::ByteSize(value.matrix_size) +
+         yardl::ByteSize(value.field_of_view_mm);
+}
+
+size_t ByteSize(mrd::LimitType const& value) {
+  return yardl::ByteSize(value.minimum) +
+         yardl::ByteSize(value.maximum) +
+         yardl::ByteSize(value.center);
+}
+
+size_t ByteSize(mrd::EncodingLimitsType const& value) {
+  return yardl::ByteSize(value.kspace_encoding_step_0) +
+         yardl::ByteSize(value.kspace_encoding_step_1) +
+         yardl::ByteSize(value.kspace_encoding_step_2) +
+         yardl::ByteSize(value.average) +
+         yardl::ByteSize(value.slice) +
+         yardl::ByteSize(value.contrast) +
+         yardl::ByteSize(value.phase) +
+         yardl::ByteSize(value.repetition) +
+         yardl::ByteSize(value.set) +
+         yardl::ByteSize(value.segment) +
+         yardl::ByteSize(value.user_0) +
+         yardl::ByteSize(value.user_1) +
+         yardl::ByteSize(value.user_2) +
+         yardl::ByteSize(value.user_3) +
+         yardl::ByteSize(value.user_4) +
+         yardl::ByteSize(value.user_5) +
+         yardl::ByteSize(value.user_6) +
+         yardl::ByteSize(value.user_7);
+}
+
+size_t ByteSize(mrd::UserParameterLongType const& value) {
+  return yardl::ByteSize(value.name) +
+         yardl::ByteSize(value.value);
+}
+
+size_t ByteSize(mrd::UserParameterDoubleType const& value) {
+  return yardl::ByteSize(value.name) +
+         yardl::ByteSize(value.value);
+}
+
+size_t ByteSize(mrd::UserParameterStringType const& value) {
+  return yardl::ByteSize(value.name) +
+         yardl::ByteSize(value.value);
+}
+
+size_t ByteSize(mrd::TrajectoryDescriptionType const& value) {
+  return yardl::ByteSize(value.identifier) +
+         yardl::ByteSize(value.user_parameter_long) +
+         yardl::ByteSize(value.user_parameter_double) +
+         yardl::ByteSize(value.user_parameter_string) +
+         yardl::ByteSize(value.comment);
+}
+
+size_t ByteSize(mrd::AccelerationFactorType const& value) {
+  return yardl::ByteSize(value.kspace_encoding_step_1) +
+         yardl::ByteSize(value.kspace_encoding_step_2);
+}
+
+size_t ByteSize(mrd::MultibandSpacingType const& value) {
+  return yardl::ByteSize(value.d_z);
+}
+
+size_t ByteSize(mrd::MultibandType const& value) {
+  return yardl::ByteSize(value.spacing) +
+         yardl::ByteSize(value.delta_kz) +
+         yardl::ByteSize(value.multiband_factor) +
+         yardl::ByteSize(value.calibration) +
+         yardl::ByteSize(value.calibration_encoding);
+}
+
+size_t ByteSize(mrd::ParallelImagingType const& value) {
+  return yardl::ByteSize(value.acceleration_factor) +
+         yardl::ByteSize(value.calibration_mode) +
+         yardl::ByteSize(value.interleaving_dimension) +
+         yardl::ByteSize(value.multiband);
+}
+
+size_t ByteSize(mrd::EncodingType const& value) {
+  return yardl::ByteSize(value.encoded_space) +
+         yardl::ByteSize(value.recon_space) +
+         yardl::ByteSize(value.encoding_limits) +
+         yardl::ByteSize(value.trajectory) +
+         yardl::ByteSize(value.trajectory_description) +
+         yardl::ByteSize(value.parallel_imaging) +
+         yardl::ByteSize(value.echo_train_length);
+}
+
+size_t ByteSize(mrd::GradientDirectionType const& value) {
+  return yardl::ByteSize(value.rl) +
+         yardl::ByteSize(value.ap) +
+         yardl::ByteSize(value.fh);
+}
+
+size_t ByteSize(mrd::DiffusionType const& value) {
+  return yardl::ByteSize(value.gradient_direction) +
+         yardl::ByteSize(value.bvalue);
+}
+
+size_t ByteSize(mrd::SequenceParametersType const& value) {
+  return yardl::ByteSize(value.t_r) +
+         yardl::ByteSize(value.t_e) +
+         yardl::ByteSize(value.t_i) +
+         yardl::ByteSize(value.flip_angle_deg) +
+         yardl::ByteSize(value.sequence_type) +
+         yardl::ByteSize(value.echo_spacing) +
+         yardl::ByteSize(value.diffusion_dimension) +
+         yardl::ByteSize(value.diffusion) +
+         yardl::ByteSize(value.diffusion_scheme);
+}
+
+size_t ByteSize(mrd::UserParameterBase64Type const& value) {
+  return yardl::ByteSize(value.name) +
+         yardl::ByteSize(value.value);
+}
+
+size_t ByteSize(mrd::UserParametersType const& value) {
+  return yardl::ByteSize(value.user_parameter_long) +
+         yardl::ByteSize(value.user_parameter_double) +
+         yardl::ByteSize(value.user_parameter_string) +
+         yardl::ByteSize(value.user_parameter_base64);
+}
+
+size_t ByteSize(mrd::WaveformInformationType const& value) {
+  return yardl::ByteSize(value.waveform_name) +
+         yardl::ByteSize(value.waveform_type) +
+         yardl::ByteSize(value.user_parameters);
+}
+
+size_t ByteSize(mrd::Header const& value) {
+  return yardl::ByteSize(value.version) +
+         yardl::ByteSize(value.subject_information) +
+         yardl::ByteSize(value.study_information) +
+         yardl::ByteSize(value.measurement_information) +
+         yardl::ByteSize(value.acquisition_system_information) +
+         yardl::ByteSize(value.experimental_conditions) +
+         yardl::ByteSize(value.encoding) +
+         yardl::ByteSize(value.sequence_parameters) +
+         yardl::ByteSize(value.user_parameters) +
+         yardl::ByteSize(value.waveform_information);
+}
+
+size_t ByteSize(mrd::ImageHeader const& value) {
+  return yardl::ByteSize(value.flags) +
+         yardl::ByteSize(value.measurement_uid) +
+         yardl::ByteSize(value.field_of_view) +
+         yardl::ByteSize(value.position) +
+         yardl::ByteSize(value.col_dir) +
+         yardl::ByteSize(value.line_dir) +
+         yardl::ByteSize(value.slice_dir) +
+         yardl::ByteSize(value.patient_table_position) +
+         yardl::ByteSize(value.average) +
+         yardl::ByteSize(value.slice) +
+         yardl::ByteSize(value.contrast) +
+         yardl::ByteSize(value.phase) +
+         yardl::ByteSize(value.repetition) +
+         yardl::ByteSize(value.set) +
+         yardl::ByteSize(value.acquisition_time_stamp_ns) +
+         yardl::ByteSize(value.physiology_time_stamp_ns) +
+         yardl::ByteSize(value.image_type) +
+         yardl::ByteSize(value.image_index) +
+         yardl::ByteSize(value.image_series_index) +
+         yardl::ByteSize(value.user_int) +
+         yardl::ByteSize(value.user_float);
+}
+
+size_t ByteSize(mrd::NoiseCovariance const& value) {
+  return yardl::ByteSize(value.coil_labels) +
+         yardl::ByteSize(value.receiver_noise_bandwidth) +
+         yardl::ByteSize(value.noise_dwell_time_ns) +
+         yardl::ByteSize(value.sample_count) +
+         yardl::ByteSize(value.matrix);
+}
+
+size_t ByteSize(mrd::AcquisitionBucket const& value) {
+  return yardl::ByteSize(value.data) +
+         yardl::ByteSize(value.ref) +
+         yardl::ByteSize(value.datastats) +
+         yardl::ByteSize(value.refstats) +
+         yardl::ByteSize(value.waveforms);
+}
+
+size_t ByteSize(mrd::SamplingLimits const& value) {
+  return yardl::ByteSize(value.kspace_encoding_step_0) +
+         yardl::ByteSize(value.kspace_encoding_step_1) +
+         yardl::ByteSize(value.kspace_encoding_step_2);
+}
+
+size_t ByteSize(mrd::SamplingDescription const& value) {
+  return yardl::ByteSize(value.encoded_fov) +
+         yardl::ByteSize(value.recon_fov) +
+         yardl::ByteSize(value.encoded_matrix) +
+         yardl::ByteSize(value.recon_matrix) +
+         yardl::ByteSize(value.sampling_limits);
+}
+
+size_t ByteSize(mrd::ReconBuffer const& value) {
+  return yardl::ByteSize(value.data) +
+         yardl::ByteSize(value.trajectory) +
+         yardl::ByteSize(value.density) +
+         yardl::ByteSize(value.headers) +
+         yardl::ByteSize(value.sampling);
+}
+
+size_t ByteSize(mrd::ReconAssembly const& value) {
+  return yardl::ByteSize(value.data) +
+         yardl::ByteSize(value.ref);
+}
+
+size_t ByteSize(mrd::ReconData const& value) {
+  return yardl::ByteSize(value.buffers);
+}
+
+size_t ByteSize(mrd::ImageArray const& value) {
+  return yardl::ByteSize(value.data) +
+         yardl::ByteSize(value.headers) +
+         yardl::ByteSize(value.meta) +
+         yardl::ByteSize(value.waveforms);
+}
+
+size_t ByteSize(mrd::PulseqDefinitions const& value) {
+  return yardl::ByteSize(value.gradient_raster_time) +
+         yardl::ByteSize(value.radiofrequency_raster_time) +
+         yardl::ByteSize(value.adc_raster_time) +
+         yardl::ByteSize(value.block_duration_raster) +
+         yardl::ByteSize(value.name) +
+         yardl::ByteSize(value.fov) +
+         yardl::ByteSize(value.total_duration) +
+         yardl::ByteSize(value.custom);
+}
+
+size_t ByteSize(mrd::PulseqBlock const& value) {
+  return yardl::ByteSize(value.id) +
+         yardl::ByteSize(value.duration) +
+         yardl::ByteSize(value.rf) +
+         yardl::ByteSize(value.gx) +
+         yardl::ByteSize(value.gy) +
+         yardl::ByteSize(value.gz) +
+         yardl::ByteSize(value.adc) +
+         yardl::ByteSize(value.ext);
+}
+
+size_t ByteSize(mrd::PulseqRFEvent const& value) {
+  return yardl::ByteSize(value.id) +
+         yardl::ByteSize(value.amp) +
+         yardl::ByteSize(value.mag_id) +
+         yardl::ByteSize(value.phase_id) +
+         yardl::ByteSize(value.time_id) +
+         yardl::ByteSize(value.center) +
+         yardl::ByteSize(value.delay) +
+         yardl::ByteSize(value.freq_ppm) +
+         yardl::ByteSize(value.phase_ppm) +
+         yardl::ByteSize(value.freq_offset) +
+         yardl::ByteSize(value.phase_offset) +
+         yardl::ByteSize(value.use);
+}
+
+size_t ByteSize(mrd::PulseqArbitraryGradient const& value) {
+  return yardl::ByteSize(value.id) +
+         yardl::ByteSize(value.amp) +
+         yardl::ByteSize(value.first) +
+         yardl::ByteSize(value.last) +
+         yardl::ByteSize(value.shape_id) +
+         yardl::ByteSize(value.time_id) +
+         yardl::ByteSize(value.delay);
+}
+
+size_t ByteSize(mrd::PulseqTrapezoidalGradient const& value) {
+  return yardl::ByteSize(value.id) +
+         yardl::ByteSize(value.amp) +
+         yardl::ByteSize(value.rise) +
+         yardl::ByteSize(value.flat) +
+         yardl::ByteSize(value.fall) +
+         yardl::ByteSize(value.delay);
+}
+
+size_t ByteSize(mrd::PulseqADCEvent const& value) {
+  return yardl::ByteSize(value.id) +
+         yardl::ByteSize(value.num) +
+         yardl::ByteSize(value.dwell) +
+         yardl::ByteSize(value.delay) +
+         yardl::ByteSize(value.freq_ppm) +
+         yardl::ByteSize(value.phase_ppm) +
+         yardl::ByteSize(value.freq) +
+         yardl::ByteSize(value.phase) +
+         yardl::ByteSize(value.phase_shape_id);
+}
+
+size_t ByteSize(mrd::PulseqShape const& value) {
+  return yardl::ByteSize(value.id) +
+         yardl::ByteSize(value.num_samples) +
+         yardl::ByteSize(value.data);
+}
+} // namespace yardl
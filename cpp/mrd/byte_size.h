@@ -0,0 +1,223 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include "types.h"
+
+namespace yardl {
+// Returns the number of bytes of heap memory owned by a value, not counting
+// sizeof(value) itself.
+//
+// Types that can own heap memory, such as the record types of a model, need a
+// ByteSize() overload that sums ByteSize() over their fields. Containers find
+// these through argument-dependent lookup, so declare them in the type's
+// namespace or bring them into it with a using-declaration, as done for the
+// Mrd types below. Types that cannot own heap memory, such as numbers, enums
+// and flags, have a ByteSize() of zero.
+//
+// The result is meant for memory budgets: allocator overhead and the
+// bookkeeping of hash maps are estimated rather than measured.
+template <typename T>
+size_t ByteSize(T const& value);
+
+inline size_t ByteSize(std::string const& value);
+
+template <typename T>
+size_t ByteSize(std::optional<T> const& value);
+
+template <typename T>
+size_t ByteSize(std::vector<T> const& value);
+
+template <typename T, size_t N>
+size_t ByteSize(std::array<T, N> const& value);
+
+template <typename... T>
+size_t ByteSize(std::variant<T...> const& value);
+
+template <typename TKey, typename TValue>
+size_t ByteSize(std::unordered_map<TKey, TValue> const& value);
+
+template <typename T, size_t... Dims>
+size_t ByteSize(FixedNDArray<T, Dims...> const& value);
+
+template <typename T, size_t N>
+size_t ByteSize(NDArray<T, N> const& value);
+
+template <typename T>
+size_t ByteSize(DynamicNDArray<T> const& value);
+
+namespace detail {
+// Whether values of type T never own heap memory, so that the elements of
+// containers of T need not be visited.
+template <typename T>
+constexpr bool kOwnsNoHeapMemory = std::is_trivially_copyable_v<T>;
+
+template <typename TIterable>
+size_t ElementsByteSize(TIterable const& values) {
+  using T = std::decay_t<decltype(*std::begin(values))>;
+  size_t total = 0;
+  if constexpr (!kOwnsNoHeapMemory<T>) {
+    for (auto const& v : values) {
+      total += ByteSize(v);
+    }
+  }
+  return total;
+}
+} // namespace detail
+
+template <typename T>
+size_t ByteSize(T const&) {
+  static_assert(std::is_trivially_copyable_v<T>, "No ByteSize() overload for this type");
+  return 0;
+}
+
+inline size_t ByteSize(std::string const& value) {
+  // Short strings are stored inside the std::string object
+  auto data = reinterpret_cast<char const*>(value.data());
+  auto self = reinterpret_cast<char const*>(&value);
+  if (data >= self && data < self + sizeof(value)) {
+    return 0;
+  }
+  return value.capacity() + 1;
+}
+
+template <typename T>
+size_t ByteSize(std::optional<T> const& value) {
+  return value.has_value() ? ByteSize(*value) : 0;
+}
+
+template <typename T>
+size_t ByteSize(std::vector<T> const& value) {
+  return value.capacity() * sizeof(T) + detail::ElementsByteSize(value);
+}
+
+template <typename T, size_t N>
+size_t ByteSize(std::array<T, N> const& value) {
+  return detail::ElementsByteSize(value);
+}
+
+template <typename... T>
+size_t ByteSize(std::variant<T...> const& value) {
+  return std::visit([](auto const& v) { return ByteSize(v); }, value);
+}
+
+template <typename TKey, typename TValue>
+size_t ByteSize(std::unordered_map<TKey, TValue> const& value) {
+  using Map = std::unordered_map<TKey, TValue>;
+  // One pointer per bucket, and per node the entry plus a next pointer and a cached hash
+  size_t total = value.bucket_count() * sizeof(void*) +
+                 value.size() * (sizeof(typename Map::value_type) + sizeof(void*) + sizeof(size_t));
+  for (auto const& [k, v] : value) {
+    total += ByteSize(k) + ByteSize(v);
+  }
+  return total;
+}
+
+template <typename T, size_t... Dims>
+size_t ByteSize(FixedNDArray<T, Dims...> const& value) {
+  return detail::ElementsByteSize(value);
+}
+
+template <typename T, size_t N>
+size_t ByteSize(NDArray<T, N> const& value) {
+  return value.size() * sizeof(T) + detail::ElementsByteSize(value);
+}
+
+template <typename T>
+size_t ByteSize(DynamicNDArray<T> const& value) {
+  return value.size() * sizeof(T) + detail::ElementsByteSize(value);
+}
+} // namespace yardl
+
+// yardl::ByteSize() overloads for the types of the Mrd model. These are written
+// by hand rather than generated, so add an overload here when adding a record
+// type that can own heap memory to the model.
+
+namespace yardl {
+size_t ByteSize(mrd::EncodingCounters const& value);
+size_t ByteSize(mrd::AcquisitionHeader const& value);
+size_t ByteSize(mrd::Acquisition const& value);
+size_t ByteSize(mrd::AcquisitionPrototype const& value);
+size_t ByteSize(mrd::SubjectInformationType const& value);
+size_t ByteSize(mrd::StudyInformationType const& value);
+size_t ByteSize(mrd::ThreeDimensionalFloat const& value);
+size_t ByteSize(mrd::MeasurementDependencyType const& value);
+size_t ByteSize(mrd::ReferencedImageSequenceType const& value);
+size_t ByteSize(mrd::MeasurementInformationType const& value);
+size_t ByteSize(mrd::CoilLabelType const& value);
+size_t ByteSize(mrd::AcquisitionSystemInformationType const& value);
+size_t ByteSize(mrd::ExperimentalConditionsType const& value);
+size_t ByteSize(mrd::MatrixSizeType const& value);
+size_t ByteSize(mrd::FieldOfViewMm const& value);
+size_t ByteSize(mrd::EncodingSpaceType const& value);
+size_t ByteSize(mrd::LimitType const& value);
+size_t ByteSize(mrd::EncodingLimitsType const& value);
+size_t ByteSize(mrd::UserParameterLongType const& value);
+size_t ByteSize(mrd::UserParameterDoubleType const& value);
+size_t ByteSize(mrd::UserParameterStringType const& value);
+size_t ByteSize(mrd::TrajectoryDescriptionType const& value);
+size_t ByteSize(mrd::AccelerationFactorType const& value);
+size_t ByteSize(mrd::MultibandSpacingType const& value);
+size_t ByteSize(mrd::MultibandType const& value);
+size_t ByteSize(mrd::ParallelImagingType const& value);
+size_t ByteSize(mrd::EncodingType const& value);
+size_t ByteSize(mrd::GradientDirectionType const& value);
+size_t ByteSize(mrd::DiffusionType const& value);
+size_t ByteSize(mrd::SequenceParametersType const& value);
+size_t ByteSize(mrd::UserParameterBase64Type const& value);
+size_t ByteSize(mrd::UserParametersType const& value);
+size_t ByteSize(mrd::WaveformInformationType const& value);
+size_t ByteSize(mrd::Header const& value);
+size_t ByteSize(mrd::ImageHeader const& value);
+template <typename T>
+size_t ByteSize(mrd::Image<T> const& value);
+size_t ByteSize(mrd::NoiseCovariance const& value);
+template <typename T>
+size_t ByteSize(mrd::Waveform<T> const& value);
+size_t ByteSize(mrd::AcquisitionBucket const& value);
+size_t ByteSize(mrd::SamplingLimits const& value);
+size_t ByteSize(mrd::SamplingDescription const& value);
+size_t ByteSize(mrd::ReconBuffer const& value);
+size_t ByteSize(mrd::ReconAssembly const& value);
+size_t ByteSize(mrd::ReconData const& value);
+size_t ByteSize(mrd::ImageArray const& value);
+size_t ByteSize(mrd::PulseqDefinitions const& value);
+size_t ByteSize(mrd::PulseqBlock const& value);
+size_t ByteSize(mrd::PulseqRFEvent const& value);
+size_t ByteSize(mrd::PulseqArbitraryGradient const& value);
+size_t ByteSize(mrd::PulseqTrapezoidalGradient const& value);
+size_t ByteSize(mrd::PulseqADCEvent const& value);
+size_t ByteSize(mrd::PulseqShape const& value);
+} // namespace yardl
+
+namespace mrd {
+// The overloads above are found through argument-dependent lookup when
+// yardl::ByteSize() recurses into containers of Mrd types.
+using yardl::ByteSize;
+} // namespace mrd
+
+namespace yardl {
+template <typename T>
+size_t ByteSize(mrd::Image<T> const& value) {
+  return yardl::ByteSize(value.head) +
+         yardl::ByteSize(value.data) +
+         yardl::ByteSize(value.meta);
+}
+
+template <typename T>
+size_t ByteSize(mrd::Waveform<T> const& value) {
+  return yardl::ByteSize(value.flags) +
+         yardl::ByteSize(value.measurement_uid) +
+         yardl::ByteSize(value.scan_counter) +
+         yardl::ByteSize(value.time_stamp_ns) +
+         yardl::ByteSize(value.sample_time_ns) +
+         yardl::ByteSize(value.waveform_id) +
+         yardl::ByteSize(value.data);
+}
+} // namespace yardl
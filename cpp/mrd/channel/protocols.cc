@@ -0,0 +1,252 @@
+#include "protocols.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "../byte_size.h"
+
+namespace mrd::channel {
+
+MrdChannel::MrdChannel(size_t capacity, size_t producers, size_t max_bytes)
+    : producers_(producers), max_bytes_(max_bytes) {
+  if (producers == 0) {
+    throw std::invalid_argument("An MrdChannel must have at least one producer.");
+  }
+
+  if (producers == 1) {
+    spsc_queue_ = std::make_unique<mrd::concurrency::SpscQueue<mrd::StreamItem>>(capacity);
+  } else {
+    mpsc_queue_ = std::make_unique<mrd::concurrency::MpscQueue<mrd::StreamItem>>(capacity);
+  }
+}
+
+size_t MrdChannel::Capacity() const {
+  return spsc_queue_ ? spsc_queue_->Capacity() : mpsc_queue_->Capacity();
+}
+
+void MrdChannel::AttachWriter() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (writers_attached_ == producers_) {
+    throw std::runtime_error("The MrdChannel already has " + std::to_string(producers_) + " writer(s).");
+  }
+  writers_attached_++;
+}
+
+void MrdChannel::AttachReader() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (reader_attached_) {
+    throw std::runtime_error("The MrdChannel already has a reader.");
+  }
+  reader_attached_ = true;
+}
+
+void MrdChannel::WriteHeader(std::optional<mrd::Header> const& value) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (header_) {
+      if (!(*header_ == value)) {
+        throw std::runtime_error("Writers of an MrdChannel must all write the same header.");
+      }
+      return;
+    }
+    header_.emplace(value);
+  }
+  header_written_.notify_all();
+}
+
+void MrdChannel::Push(mrd::StreamItem&& value) {
+  size_t bytes = max_bytes_ != 0 ? sizeof(mrd::StreamItem) + yardl::ByteSize(value) : 0;
+  bool pushed = ReserveBytes(bytes);
+  if (pushed) {
+    pushed = spsc_queue_ ? spsc_queue_->Push(std::move(value)) : mpsc_queue_->Push(std::move(value));
+    if (!pushed) {
+      ReleaseBytes(bytes);
+    }
+  }
+
+  if (!pushed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (reader_detached_) {
+      throw std::runtime_error("The reader of the MrdChannel was closed.");
+    }
+    throw std::runtime_error("The MrdChannel was closed because one of its writers was destroyed before calling EndData().");
+  }
+}
+
+void MrdChannel::EndData() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (++writers_ended_ == producers_) {
+    CloseQueue();
+  }
+}
+
+void MrdChannel::AbandonWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    writer_abandoned_ = true;
+    CloseQueue();
+  }
+  header_written_.notify_all();
+}
+
+void MrdChannel::ReadHeader(std::optional<mrd::Header>& value) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  header_written_.wait(lock, [this] { return header_.has_value() || writer_abandoned_; });
+  if (!header_) {
+    throw std::runtime_error("A writer of the MrdChannel was destroyed before any header was written.");
+  }
+  value = *header_;
+}
+
+bool MrdChannel::Pop(mrd::StreamItem& value) {
+  if (spsc_queue_ ? spsc_queue_->Pop(value) : mpsc_queue_->Pop(value)) {
+    ReleaseBytes(max_bytes_ != 0 ? sizeof(mrd::StreamItem) + yardl::ByteSize(value) : 0);
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (writer_abandoned_) {
+    throw std::runtime_error("A writer of the MrdChannel was destroyed before calling EndData().");
+  }
+  return false;
+}
+
+bool MrdChannel::TryPop(mrd::StreamItem& value) {
+  if (!(spsc_queue_ ? spsc_queue_->TryPop(value) : mpsc_queue_->TryPop(value))) {
+    return false;
+  }
+
+  ReleaseBytes(max_bytes_ != 0 ? sizeof(mrd::StreamItem) + yardl::ByteSize(value) : 0);
+  return true;
+}
+
+void MrdChannel::DetachReader() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  reader_detached_ = true;
+  CloseQueue();
+}
+
+void MrdChannel::CloseQueue() {
+  if (spsc_queue_) {
+    spsc_queue_->Close();
+  } else {
+    mpsc_queue_->Close();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(budget_mutex_);
+    budget_closed_.store(true);
+  }
+  budget_available_.notify_all();
+}
+
+// Blocks until `bytes` fit in the memory budget and reserves them. An item is
+// always admitted when nothing else is reserved, so that items larger than the
+// budget cannot stall the channel. Returns false if the channel was closed.
+bool MrdChannel::ReserveBytes(size_t bytes) {
+  if (max_bytes_ == 0 || TryReserveBytes(bytes)) {
+    return true;
+  }
+
+  std::unique_lock<std::mutex> lock(budget_mutex_);
+  budget_waiters_.fetch_add(1);
+  bool reserved = false;
+  budget_available_.wait(lock, [&] { return (reserved = TryReserveBytes(bytes)) || budget_closed_.load(); });
+  budget_waiters_.fetch_sub(1);
+  return reserved;
+}
+
+bool MrdChannel::TryReserveBytes(size_t bytes) {
+  size_t reserved = bytes_.load();
+  while (reserved == 0 || reserved + bytes <= max_bytes_) {
+    if (bytes_.compare_exchange_weak(reserved, reserved + bytes)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void MrdChannel::ReleaseBytes(size_t bytes) {
+  if (max_bytes_ == 0) {
+    return;
+  }
+
+  bytes_.fetch_sub(bytes);
+  if (budget_waiters_.load() > 0) {
+    std::lock_guard<std::mutex> lock(budget_mutex_);
+    budget_available_.notify_all();
+  }
+}
+
+MrdWriter::MrdWriter(std::shared_ptr<MrdChannel> channel) : channel_(std::move(channel)) {
+  channel_->AttachWriter();
+}
+
+MrdWriter::~MrdWriter() {
+  if (!ended_) {
+    channel_->AbandonWriter();
+  }
+}
+
+void MrdWriter::WriteHeaderImpl(std::optional<mrd::Header> const& value) {
+  channel_->WriteHeader(value);
+}
+
+void MrdWriter::WriteDataImpl(mrd::StreamItem&& value) {
+  channel_->Push(std::move(value));
+}
+
+void MrdWriter::WriteDataImpl(std::vector<mrd::StreamItem>&& values) {
+  for (auto& value : values) {
+    channel_->Push(std::move(value));
+  }
+}
+
+void MrdWriter::EndDataImpl() {
+  channel_->EndData();
+  ended_ = true;
+}
+
+MrdReader::MrdReader(std::shared_ptr<MrdChannel> channel, bool skip_completed_check)
+    : mrd::MrdReaderBase(skip_completed_check), channel_(std::move(channel)) {
+  channel_->AttachReader();
+}
+
+MrdReader::~MrdReader() {
+  channel_->DetachReader();
+}
+
+void MrdReader::ReadHeaderImpl(std::optional<mrd::Header>& value) {
+  channel_->ReadHeader(value);
+}
+
+bool MrdReader::ReadDataImpl(mrd::StreamItem& value) {
+  return channel_->Pop(value);
+}
+
+// Blocks for the first item only, then takes whatever else is already queued,
+// up to the vector's capacity.
+bool MrdReader::ReadDataImpl(std::vector<mrd::StreamItem>& values) {
+  values.clear();
+  values.emplace_back();
+  if (!channel_->Pop(values.back())) {
+    values.clear();
+    return false;
+  }
+
+  while (values.size() < values.capacity()) {
+    values.emplace_back();
+    if (!channel_->TryPop(values.back())) {
+      values.pop_back();
+      break;
+    }
+  }
+  return true;
+}
+
+void MrdReader::CloseImpl() {
+  channel_->DetachReader();
+}
+
+} // namespace mrd::channel
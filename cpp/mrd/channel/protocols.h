@@ -0,0 +1,123 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "../moving_writer.h"
+#include "../concurrency/ring_queue.h"
+
+namespace mrd::channel {
+// An in-memory connection between MrdWriters and an MrdReader running on
+// different threads of the same process. Items written to the `data` stream
+// are moved through a bounded lock-free queue and come out of the reader as
+// the same objects, with no encoding or decoding.
+//
+// A channel has one reader and `producers` writers. With a single producer
+// the queue is single-producer/single-consumer; with several, any number of
+// writers can write concurrently and the reader receives the union of their
+// items in the order they were enqueued. Each writer goes through the usual
+// WriteHeader() -> WriteData() -> EndData() sequence; all writers must write
+// the same header, and the reader's `data` stream ends once every writer has
+// called EndData().
+//
+// Writers block while the queue holds `capacity` items, or, if `max_bytes` is
+// not zero, items with a total in-memory size (see yardl::ByteSize()) of more
+// than `max_bytes`, so a slow reader applies backpressure to its writers.
+class MrdChannel {
+  public:
+  explicit MrdChannel(size_t capacity = 64, size_t producers = 1, size_t max_bytes = 0);
+
+  MrdChannel(MrdChannel const&) = delete;
+  MrdChannel& operator=(MrdChannel const&) = delete;
+
+  size_t Capacity() const;
+  size_t Producers() const { return producers_; }
+  size_t MaxBytes() const { return max_bytes_; }
+
+  private:
+  void AttachWriter();
+  void AttachReader();
+  void WriteHeader(std::optional<mrd::Header> const& value);
+  void Push(mrd::StreamItem&& value);
+  void EndData();
+  void AbandonWriter();
+  void ReadHeader(std::optional<mrd::Header>& value);
+  bool Pop(mrd::StreamItem& value);
+  bool TryPop(mrd::StreamItem& value);
+  void DetachReader();
+  void CloseQueue();
+  bool ReserveBytes(size_t bytes);
+  bool TryReserveBytes(size_t bytes);
+  void ReleaseBytes(size_t bytes);
+
+  size_t const producers_;
+  size_t const max_bytes_;
+  std::unique_ptr<mrd::concurrency::SpscQueue<mrd::StreamItem>> spsc_queue_;
+  std::unique_ptr<mrd::concurrency::MpscQueue<mrd::StreamItem>> mpsc_queue_;
+
+  std::mutex mutex_;
+  std::condition_variable header_written_;
+  std::optional<std::optional<mrd::Header>> header_;
+  size_t writers_attached_ = 0;
+  size_t writers_ended_ = 0;
+  bool reader_attached_ = false;
+  bool reader_detached_ = false;
+  bool writer_abandoned_ = false;
+
+  // The memory budget, used only when max_bytes_ is not zero. Bytes are
+  // reserved and released with atomic operations; the mutex and condition
+  // variable are only used by writers waiting for the budget to free up.
+  std::atomic<size_t> bytes_{0};
+  std::atomic<size_t> budget_waiters_{0};
+  std::atomic<bool> budget_closed_{false};
+  std::mutex budget_mutex_;
+  std::condition_variable budget_available_;
+
+  friend class MrdWriter;
+  friend class MrdReader;
+};
+
+// In-memory writer for the Mrd protocol, connected to an MrdReader through an MrdChannel.
+// Data items passed as rvalues are moved into the channel; others are copied.
+// Destroying the writer before EndData() makes the reader fail once it has
+// received the items written so far.
+class MrdWriter : public mrd::MrdMovingWriterBase {
+  public:
+  MrdWriter(std::shared_ptr<MrdChannel> channel);
+  ~MrdWriter() override;
+
+  protected:
+  void WriteHeaderImpl(std::optional<mrd::Header> const& value) override;
+  void WriteDataImpl(mrd::StreamItem&& value) override;
+  void WriteDataImpl(std::vector<mrd::StreamItem>&& values) override;
+  void EndDataImpl() override;
+
+  private:
+  std::shared_ptr<MrdChannel> channel_;
+  bool ended_ = false;
+};
+
+// In-memory reader for the Mrd protocol, receiving the items written to an MrdChannel.
+// ReadHeader() blocks until a writer has written the header, and ReadData()
+// until an item is available. Destroying the reader makes pending and
+// subsequent writes fail.
+class MrdReader : public mrd::MrdReaderBase {
+  public:
+  MrdReader(std::shared_ptr<MrdChannel> channel, bool skip_completed_check = false);
+  ~MrdReader() override;
+
+  protected:
+  void ReadHeaderImpl(std::optional<mrd::Header>& value) override;
+  bool ReadDataImpl(mrd::StreamItem& value) override;
+  bool ReadDataImpl(std::vector<mrd::StreamItem>& values) override;
+  void CloseImpl() override;
+
+  private:
+  std::shared_ptr<MrdChannel> channel_;
+};
+
+} // namespace mrd::channel
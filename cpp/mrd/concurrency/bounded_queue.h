@@ -0,0 +1,175 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace mrd::concurrency {
+// A blocking first-in-first-out queue holding at most `capacity` items,
+// for handing items from one thread to another. Items are moved in and
+// out, never copied.
+//
+// Optionally, the queue also holds at most `max_bytes` bytes, as given
+// by producers for each item. An empty queue accepts any one item, so
+// that an item larger than `max_bytes` cannot stall the queue.
+//
+// Producers call Close() when they are done; consumers then drain the
+// remaining items. Cancel() stops both sides immediately, discarding
+// any queued items.
+template <typename T>
+class BoundedQueue {
+  public:
+  using Duration = std::chrono::steady_clock::duration;
+
+  explicit BoundedQueue(size_t capacity, size_t max_bytes = 0)
+      : capacity_(capacity), max_bytes_(max_bytes) {
+    if (capacity == 0) {
+      throw std::invalid_argument("BoundedQueue capacity must be greater than zero.");
+    }
+  }
+
+  BoundedQueue(BoundedQueue const&) = delete;
+  BoundedQueue& operator=(BoundedQueue const&) = delete;
+
+  // Blocks until there is room for the item, then enqueues it.
+  // Returns false, leaving `item` untouched, if the queue was closed or
+  // cancelled.
+  bool Push(T&& item, size_t bytes = 0) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!HasRoomFor(bytes) && !closed_) {
+      auto start = std::chrono::steady_clock::now();
+      not_full_.wait(lock, [&] { return HasRoomFor(bytes) || closed_; });
+      push_wait_time_ += std::chrono::steady_clock::now() - start;
+    }
+
+    if (closed_) {
+      return false;
+    }
+
+    items_.emplace_back(std::move(item), bytes);
+    bytes_ += bytes;
+    lock.unlock();
+    not_empty_.notify_one();
+    return true;
+  }
+
+  // Enqueues the item if there is room for it, without blocking.
+  // Returns false, leaving `item` untouched, if the queue is full or closed.
+  bool TryPush(T&& item, size_t bytes = 0) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (closed_ || !HasRoomFor(bytes)) {
+      return false;
+    }
+
+    items_.emplace_back(std::move(item), bytes);
+    bytes_ += bytes;
+    lock.unlock();
+    not_empty_.notify_one();
+    return true;
+  }
+
+  // Blocks until an item is available and moves it into `item`.
+  // Returns false once the queue is closed and empty, or cancelled.
+  bool Pop(T& item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (items_.empty() && !closed_) {
+      auto start = std::chrono::steady_clock::now();
+      not_empty_.wait(lock, [this] { return !items_.empty() || closed_; });
+      pop_wait_time_ += std::chrono::steady_clock::now() - start;
+    }
+
+    if (items_.empty()) {
+      return false;
+    }
+
+    PopFront(item, lock);
+    return true;
+  }
+
+  // Moves the next item into `item` if one is queued, without blocking.
+  bool TryPop(T& item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (items_.empty()) {
+      return false;
+    }
+
+    PopFront(item, lock);
+    return true;
+  }
+
+  // Rejects further pushes. Items already queued can still be popped.
+  void Close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+    }
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+  // Closes the queue and discards the items in it.
+  void Cancel() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+      items_.clear();
+      bytes_ = 0;
+    }
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+  size_t Capacity() const { return capacity_; }
+
+  size_t MaxBytes() const { return max_bytes_; }
+
+  // Total bytes of the items currently queued.
+  size_t Bytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bytes_;
+  }
+
+  // Total time producers spent blocked because the queue was full.
+  Duration PushWaitTime() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return push_wait_time_;
+  }
+
+  // Total time consumers spent blocked because the queue was empty.
+  Duration PopWaitTime() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pop_wait_time_;
+  }
+
+  private:
+  void PopFront(T& item, std::unique_lock<std::mutex>& lock) {
+    item = std::move(items_.front().first);
+    bytes_ -= items_.front().second;
+    items_.pop_front();
+    lock.unlock();
+    not_full_.notify_one();
+  }
+
+  bool HasRoomFor(size_t bytes) const {
+    if (items_.empty()) {
+      return true;
+    }
+    return items_.size() < capacity_ && (max_bytes_ == 0 || bytes_ + bytes <= max_bytes_);
+  }
+
+  size_t const capacity_;
+  size_t const max_bytes_;
+  mutable std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+  std::deque<std::pair<T, size_t>> items_;
+  size_t bytes_ = 0;
+  bool closed_ = false;
+  Duration push_wait_time_{};
+  Duration pop_wait_time_{};
+};
+
+} // namespace mrd::concurrency
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace mrd::concurrency {
+// A bounded, lock-free first-in-first-out ring buffer for handing items
+// from producer threads to a single consumer thread. Items are moved in
+// and out, never copied.
+//
+// With `kMultiProducer` false, only one thread may push at a time (SPSC);
+// otherwise any number of threads may push concurrently (MPSC). In both
+// cases only one thread may pop.
+//
+// TryPush() and TryPop() never block. Push() and Pop() spin briefly when
+// the queue is full or empty and then sleep until the other side makes
+// progress, so a slow consumer applies backpressure to its producers.
+// The sleeping slow path is the only place a mutex is taken.
+//
+// Producers call Close() when they are done; the consumer then drains the
+// remaining items. Close() also releases producers blocked in Push().
+template <typename T, bool kMultiProducer>
+class RingQueue {
+  public:
+  explicit RingQueue(size_t capacity) {
+    if (capacity == 0) {
+      throw std::invalid_argument("RingQueue capacity must be greater than zero.");
+    }
+
+    size_t slot_count = 1;
+    while (slot_count < capacity) {
+      slot_count <<= 1;
+    }
+
+    slots_ = std::make_unique<Slot[]>(slot_count);
+    mask_ = slot_count - 1;
+    for (size_t i = 0; i < slot_count; i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  RingQueue(RingQueue const&) = delete;
+  RingQueue& operator=(RingQueue const&) = delete;
+
+  // Enqueues the item if there is room for it. Returns false, leaving
+  // `item` untouched, if the queue is full or closed.
+  bool TryPush(T&& item) {
+    if (closed_.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    size_t position = tail_.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+      slot = &slots_[position & mask_];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+      if (diff < 0) {
+        return false;
+      }
+
+      if (diff == 0) {
+        if constexpr (kMultiProducer) {
+          if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+            break;
+          }
+        } else {
+          tail_.store(position + 1, std::memory_order_relaxed);
+          break;
+        }
+      } else {
+        position = tail_.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->value.emplace(std::move(item));
+    slot->sequence.store(position + 1, std::memory_order_release);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_waiting_.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      not_empty_.notify_one();
+    }
+
+    return true;
+  }
+
+  // Blocks until there is room for the item, then enqueues it.
+  // Returns false, leaving `item` untouched, if the queue was closed.
+  bool Push(T&& item) {
+    for (int i = 0; i < kSpinCount; i++) {
+      if (TryPush(std::move(item))) {
+        return true;
+      }
+      if (closed_.load(std::memory_order_acquire)) {
+        return false;
+      }
+      std::this_thread::yield();
+    }
+
+    while (!TryPush(std::move(item))) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      producers_waiting_.fetch_add(1, std::memory_order_seq_cst);
+      not_full_.wait(lock, [this] { return !Full() || closed_.load(std::memory_order_seq_cst); });
+      producers_waiting_.fetch_sub(1, std::memory_order_relaxed);
+      if (closed_.load(std::memory_order_acquire)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // Moves the next item into `item` if one is available.
+  // Must only be called from the consumer thread.
+  bool TryPop(T& item) {
+    size_t position = head_.load(std::memory_order_relaxed);
+    Slot& slot = slots_[position & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+      return false;
+    }
+
+    item = std::move(*slot.value);
+    slot.value.reset();
+    slot.sequence.store(position + mask_ + 1, std::memory_order_release);
+    head_.store(position + 1, std::memory_order_release);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (producers_waiting_.load(std::memory_order_relaxed) > 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      not_full_.notify_all();
+    }
+
+    return true;
+  }
+
+  // Blocks until an item is available and moves it into `item`.
+  // Returns false once the queue is closed and empty.
+  // Must only be called from the consumer thread.
+  bool Pop(T& item) {
+    for (int i = 0; i < kSpinCount; i++) {
+      if (TryPop(item)) {
+        return true;
+      }
+      if (Drained()) {
+        return false;
+      }
+      std::this_thread::yield();
+    }
+
+    while (!TryPop(item)) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      consumer_waiting_.store(true, std::memory_order_seq_cst);
+      not_empty_.wait(lock, [this] { return Available() || Drained(); });
+      consumer_waiting_.store(false, std::memory_order_relaxed);
+      if (!Available()) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // Rejects further pushes. Items already queued can still be popped.
+  void Close() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_.store(true, std::memory_order_seq_cst);
+    }
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+  bool IsClosed() const { return closed_.load(std::memory_order_acquire); }
+
+  size_t Capacity() const { return mask_ + 1; }
+
+  private:
+  static constexpr int kSpinCount = 64;
+
+  struct Slot {
+    std::atomic<size_t> sequence;
+    std::optional<T> value;
+  };
+
+  bool Full() const {
+    return tail_.load(std::memory_order_seq_cst) - head_.load(std::memory_order_seq_cst) > mask_;
+  }
+
+  bool Available() const {
+    size_t position = head_.load(std::memory_order_relaxed);
+    return slots_[position & mask_].sequence.load(std::memory_order_seq_cst) == position + 1;
+  }
+
+  // Closed, and every claimed slot has been consumed.
+  bool Drained() const {
+    return closed_.load(std::memory_order_seq_cst) &&
+           tail_.load(std::memory_order_seq_cst) == head_.load(std::memory_order_relaxed);
+  }
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_;
+
+  // Producer and consumer positions live on separate cache lines.
+  alignas(64) std::atomic<size_t> tail_{0};
+  alignas(64) std::atomic<size_t> head_{0};
+
+  alignas(64) std::atomic<bool> closed_{false};
+  std::atomic<bool> consumer_waiting_{false};
+  std::atomic<int> producers_waiting_{0};
+  std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable not_empty_;
+};
+
+template <typename T>
+using SpscQueue = RingQueue<T, false>;
+
+template <typename T>
+using MpscQueue = RingQueue<T, true>;
+} // namespace mrd::concurrency
@@ -0,0 +1,131 @@
+#pragma once
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 202002L && __has_include(<ranges>)
+#include <ranges>
+#endif
+
+#include "data_visitor.h"
+
+namespace mrd {
+#ifdef __cpp_lib_ranges
+using MrdDataRangeBase = std::ranges::view_base;
+#else
+struct MrdDataRangeBase {};
+#endif
+
+// A single-pass input range over the `data` stream of an MrdReaderBase, holding the current item.
+// The reader's position and the current item are held on the heap, so iterators stay valid when
+// the range is moved or copied, for example into a std::views pipeline, and copies share them.
+// See mrd::Data().
+template <typename T>
+class MrdDataRange : public MrdDataRangeBase {
+  struct State;
+
+  public:
+  struct sentinel {};
+
+  class iterator {
+    public:
+    using iterator_concept = std::input_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    iterator() = default;
+    explicit iterator(State* state) : state_(state) {}
+
+    T& operator*() const { return state_->current; }
+    T* operator->() const { return &state_->current; }
+
+    iterator& operator++() {
+      state_->Advance();
+      return *this;
+    }
+
+    void operator++(int) { ++*this; }
+
+    friend bool operator==(iterator const& it, sentinel) { return it.AtEnd(); }
+    friend bool operator==(sentinel s, iterator const& it) { return it == s; }
+    friend bool operator!=(iterator const& it, sentinel s) { return !(it == s); }
+    friend bool operator!=(sentinel s, iterator const& it) { return !(it == s); }
+
+    private:
+    bool AtEnd() const { return state_->done; }
+
+    State* state_ = nullptr;
+  };
+
+  MrdDataRange() = default;
+  explicit MrdDataRange(MrdReaderBase& reader) : state_(std::make_shared<State>(reader)) {}
+
+  // The first call reads the first item.
+  iterator begin() {
+    if (!state_->started) {
+      state_->started = true;
+      state_->Advance();
+    }
+    return iterator(state_.get());
+  }
+
+  sentinel end() const { return {}; }
+
+  private:
+  struct State {
+    explicit State(MrdReaderBase& reader) : reader(&reader) {}
+
+    void Advance() {
+      if constexpr (std::is_same_v<T, mrd::StreamItem>) {
+        done = !reader->ReadData(current);
+      } else {
+        bool found = false;
+        while (!found) {
+          if (!mrd::ReadData(*reader, [this, &found](T&& value) {
+                current = std::move(value);
+                found = true;
+              })) {
+            done = true;
+            return;
+          }
+        }
+      }
+    }
+
+    MrdReaderBase* reader;
+    T current{};
+    bool started = false;
+    bool done = false;
+  };
+
+  std::shared_ptr<State> state_;
+};
+
+namespace detail {
+template <typename T, typename... Ts>
+constexpr bool IsAlternative(std::variant<Ts...> const*) {
+  return (std::is_same_v<T, Ts> || ...);
+}
+} // namespace detail
+
+// Returns a lazy, single-pass range over the `data` stream of `reader`. Each item is read when the
+// range's iterator is advanced, and can be moved out of the range. With T set to one of the
+// mrd::StreamItem alternatives, the range yields only items of that type; others are skipped, and
+// readers derived from MrdVisitingReaderBase skip them without decoding them. In C++20 the range
+// is a std::ranges::view, for example:
+//   for (mrd::Acquisition& acq : mrd::Data<mrd::Acquisition>(reader) | std::views::filter(is_imaging)) {
+//     ...
+//   }
+template <typename T = mrd::StreamItem>
+MrdDataRange<T> Data(MrdReaderBase& reader) {
+  static_assert(std::is_same_v<T, mrd::StreamItem> || detail::IsAlternative<T>(static_cast<mrd::StreamItem const*>(nullptr)),
+                "T must be mrd::StreamItem or one of its alternatives");
+  return MrdDataRange<T>(reader);
+}
+
+} // namespace mrd
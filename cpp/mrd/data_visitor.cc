@@ -0,0 +1,42 @@
+#include "data_visitor.h"
+
+#include <variant>
+
+namespace mrd {
+
+bool MrdVisitingReaderBase::ReadData(MrdDataVisitor& visitor) {
+  visitor_ = &visitor;
+  try {
+    bool result = MrdReaderBase::ReadData(unused_);
+    visitor_ = nullptr;
+    return result;
+  } catch (...) {
+    visitor_ = nullptr;
+    throw;
+  }
+}
+
+bool MrdVisitingReaderBase::ReadDataImpl(mrd::StreamItem& value) {
+  if (visitor_ != nullptr) {
+    return ReadItemImpl(*visitor_);
+  }
+  return ReadItemImpl(value);
+}
+
+bool ReadData(MrdReaderBase& reader, MrdDataVisitor& visitor) {
+  if (auto visiting_reader = dynamic_cast<MrdVisitingReaderBase*>(&reader)) {
+    return visiting_reader->ReadData(visitor);
+  }
+
+  mrd::StreamItem value;
+  if (!reader.ReadData(value)) {
+    return false;
+  }
+
+  if (visitor.Handles(value.index())) {
+    std::visit([&visitor](auto& v) { visitor.Visit(std::move(v)); }, value);
+  }
+  return true;
+}
+
+} // namespace mrd
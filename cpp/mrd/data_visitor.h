@@ -0,0 +1,159 @@
+#pragma once
+#include <array>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "protocols.h"
+
+namespace mrd {
+// Receives items of the `data` stream of the Mrd protocol directly from a reader,
+// without an intermediate mrd::StreamItem. See mrd::ReadData(MrdReaderBase&, MrdDataVisitor&).
+class MrdDataVisitor {
+  public:
+  virtual ~MrdDataVisitor() = default;
+
+  // Whether items of the mrd::StreamItem alternative with the given index are handled.
+  // Items of unhandled alternatives are skipped.
+  virtual bool Handles(size_t index) const = 0;
+
+  virtual void Visit(mrd::Acquisition&&) {}
+  virtual void Visit(mrd::AcquisitionPrototype&&) {}
+  virtual void Visit(mrd::WaveformUint32&&) {}
+  virtual void Visit(mrd::ImageUint16&&) {}
+  virtual void Visit(mrd::ImageInt16&&) {}
+  virtual void Visit(mrd::ImageUint32&&) {}
+  virtual void Visit(mrd::ImageInt32&&) {}
+  virtual void Visit(mrd::ImageFloat&&) {}
+  virtual void Visit(mrd::ImageDouble&&) {}
+  virtual void Visit(mrd::ImageComplexFloat&&) {}
+  virtual void Visit(mrd::ImageComplexDouble&&) {}
+  virtual void Visit(mrd::AcquisitionBucket&&) {}
+  virtual void Visit(mrd::ReconData&&) {}
+  virtual void Visit(mrd::ArrayComplexFloat&&) {}
+  virtual void Visit(mrd::ImageArray&&) {}
+  virtual void Visit(mrd::PulseqDefinitions&&) {}
+  virtual void Visit(std::vector<mrd::PulseqBlock>&&) {}
+  virtual void Visit(mrd::PulseqRFEvent&&) {}
+  virtual void Visit(mrd::PulseqArbitraryGradient&&) {}
+  virtual void Visit(mrd::PulseqTrapezoidalGradient&&) {}
+  virtual void Visit(mrd::PulseqADCEvent&&) {}
+  virtual void Visit(mrd::PulseqShape&&) {}
+};
+
+// Base of readers for the Mrd protocol that can decode items of the `data`
+// stream straight into an MrdDataVisitor, and skip the items it does not
+// handle without decoding them.
+class MrdVisitingReaderBase : public MrdReaderBase {
+  public:
+  using MrdReaderBase::MrdReaderBase;
+  using MrdReaderBase::ReadData;
+
+  // Reads the next item of the `data` stream and moves it into the matching Visit() overload,
+  // or skips it if the visitor does not handle its type. Returns false when the stream has ended.
+  [[nodiscard]] bool ReadData(MrdDataVisitor& visitor);
+
+  protected:
+  bool ReadDataImpl(mrd::StreamItem& value) final;
+
+  // Reads the next item into `value`.
+  virtual bool ReadItemImpl(mrd::StreamItem& value) = 0;
+
+  // Reads the next item into `visitor`.
+  virtual bool ReadItemImpl(MrdDataVisitor& visitor) = 0;
+
+  private:
+  // The visitor of the ReadData() call in progress, which reaches ReadDataImpl()
+  // through the state checks of MrdReaderBase::ReadData().
+  MrdDataVisitor* visitor_ = nullptr;
+  mrd::StreamItem unused_;
+};
+
+// Combines callables, typically lambdas, into one callable with their
+// overloads, e.g. to pass per-type handlers to mrd::ReadData().
+template <typename... Ts>
+struct Overloaded : Ts... {
+  using Ts::operator()...;
+};
+
+template <typename... Ts>
+Overloaded(Ts...) -> Overloaded<Ts...>;
+
+// Adapts a callable with per-type overloads to MrdDataVisitor.
+template <typename Visitor>
+class MrdDataCallableVisitor : public MrdDataVisitor {
+  public:
+  MrdDataCallableVisitor(Visitor& visitor) : visitor_(visitor) {}
+
+  bool Handles(size_t index) const override {
+    constexpr auto handled = HandledAlternatives(std::make_index_sequence<std::variant_size_v<mrd::StreamItem>>{});
+    return index < handled.size() && handled[index];
+  }
+
+  void Visit(mrd::Acquisition&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::AcquisitionPrototype&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::WaveformUint32&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::ImageUint16&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::ImageInt16&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::ImageUint32&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::ImageInt32&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::ImageFloat&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::ImageDouble&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::ImageComplexFloat&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::ImageComplexDouble&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::AcquisitionBucket&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::ReconData&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::ArrayComplexFloat&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::ImageArray&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::PulseqDefinitions&& value) override { Dispatch(std::move(value)); }
+  void Visit(std::vector<mrd::PulseqBlock>&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::PulseqRFEvent&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::PulseqArbitraryGradient&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::PulseqTrapezoidalGradient&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::PulseqADCEvent&& value) override { Dispatch(std::move(value)); }
+  void Visit(mrd::PulseqShape&& value) override { Dispatch(std::move(value)); }
+
+  private:
+  template <typename T>
+  static constexpr bool IsHandled() {
+    return std::is_invocable_v<Visitor&, T&&> || std::is_invocable_v<Visitor&, T&>;
+  }
+
+  template <size_t... I>
+  static constexpr std::array<bool, sizeof...(I)> HandledAlternatives(std::index_sequence<I...>) {
+    return {IsHandled<std::variant_alternative_t<I, mrd::StreamItem>>()...};
+  }
+
+  template <typename T>
+  void Dispatch(T&& value) {
+    if constexpr (std::is_invocable_v<Visitor&, T&&>) {
+      std::invoke(visitor_, std::move(value));
+    } else if constexpr (std::is_invocable_v<Visitor&, T&>) {
+      std::invoke(visitor_, value);
+    }
+  }
+
+  Visitor& visitor_;
+};
+
+// Reads the next item of the `data` stream of `reader` and moves it into the matching Visit()
+// overload, or skips it if the visitor does not handle its type. Returns false when the stream has
+// ended. Readers derived from MrdVisitingReaderBase decode the item directly; others read an
+// mrd::StreamItem first.
+[[nodiscard]] bool ReadData(MrdReaderBase& reader, MrdDataVisitor& visitor);
+
+// Like ReadData(MrdReaderBase&, MrdDataVisitor&), taking a callable with overloads for the item
+// types to handle. Each item is passed as an rvalue, so handlers can take it by value, by const
+// reference or by rvalue reference; handlers taking a non-const lvalue reference are also
+// supported. For example:
+//   while (mrd::ReadData(reader, mrd::Overloaded{
+//       [&](mrd::Acquisition&& acq) { ... },
+//       [&](mrd::ImageFloat const& image) { ... }})) {
+//   }
+template <typename Visitor, std::enable_if_t<!std::is_base_of_v<MrdDataVisitor, std::decay_t<Visitor>>, bool> = true>
+[[nodiscard]] bool ReadData(MrdReaderBase& reader, Visitor&& visitor) {
+  MrdDataCallableVisitor<std::remove_reference_t<Visitor>> adapter(visitor);
+  return ReadData(reader, static_cast<MrdDataVisitor&>(adapter));
+}
+
+} // namespace mrd
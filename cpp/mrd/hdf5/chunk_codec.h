@@ -0,0 +1,273 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <H5Cpp.h>
+#include <zlib.h>
+
+#ifdef MRD_HDF5_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+// Compression and decompression of dataset chunks outside of HDF5's filter
+// pipeline, so that chunks can be encoded on several threads and written
+// with H5Dwrite_chunk, or read with H5Dread_chunk and decoded on several
+// threads. Chunks are encoded exactly as HDF5's shuffle and deflate filters,
+// and the registered zstd filter, would encode them, so files can be read
+// with or without this code.
+namespace mrd::hdf5 {
+
+enum class Compression {
+  kNone,
+  kDeflate,
+  // Requires building with zstd (MRD_HDF5_HAVE_ZSTD). Other HDF5
+  // applications need the zstd filter plugin to read the data.
+  kZstd,
+};
+
+// The registered HDF5 filter ID of zstd.
+static constexpr H5Z_filter_t kZstdFilterId = 32015;
+
+/**
+ * The filters of a chunked dataset, in pipeline order.
+ */
+struct ChunkFilters {
+  bool shuffle{};
+  Compression compression{Compression::kNone};
+  int level{};
+
+  /**
+   * Returns the filters of a dataset, or nothing if it uses filters that
+   * cannot be applied outside of HDF5's filter pipeline.
+   */
+  static std::optional<ChunkFilters> FromDataset(H5::DSetCreatPropList const& properties) {
+    ChunkFilters filters;
+    int count = properties.getNfilters();
+    for (int i = 0; i < count; i++) {
+      unsigned int flags;
+      size_t cd_count = 8;
+      unsigned int cd_values[8];
+      char name[64];
+      unsigned int config;
+      H5Z_filter_t id = properties.getFilter(i, flags, cd_count, cd_values, sizeof(name), name, config);
+      if (id == H5Z_FILTER_SHUFFLE && i == 0) {
+        filters.shuffle = true;
+      } else if (id == H5Z_FILTER_DEFLATE && filters.compression == Compression::kNone) {
+        filters.compression = Compression::kDeflate;
+#ifdef MRD_HDF5_HAVE_ZSTD
+      } else if (id == kZstdFilterId && filters.compression == Compression::kNone) {
+        filters.compression = Compression::kZstd;
+#endif
+      } else {
+        return std::nullopt;
+      }
+    }
+    return filters;
+  }
+
+  // Adds the filters to a dataset's creation properties.
+  void Apply(H5::DSetCreatPropList& properties) const {
+    if (shuffle) {
+      properties.setShuffle();
+    }
+    if (compression == Compression::kDeflate) {
+      properties.setDeflate(static_cast<unsigned int>(level));
+    } else if (compression == Compression::kZstd) {
+      unsigned int cd_value = static_cast<unsigned int>(level);
+      properties.setFilter(kZstdFilterId, H5Z_FLAG_OPTIONAL, 1, &cd_value);
+    }
+  }
+
+  // The number of filters in the pipeline.
+  int Count() const {
+    return (shuffle ? 1 : 0) + (compression != Compression::kNone ? 1 : 0);
+  }
+
+  /**
+   * Encodes a chunk of elements of `element_size` bytes. The result is to be
+   * written with a filter mask of 0.
+   */
+  std::vector<uint8_t> Encode(std::vector<uint8_t> const& chunk, size_t element_size) const {
+    std::vector<uint8_t> shuffled;
+    if (shuffle) {
+      shuffled.resize(chunk.size());
+      Shuffle(chunk.data(), shuffled.data(), chunk.size(), element_size);
+    }
+    std::vector<uint8_t> const& input = shuffle ? shuffled : chunk;
+
+    switch (compression) {
+      case Compression::kNone:
+        return input;
+      case Compression::kDeflate: {
+        uLongf size = compressBound(static_cast<uLong>(input.size()));
+        std::vector<uint8_t> output(size);
+        if (compress2(output.data(), &size, input.data(), static_cast<uLong>(input.size()), level) != Z_OK) {
+          throw std::runtime_error("Failed to deflate an HDF5 chunk.");
+        }
+        output.resize(size);
+        return output;
+      }
+      case Compression::kZstd: {
+#ifdef MRD_HDF5_HAVE_ZSTD
+        std::vector<uint8_t> output(ZSTD_compressBound(input.size()));
+        size_t size = ZSTD_compress(output.data(), output.size(), input.data(), input.size(), level);
+        if (ZSTD_isError(size)) {
+          throw std::runtime_error(std::string("Failed to compress an HDF5 chunk with zstd: ") + ZSTD_getErrorName(size));
+        }
+        output.resize(size);
+        return output;
+#else
+        break;
+#endif
+      }
+    }
+    throw std::invalid_argument("zstd compression is not available in this build.");
+  }
+
+  /**
+   * Decodes a chunk read with the given filter mask into `chunk_bytes` bytes.
+   */
+  std::vector<uint8_t> Decode(std::vector<uint8_t> const& encoded, uint32_t filter_mask,
+                              size_t chunk_bytes, size_t element_size) const {
+    int filter = Count() - 1;
+    std::vector<uint8_t> decompressed;
+    bool skip_compression = compression == Compression::kNone || (filter_mask & (1u << filter)) != 0;
+    if (!skip_compression) {
+      decompressed.resize(chunk_bytes);
+      if (compression == Compression::kDeflate) {
+        uLongf size = static_cast<uLongf>(chunk_bytes);
+        if (uncompress(decompressed.data(), &size, encoded.data(), static_cast<uLong>(encoded.size())) != Z_OK ||
+            size != chunk_bytes) {
+          throw std::runtime_error("Failed to inflate an HDF5 chunk.");
+        }
+      } else {
+#ifdef MRD_HDF5_HAVE_ZSTD
+        size_t size = ZSTD_decompress(decompressed.data(), chunk_bytes, encoded.data(), encoded.size());
+        if (ZSTD_isError(size) || size != chunk_bytes) {
+          throw std::runtime_error("Failed to decompress an HDF5 chunk with zstd.");
+        }
+#endif
+      }
+    }
+    std::vector<uint8_t> const& input = skip_compression ? encoded : decompressed;
+    if (input.size() != chunk_bytes) {
+      throw std::runtime_error("An HDF5 chunk has an unexpected size.");
+    }
+
+    if (!shuffle || (filter_mask & 1u) != 0) {
+      return input;
+    }
+    std::vector<uint8_t> output(chunk_bytes);
+    Unshuffle(input.data(), output.data(), chunk_bytes, element_size);
+    return output;
+  }
+
+  // Groups the i-th bytes of all elements together, as HDF5's shuffle filter.
+  static void Shuffle(uint8_t const* input, uint8_t* output, size_t size, size_t element_size) {
+    size_t count = size / element_size;
+    for (size_t b = 0; b < element_size; b++) {
+      uint8_t* out = output + b * count;
+      for (size_t i = 0; i < count; i++) {
+        out[i] = input[i * element_size + b];
+      }
+    }
+    std::memcpy(output + count * element_size, input + count * element_size, size - count * element_size);
+  }
+
+  static void Unshuffle(uint8_t const* input, uint8_t* output, size_t size, size_t element_size) {
+    size_t count = size / element_size;
+    for (size_t b = 0; b < element_size; b++) {
+      uint8_t const* in = input + b * count;
+      for (size_t i = 0; i < count; i++) {
+        output[i * element_size + b] = in[i];
+      }
+    }
+    std::memcpy(output + count * element_size, input + count * element_size, size - count * element_size);
+  }
+};
+
+/**
+ * A pool of threads encoding and decoding chunks, shared by all HDF5 writers
+ * and readers of the process.
+ */
+class ChunkCodecPool {
+  public:
+  static ChunkCodecPool& Shared() {
+    static ChunkCodecPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    return pool;
+  }
+
+  explicit ChunkCodecPool(size_t threads) {
+    for (size_t i = 0; i < threads; i++) {
+      threads_.emplace_back([this] { Run(); });
+    }
+  }
+
+  ChunkCodecPool(ChunkCodecPool const&) = delete;
+  ChunkCodecPool& operator=(ChunkCodecPool const&) = delete;
+
+  ~ChunkCodecPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    available_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  size_t Size() const {
+    return threads_.size();
+  }
+
+  template <typename F>
+  std::future<std::invoke_result_t<F>> Submit(F&& f) {
+    auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(f));
+    auto result = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.emplace_back([task] { (*task)(); });
+    }
+    available_.notify_one();
+    return result;
+  }
+
+  private:
+  void Run() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        available_.wait(lock, [this] { return stopped_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable available_;
+  std::deque<std::function<void()>> tasks_;
+  std::vector<std::thread> threads_;
+  bool stopped_{};
+};
+
+}  // namespace mrd::hdf5
@@ -0,0 +1,482 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <H5Cpp.h>
+
+#include "chunk_codec.h"
+#include "io.h"
+
+// Storage of NDArrays in dense N-dimensional datasets instead of as
+// variable-length data within rows. Arrays are grouped by shape into array
+// sets. Each set is a subgroup named after its number, with a "shape"
+// attribute and, unless the shape is empty, a "data" dataset of rank N + 1
+// whose first dimension is the array's row in the set. An "$index" dataset
+// gives the set and row of each array in the order they were appended.
+// A range of arrays of the same shape can then be read with a single
+// hyperslab selection, and the datasets can be chunked and compressed.
+// Compressed chunks are encoded and decoded on the shared ChunkCodecPool and
+// written and read with H5Dwrite_chunk and H5Dread_chunk.
+namespace mrd::hdf5 {
+
+struct DenseArrayLocation {
+  uint32_t set;
+  uint64_t row;
+};
+
+static inline H5::CompType DenseArrayLocationDdl() {
+  H5::CompType type(sizeof(DenseArrayLocation));
+  type.insertMember("set", HOFFSET(DenseArrayLocation, set), H5::PredType::NATIVE_UINT32);
+  type.insertMember("row", HOFFSET(DenseArrayLocation, row), H5::PredType::NATIVE_UINT64);
+  return type;
+}
+
+static const inline std::string kDenseArrayShapeAttributeName = "shape";
+static const inline std::string kDenseArrayDatasetName = "data";
+static const inline std::string kDenseArrayIndexDatasetName = "$index";
+
+template <typename T, size_t N>
+class DenseArrayWriter {
+  static_assert(std::is_trivially_copyable_v<T>, "Dense arrays must have trivially copyable elements");
+
+  public:
+  /**
+   * The chunks of a set's dataset hold as many whole arrays as fit in the
+   * chunk size of `name` in the options, or in kAutoChunkBytes by default.
+   */
+  DenseArrayWriter(H5::Group const& parent_group, std::string const& name, H5::DataType const& element_type,
+                   Hdf5Options const& options = {})
+      : group_(parent_group.createGroup(name)),
+        element_type_(element_type),
+        options_(options.ForDataset(name)),
+        index_writer_(group_, kDenseArrayIndexDatasetName, DenseArrayLocationDdl(), 0,
+                      options.ForDataset(kDenseArrayIndexDatasetName)) {
+#ifndef MRD_HDF5_HAVE_ZSTD
+    if (options_.filters.compression == Compression::kZstd) {
+      throw std::invalid_argument("zstd compression is not available in this build.");
+    }
+#endif
+  }
+
+  DenseArrayWriter(DenseArrayWriter const&) = delete;
+  DenseArrayWriter& operator=(DenseArrayWriter const&) = delete;
+
+  ~DenseArrayWriter() {
+    Close();
+  }
+
+  /**
+   * Appends an array to the set of its shape. Its elements are held until a
+   * whole chunk of the set's dataset can be written, or until Flush() or,
+   * with compression, Close().
+   * Returns the array's position in the order of appended arrays.
+   * Compressed chunks are written once they are encoded, in order.
+   */
+  hsize_t Append(yardl::NDArray<T, N> const& array) {
+    auto shape = yardl::shape(array);
+    auto it = sets_.find(shape);
+    if (it == sets_.end()) {
+      it = sets_.emplace(shape, CreateSet(shape)).first;
+    }
+
+    ArraySet& set = it->second;
+    DenseArrayLocation location{set.id, set.rows++};
+    if (set.row_size > 0) {
+      T const* data = yardl::dataptr(array);
+      set.pending.insert(set.pending.end(), data, data + set.row_size);
+      if (set.pending.size() == set.chunk_rows * set.row_size) {
+        if (Compressed()) {
+          EncodePending(set);
+          set.pending.clear();
+        } else {
+          WritePending(set);
+        }
+      }
+    }
+
+    return index_writer_.AppendBuffered<DenseArrayLocation, DenseArrayLocation>(location);
+  }
+
+  /**
+   * Writes the held arrays, except with compression those of partial chunks.
+   * A compressed chunk grows as arrays are added to it, and HDF5 does not
+   * reuse the space of a chunk that is rewritten with a larger size.
+   */
+  void Flush() {
+    if (!Compressed()) {
+      for (auto& [shape, set] : sets_) {
+        WritePending(set);
+      }
+    }
+    CommitChunks(0);
+    index_writer_.Flush();
+  }
+
+  /**
+   * Writes all held arrays, padding the partial chunk of each set to its full
+   * size. No arrays can be appended afterwards.
+   */
+  void Close() {
+    if (Compressed()) {
+      for (auto& [shape, set] : sets_) {
+        if (!set.pending.empty()) {
+          EncodePending(set);
+          set.pending.clear();
+        }
+      }
+    }
+    Flush();
+    index_writer_.Create();
+  }
+
+  private:
+  struct ArraySet {
+    uint32_t id;
+    size_t row_size;
+    hsize_t chunk_rows;
+    std::optional<H5::DataSet> dataset;
+    hsize_t rows{};
+    hsize_t extent{};
+    std::vector<T> pending;
+  };
+
+  struct EncodedChunk {
+    ArraySet* set;
+    hsize_t first_row;
+    hsize_t rows;
+    std::future<std::vector<uint8_t>> data;
+  };
+
+  bool Compressed() const {
+    return options_.filters.Count() > 0;
+  }
+
+  ArraySet CreateSet(std::array<size_t, N> const& shape) {
+    ArraySet set;
+    set.id = static_cast<uint32_t>(sets_.size());
+    H5::Group set_group = group_.createGroup(std::to_string(set.id));
+
+    std::array<uint64_t, N> shape_value;
+    std::copy(shape.begin(), shape.end(), shape_value.begin());
+    hsize_t rank = N;
+    set_group.createAttribute(kDenseArrayShapeAttributeName, H5::PredType::NATIVE_UINT64, H5::DataSpace(1, &rank))
+        .write(H5::PredType::NATIVE_UINT64, shape_value.data());
+
+    set.row_size = 1;
+    for (size_t dim : shape) {
+      set.row_size *= dim;
+    }
+    size_t chunk_bytes = options_.chunk_bytes != 0 ? options_.chunk_bytes : kAutoChunkBytes;
+    set.chunk_rows = std::max(static_cast<hsize_t>(1),
+                              static_cast<hsize_t>(chunk_bytes / std::max(static_cast<size_t>(1), set.row_size * sizeof(T))));
+    if (set.row_size == 0) {
+      return set;
+    }
+
+    std::array<hsize_t, N + 1> dims{};
+    std::array<hsize_t, N + 1> maxdims;
+    std::array<hsize_t, N + 1> chunk_dims;
+    maxdims[0] = H5S_UNLIMITED;
+    chunk_dims[0] = set.chunk_rows;
+    for (size_t i = 0; i < N; i++) {
+      dims[i + 1] = maxdims[i + 1] = chunk_dims[i + 1] = shape[i];
+    }
+
+    H5::DSetCreatPropList prop;
+    prop.setChunk(N + 1, chunk_dims.data());
+    options_.filters.Apply(prop);
+    set.dataset = set_group.createDataSet(kDenseArrayDatasetName, element_type_,
+                                          H5::DataSpace(N + 1, dims.data(), maxdims.data()), prop,
+                                          ChunkCacheProperties(options_, set.chunk_rows * set.row_size * sizeof(T)));
+    set.pending.reserve(set.chunk_rows * set.row_size);
+    return set;
+  }
+
+  void WritePending(ArraySet& set) {
+    if (set.pending.empty()) {
+      return;
+    }
+
+    hsize_t row_count = set.pending.size() / set.row_size;
+    hsize_t first_row = set.rows - row_count;
+    hsize_t new_rows = set.rows;
+    std::array<hsize_t, N + 1> dims;
+    set.dataset->getSpace().getSimpleExtentDims(dims.data());
+    dims[0] = new_rows;
+    set.dataset->extend(dims.data());
+
+    std::array<hsize_t, N + 1> start{};
+    std::array<hsize_t, N + 1> count = dims;
+    start[0] = first_row;
+    count[0] = row_count;
+    H5::DataSpace file_space = set.dataset->getSpace();
+    file_space.selectHyperslab(H5S_SELECT_SET, count.data(), start.data());
+    H5::DataSpace mem_space(N + 1, count.data());
+    set.dataset->write(set.pending.data(), element_type_, mem_space, file_space);
+    set.pending.clear();
+  }
+
+  // Encodes the held arrays as a chunk, padded to its full size, on the shared pool.
+  void EncodePending(ArraySet& set) {
+    size_t element_size = element_type_.getSize();
+    std::vector<uint8_t> chunk(set.chunk_rows * set.row_size * element_size);
+    std::memcpy(chunk.data(), set.pending.data(), set.pending.size() * sizeof(T));
+
+    hsize_t row_count = set.pending.size() / set.row_size;
+    auto data = ChunkCodecPool::Shared().Submit(
+        [filters = options_.filters, chunk = std::move(chunk), element_size]() {
+          return filters.Encode(chunk, element_size);
+        });
+    encoded_chunks_.push_back({&set, set.rows - row_count, row_count, std::move(data)});
+
+    size_t threads = options_.compression_threads != 0 ? options_.compression_threads
+                                                       : ChunkCodecPool::Shared().Size();
+    CommitChunks(2 * threads);
+  }
+
+  // Writes encoded chunks in order, waiting for them until at most
+  // `max_pending` are left.
+  void CommitChunks(size_t max_pending) {
+    while (!encoded_chunks_.empty() &&
+           (encoded_chunks_.size() > max_pending ||
+            encoded_chunks_.front().data.wait_for(std::chrono::seconds(0)) == std::future_status::ready)) {
+      EncodedChunk& chunk = encoded_chunks_.front();
+      std::vector<uint8_t> data = chunk.data.get();
+      ArraySet& set = *chunk.set;
+
+      std::array<hsize_t, N + 1> dims;
+      set.dataset->getSpace().getSimpleExtentDims(dims.data());
+      if (chunk.first_row + chunk.rows > set.extent) {
+        set.extent = chunk.first_row + chunk.rows;
+        dims[0] = set.extent;
+        set.dataset->extend(dims.data());
+      }
+
+      std::array<hsize_t, N + 1> offset{};
+      offset[0] = chunk.first_row;
+      if (H5Dwrite_chunk(set.dataset->getId(), H5P_DEFAULT, 0, offset.data(), data.size(), data.data()) < 0) {
+        throw std::runtime_error("Failed to write a chunk of dense arrays to '" + group_.getObjName() + "'.");
+      }
+      encoded_chunks_.pop_front();
+    }
+  }
+
+  H5::Group group_;
+  H5::DataType element_type_;
+  DatasetOptions options_;
+  DatasetWriter index_writer_;
+  std::map<std::array<size_t, N>, ArraySet> sets_;
+  std::deque<EncodedChunk> encoded_chunks_;
+};
+
+template <typename T, size_t N>
+class DenseArrayReader {
+  static_assert(std::is_trivially_copyable_v<T>, "Dense arrays must have trivially copyable elements");
+
+  public:
+  static constexpr size_t kIndexWindowRows = 4096;
+
+  DenseArrayReader(H5::Group const& parent_group, std::string const& name, H5::DataType const& element_type,
+                   Hdf5Options const& options = {})
+      : group_(parent_group.openGroup(name)),
+        element_type_(element_type),
+        options_(options.ForDataset(name)),
+        index_dataset_(group_.openDataSet(kDenseArrayIndexDatasetName)) {
+    index_dataset_.getSpace().getSimpleExtentDims(&index_rows_);
+  }
+
+  /**
+   * Reads the array at the given position in the order arrays were appended.
+   * Arrays are read a whole chunk of their set's dataset at a time, so
+   * reading them in order reads each chunk once. Compressed chunks are read
+   * several at a time and decoded in parallel.
+   */
+  void Read(hsize_t position, yardl::NDArray<T, N>& array) {
+    DenseArrayLocation location = Locate(position);
+    ArraySet& set = OpenSet(location.set);
+    yardl::resize(array, set.shape);
+    if (set.row_size == 0) {
+      return;
+    }
+    if (location.row >= set.rows) {
+      throw std::runtime_error("Dense array row " + std::to_string(location.row) + " of set " +
+                               std::to_string(location.set) + " does not exist.");
+    }
+
+    if (location.row < set.window_offset || location.row >= set.window_offset + set.window_rows) {
+      ReadWindow(set, location.row);
+    }
+    std::copy_n(set.window.data() + (location.row - set.window_offset) * set.row_size, set.row_size,
+                yardl::dataptr(array));
+  }
+
+  hsize_t Size() const {
+    return index_rows_;
+  }
+
+  private:
+  struct ArraySet {
+    std::array<size_t, N> shape;
+    size_t row_size;
+    std::optional<H5::DataSet> dataset;
+    hsize_t rows{};
+    hsize_t chunk_rows{};
+    std::optional<ChunkFilters> filters;
+    std::vector<T> window;
+    hsize_t window_offset{};
+    hsize_t window_rows{};
+  };
+
+  DenseArrayLocation Locate(hsize_t position) {
+    if (position >= index_rows_) {
+      throw std::runtime_error("Dense array " + std::to_string(position) + " does not exist in '" +
+                               group_.getObjName() + "'.");
+    }
+
+    if (position < index_offset_ || position >= index_offset_ + index_.size()) {
+      hsize_t count = std::min(static_cast<hsize_t>(kIndexWindowRows), index_rows_ - position);
+      index_.resize(count);
+      H5::DataSpace file_space = index_dataset_.getSpace();
+      file_space.selectHyperslab(H5S_SELECT_SET, &count, &position);
+      H5::DataSpace mem_space(1, &count);
+      index_dataset_.read(index_.data(), DenseArrayLocationDdl(), mem_space, file_space);
+      index_offset_ = position;
+    }
+
+    return index_[position - index_offset_];
+  }
+
+  ArraySet& OpenSet(uint32_t id) {
+    auto it = sets_.find(id);
+    if (it != sets_.end()) {
+      return it->second;
+    }
+
+    H5::Group set_group = group_.openGroup(std::to_string(id));
+    H5::Attribute shape_attribute = set_group.openAttribute(kDenseArrayShapeAttributeName);
+    hsize_t rank = 0;
+    shape_attribute.getSpace().getSimpleExtentDims(&rank);
+    if (rank != N) {
+      throw std::runtime_error("Dense array set " + std::to_string(id) + " in '" + group_.getObjName() +
+                               "' has " + std::to_string(rank) + " dimensions, expected " + std::to_string(N) + ".");
+    }
+
+    std::array<uint64_t, N> shape_value;
+    shape_attribute.read(H5::PredType::NATIVE_UINT64, shape_value.data());
+
+    ArraySet set;
+    std::copy(shape_value.begin(), shape_value.end(), set.shape.begin());
+    set.row_size = 1;
+    for (size_t dim : set.shape) {
+      set.row_size *= dim;
+    }
+
+    if (set.row_size > 0) {
+      set.dataset = set_group.openDataSet(kDenseArrayDatasetName);
+      std::array<hsize_t, N + 1> dims;
+      set.dataset->getSpace().getSimpleExtentDims(dims.data());
+      set.rows = dims[0];
+
+      H5::DSetCreatPropList prop = set.dataset->getCreatePlist();
+      std::array<hsize_t, N + 1> chunk_dims{};
+      set.chunk_rows = prop.getLayout() == H5D_CHUNKED && prop.getChunk(N + 1, chunk_dims.data()) == N + 1
+                           ? chunk_dims[0]
+                           : 1;
+      if (prop.getLayout() == H5D_CHUNKED) {
+        set.filters = ChunkFilters::FromDataset(prop);
+        if (set.filters && set.filters->Count() == 0) {
+          set.filters.reset();
+        }
+      }
+    }
+
+    return sets_.emplace(id, std::move(set)).first->second;
+  }
+
+  // Reads the chunk of rows containing the given row.
+  void ReadWindow(ArraySet& set, hsize_t row) {
+    if (set.filters) {
+      ReadEncodedWindow(set, row);
+      return;
+    }
+
+    std::array<hsize_t, N + 1> start{};
+    std::array<hsize_t, N + 1> count;
+    start[0] = row - row % set.chunk_rows;
+    count[0] = std::min(set.chunk_rows, set.rows - start[0]);
+    for (size_t i = 0; i < N; i++) {
+      count[i + 1] = set.shape[i];
+    }
+
+    set.window.resize(count[0] * set.row_size);
+    H5::DataSpace file_space = set.dataset->getSpace();
+    file_space.selectHyperslab(H5S_SELECT_SET, count.data(), start.data());
+    H5::DataSpace mem_space(N + 1, count.data());
+    set.dataset->read(set.window.data(), element_type_, mem_space, file_space);
+    set.window_offset = start[0];
+    set.window_rows = count[0];
+  }
+
+  // Reads the chunk containing the given row and the chunks after it with
+  // H5Dread_chunk, and decodes them on the shared pool.
+  void ReadEncodedWindow(ArraySet& set, hsize_t row) {
+    size_t threads = options_.compression_threads != 0 ? options_.compression_threads
+                                                       : ChunkCodecPool::Shared().Size();
+    hsize_t first_row = row - row % set.chunk_rows;
+    hsize_t chunk_count = std::min(static_cast<hsize_t>(threads),
+                                   (set.rows - first_row + set.chunk_rows - 1) / set.chunk_rows);
+    size_t element_size = element_type_.getSize();
+    size_t chunk_bytes = set.chunk_rows * set.row_size * element_size;
+
+    std::vector<std::future<std::vector<uint8_t>>> chunks;
+    for (hsize_t i = 0; i < chunk_count; i++) {
+      std::array<hsize_t, N + 1> offset{};
+      offset[0] = first_row + i * set.chunk_rows;
+      hsize_t encoded_bytes = 0;
+      uint32_t filter_mask = 0;
+      if (H5Dget_chunk_storage_size(set.dataset->getId(), offset.data(), &encoded_bytes) < 0) {
+        throw std::runtime_error("Failed to get the size of a chunk of dense arrays in '" + group_.getObjName() + "'.");
+      }
+      std::vector<uint8_t> encoded(encoded_bytes);
+      if (H5Dread_chunk(set.dataset->getId(), H5P_DEFAULT, offset.data(), &filter_mask, encoded.data()) < 0) {
+        throw std::runtime_error("Failed to read a chunk of dense arrays from '" + group_.getObjName() + "'.");
+      }
+      chunks.push_back(ChunkCodecPool::Shared().Submit(
+          [filters = *set.filters, encoded = std::move(encoded), filter_mask, chunk_bytes, element_size]() {
+            return filters.Decode(encoded, filter_mask, chunk_bytes, element_size);
+          }));
+    }
+
+    hsize_t window_rows = std::min(chunk_count * set.chunk_rows, set.rows - first_row);
+    set.window.resize(window_rows * set.row_size);
+    for (hsize_t i = 0; i < chunk_count; i++) {
+      std::vector<uint8_t> chunk = chunks[i].get();
+      hsize_t rows = std::min(set.chunk_rows, window_rows - i * set.chunk_rows);
+      std::memcpy(set.window.data() + i * set.chunk_rows * set.row_size, chunk.data(), rows * set.row_size * sizeof(T));
+    }
+    set.window_offset = first_row;
+    set.window_rows = window_rows;
+  }
+
+  H5::Group group_;
+  H5::DataType element_type_;
+  DatasetOptions options_;
+  H5::DataSet index_dataset_;
+  hsize_t index_rows_{};
+  std::vector<DenseArrayLocation> index_;
+  hsize_t index_offset_{};
+  std::map<uint32_t, ArraySet> sets_;
+};
+
+}  // namespace mrd::hdf5
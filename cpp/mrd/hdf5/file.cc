@@ -0,0 +1,1085 @@
+#include "file.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+
+#include "../byte_size.h"
+#include "dense_arrays.h"
+#include "model_inner_types.h"
+
+namespace mrd::hdf5 {
+// The arrays of acquisitions and images written with ArrayLayout::kDense,
+// in groups of dense array datasets named after the union type and field.
+template <template <typename, size_t> class TArrays>
+struct DenseArrays {
+  DenseArrays(H5::Group const& group, Hdf5Options const& options)
+      : acquisition_data(group, "acquisition.data", ComplexTypeDdl<float>(), options),
+        acquisition_trajectory(group, "acquisition.trajectory", H5::PredType::NATIVE_FLOAT, options),
+        image_uint16_data(group, "imageUint16.data", H5::PredType::NATIVE_UINT16, options),
+        image_int16_data(group, "imageInt16.data", H5::PredType::NATIVE_INT16, options),
+        image_uint32_data(group, "imageUint32.data", H5::PredType::NATIVE_UINT32, options),
+        image_int32_data(group, "imageInt32.data", H5::PredType::NATIVE_INT32, options),
+        image_float_data(group, "imageFloat.data", H5::PredType::NATIVE_FLOAT, options),
+        image_double_data(group, "imageDouble.data", H5::PredType::NATIVE_DOUBLE, options),
+        image_complex_float_data(group, "imageComplexFloat.data", ComplexTypeDdl<float>(), options),
+        image_complex_double_data(group, "imageComplexDouble.data", ComplexTypeDdl<double>(), options) {
+  }
+
+  template <typename T>
+  TArrays<T, 4>& ImageData() {
+    if constexpr (std::is_same_v<T, uint16_t>) {
+      return image_uint16_data;
+    } else if constexpr (std::is_same_v<T, int16_t>) {
+      return image_int16_data;
+    } else if constexpr (std::is_same_v<T, uint32_t>) {
+      return image_uint32_data;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+      return image_int32_data;
+    } else if constexpr (std::is_same_v<T, float>) {
+      return image_float_data;
+    } else if constexpr (std::is_same_v<T, double>) {
+      return image_double_data;
+    } else if constexpr (std::is_same_v<T, std::complex<float>>) {
+      return image_complex_float_data;
+    } else if constexpr (std::is_same_v<T, std::complex<double>>) {
+      return image_complex_double_data;
+    } else {
+      static_assert(always_false_v<T>, "non-exhaustive image types!");
+    }
+  }
+
+  TArrays<std::complex<float>, 2> acquisition_data;
+  TArrays<float, 2> acquisition_trajectory;
+  TArrays<uint16_t, 4> image_uint16_data;
+  TArrays<int16_t, 4> image_int16_data;
+  TArrays<uint32_t, 4> image_uint32_data;
+  TArrays<int32_t, 4> image_int32_data;
+  TArrays<float, 4> image_float_data;
+  TArrays<double, 4> image_double_data;
+  TArrays<std::complex<float>, 4> image_complex_float_data;
+  TArrays<std::complex<double>, 4> image_complex_double_data;
+};
+
+struct DenseArrayWriters : DenseArrays<DenseArrayWriter> {
+  using DenseArrays::DenseArrays;
+
+  void Flush() {
+    acquisition_data.Flush();
+    acquisition_trajectory.Flush();
+    image_uint16_data.Flush();
+    image_int16_data.Flush();
+    image_uint32_data.Flush();
+    image_int32_data.Flush();
+    image_float_data.Flush();
+    image_double_data.Flush();
+    image_complex_float_data.Flush();
+    image_complex_double_data.Flush();
+  }
+
+  void Close() {
+    acquisition_data.Close();
+    acquisition_trajectory.Close();
+    image_uint16_data.Close();
+    image_int16_data.Close();
+    image_uint32_data.Close();
+    image_int32_data.Close();
+    image_float_data.Close();
+    image_double_data.Close();
+    image_complex_float_data.Close();
+    image_complex_double_data.Close();
+  }
+};
+
+struct DenseArrayReaders : DenseArrays<DenseArrayReader> {
+  using DenseArrays::DenseArrays;
+};
+
+namespace {
+static const inline std::string kDenseArraysGroupName = "arrays";
+
+// The format version of files written with ArrayLayout::kDense. Readers that
+// do not know the layout only accept version 1, so they fail on these files
+// instead of reading acquisitions and images without their arrays.
+constexpr uint32_t kDenseArraysFormatVersion = 2;
+
+template <typename T>
+struct IsImage : std::false_type {};
+
+template <typename T>
+struct IsImage<mrd::Image<T>> : std::true_type {};
+
+// An acquisition or image whose arrays are written to dense datasets, to be
+// appended as a row without them.
+template <typename T>
+struct DenseRowSource {
+  T const& value;
+};
+
+size_t ByteSize(DenseRowSource<mrd::Acquisition> const& source) {
+  return yardl::ByteSize(source.value.head) + yardl::ByteSize(source.value.phase);
+}
+
+template <typename T>
+size_t ByteSize(DenseRowSource<mrd::Image<T>> const& source) {
+  return yardl::ByteSize(source.value.head) + yardl::ByteSize(source.value.meta);
+}
+
+// The rows of acquisitions and images written with ArrayLayout::kDense. They
+// are laid out like the generated inner types, so that they are written with
+// the same HDF5 types, but convert only the fields that are not arrays.
+struct DenseAcquisitionRow {
+  DenseAcquisitionRow(DenseRowSource<mrd::Acquisition> const& o)
+      : head(o.value.head),
+        phase(o.value.phase) {
+  }
+
+  decltype(mrd::hdf5::_Inner_Acquisition::head) head;
+  decltype(mrd::hdf5::_Inner_Acquisition::data) data;
+  decltype(mrd::hdf5::_Inner_Acquisition::phase) phase;
+  decltype(mrd::hdf5::_Inner_Acquisition::trajectory) trajectory;
+};
+
+static_assert(sizeof(DenseAcquisitionRow) == sizeof(mrd::hdf5::_Inner_Acquisition) &&
+              HOFFSET(DenseAcquisitionRow, head) == HOFFSET(mrd::hdf5::_Inner_Acquisition, head) &&
+              HOFFSET(DenseAcquisitionRow, data) == HOFFSET(mrd::hdf5::_Inner_Acquisition, data) &&
+              HOFFSET(DenseAcquisitionRow, phase) == HOFFSET(mrd::hdf5::_Inner_Acquisition, phase) &&
+              HOFFSET(DenseAcquisitionRow, trajectory) == HOFFSET(mrd::hdf5::_Inner_Acquisition, trajectory));
+
+template <typename T>
+struct DenseImageRow {
+  using Inner = mrd::hdf5::_Inner_Image<T, T>;
+
+  DenseImageRow(DenseRowSource<mrd::Image<T>> const& o)
+      : head(o.value.head),
+        meta(o.value.meta) {
+    static_assert(sizeof(DenseImageRow) == sizeof(Inner) &&
+                  HOFFSET(DenseImageRow, head) == HOFFSET(Inner, head) &&
+                  HOFFSET(DenseImageRow, data) == HOFFSET(Inner, data) &&
+                  HOFFSET(DenseImageRow, meta) == HOFFSET(Inner, meta));
+  }
+
+  decltype(Inner::head) head;
+  decltype(Inner::data) data;
+  decltype(Inner::meta) meta;
+};
+
+// Appends the arrays of acquisitions and images to their dense datasets and
+// the rest of the item as a row. Returns false for other items, which are
+// written as they are.
+bool AppendDenseItem(UnionDatasetWriter<22>& writer, DenseArrayWriters& arrays, mrd::StreamItem const& value) {
+  return std::visit(
+    [&](auto const& arg) {
+      using T = std::decay_t<decltype(arg)>;
+      auto type = static_cast<int8_t>(value.index());
+      if constexpr (std::is_same_v<T, mrd::Acquisition>) {
+        arrays.acquisition_data.Append(arg.data);
+        arrays.acquisition_trajectory.Append(arg.trajectory);
+        writer.Append<DenseAcquisitionRow, DenseRowSource<T>>(type, DenseRowSource<T>{arg});
+        return true;
+      } else if constexpr (IsImage<T>::value) {
+        using TData = typename std::decay_t<decltype(arg.data)>::value_type;
+        arrays.ImageData<TData>().Append(arg.data);
+        writer.Append<DenseImageRow<TData>, DenseRowSource<T>>(type, DenseRowSource<T>{arg});
+        return true;
+      } else {
+        return false;
+      }
+    },
+    value);
+}
+
+// Fills in the arrays of the acquisition or image read from the given row.
+void ReadDenseArrays(DenseArrayReaders* arrays, mrd::Acquisition& value, hsize_t row) {
+  if (arrays != nullptr) {
+    arrays->acquisition_data.Read(row, value.data);
+    arrays->acquisition_trajectory.Read(row, value.trajectory);
+  }
+}
+
+template <typename T>
+void ReadDenseArrays(DenseArrayReaders* arrays, mrd::Image<T>& value, hsize_t row) {
+  if (arrays != nullptr) {
+    arrays->ImageData<T>().Read(row, value.data);
+  }
+}
+
+static const inline std::string kKeysGroupName = "keys";
+
+// The value of a key in the tables when the counter is not set.
+static constexpr uint32_t kMissingKey = std::numeric_limits<uint32_t>::max();
+
+// A row of the acquisition key table, ordered by the keys and then by
+// position in the data stream.
+struct AcquisitionKey {
+  uint32_t slice;
+  uint32_t contrast;
+  uint32_t repetition;
+  uint32_t kspace_encode_step_1;
+  uint32_t kspace_encode_step_2;
+  uint64_t flags;
+  uint64_t position;
+
+  bool operator<(AcquisitionKey const& other) const {
+    return std::tie(slice, contrast, repetition, kspace_encode_step_1, kspace_encode_step_2, position) <
+           std::tie(other.slice, other.contrast, other.repetition, other.kspace_encode_step_1,
+                    other.kspace_encode_step_2, other.position);
+  }
+};
+
+H5::CompType GetAcquisitionKeyHdf5Ddl() {
+  using RecordType = AcquisitionKey;
+  H5::CompType t(sizeof(RecordType));
+  t.insertMember("slice", HOFFSET(RecordType, slice), H5::PredType::NATIVE_UINT32);
+  t.insertMember("contrast", HOFFSET(RecordType, contrast), H5::PredType::NATIVE_UINT32);
+  t.insertMember("repetition", HOFFSET(RecordType, repetition), H5::PredType::NATIVE_UINT32);
+  t.insertMember("kspaceEncodeStep1", HOFFSET(RecordType, kspace_encode_step_1), H5::PredType::NATIVE_UINT32);
+  t.insertMember("kspaceEncodeStep2", HOFFSET(RecordType, kspace_encode_step_2), H5::PredType::NATIVE_UINT32);
+  t.insertMember("flags", HOFFSET(RecordType, flags), H5::PredType::NATIVE_UINT64);
+  t.insertMember("position", HOFFSET(RecordType, position), H5::PredType::NATIVE_UINT64);
+  return t;
+}
+
+// A row of the image key table, ordered by the keys and then by position in
+// the data stream.
+struct ImageKey {
+  uint32_t image_series_index;
+  uint32_t image_index;
+  uint32_t slice;
+  uint64_t position;
+
+  bool operator<(ImageKey const& other) const {
+    return std::tie(image_series_index, image_index, slice, position) <
+           std::tie(other.image_series_index, other.image_index, other.slice, other.position);
+  }
+};
+
+H5::CompType GetImageKeyHdf5Ddl() {
+  using RecordType = ImageKey;
+  H5::CompType t(sizeof(RecordType));
+  t.insertMember("imageSeriesIndex", HOFFSET(RecordType, image_series_index), H5::PredType::NATIVE_UINT32);
+  t.insertMember("imageIndex", HOFFSET(RecordType, image_index), H5::PredType::NATIVE_UINT32);
+  t.insertMember("slice", HOFFSET(RecordType, slice), H5::PredType::NATIVE_UINT32);
+  t.insertMember("position", HOFFSET(RecordType, position), H5::PredType::NATIVE_UINT64);
+  return t;
+}
+
+uint32_t KeyValue(std::optional<uint32_t> const& value) {
+  return value.value_or(kMissingKey);
+}
+
+bool Matches(std::optional<KeyRange> const& range, uint32_t value) {
+  return !range || (value != kMissingKey && value >= range->first && value < range->last);
+}
+
+bool Matches(AcquisitionSelection const& selection, AcquisitionKey const& key) {
+  uint64_t flags_set = selection.flags_set.Value();
+  return Matches(selection.slice, key.slice) &&
+         Matches(selection.contrast, key.contrast) &&
+         Matches(selection.repetition, key.repetition) &&
+         Matches(selection.kspace_encode_step_1, key.kspace_encode_step_1) &&
+         Matches(selection.kspace_encode_step_2, key.kspace_encode_step_2) &&
+         (key.flags & flags_set) == flags_set &&
+         (key.flags & selection.flags_clear.Value()) == 0;
+}
+
+bool Matches(ImageSelection const& selection, ImageKey const& key) {
+  return Matches(selection.image_series_index, key.image_series_index) &&
+         Matches(selection.image_index, key.image_index) &&
+         Matches(selection.slice, key.slice);
+}
+
+template <typename TKey>
+void WriteKeyTable(H5::Group const& group, std::string const& name, H5::CompType const& type, std::vector<TKey>& keys) {
+  std::sort(keys.begin(), keys.end());
+  hsize_t size = keys.size();
+  H5::DataSpace space(1, &size);
+  H5::DataSet dataset = group.createDataSet(name, type, space);
+  if (!keys.empty()) {
+    dataset.write(keys.data(), type);
+  }
+}
+
+template <typename TKey>
+std::vector<TKey> ReadKeyTable(H5::Group const& group, std::string const& name, H5::CompType const& type) {
+  H5::DataSet dataset = group.openDataSet(name);
+  hsize_t size = 0;
+  dataset.getSpace().getSimpleExtentDims(&size);
+  std::vector<TKey> keys(size);
+  if (!keys.empty()) {
+    dataset.read(keys.data(), type);
+  }
+  return keys;
+}
+
+// Returns the positions of the keys matching the selection. The keys are
+// sorted by their first key, so a range of it narrows down the keys to scan.
+template <typename TKey, typename TSelection, typename TFirstKey>
+std::vector<uint64_t> SelectKeyPositions(std::vector<TKey> const& keys, TSelection const& selection,
+                                         std::optional<KeyRange> const& first_key_range, TFirstKey first_key) {
+  auto begin = keys.begin();
+  auto end = keys.end();
+  if (first_key_range) {
+    begin = std::partition_point(begin, end, [&](TKey const& key) { return key.*first_key < first_key_range->first; });
+    end = std::partition_point(begin, end, [&](TKey const& key) { return key.*first_key < first_key_range->last; });
+  }
+
+  std::vector<uint64_t> positions;
+  for (auto it = begin; it != end; ++it) {
+    if (Matches(selection, *it)) {
+      positions.push_back(it->position);
+    }
+  }
+  std::sort(positions.begin(), positions.end());
+  return positions;
+}
+
+// Reads the given rows of one image type and moves them to their slots in
+// the selected items.
+template <typename TInner, size_t I>
+void ReadSelectedImages(DatasetReader& reader, DenseArrayReaders* dense_arrays,
+                        std::vector<hsize_t> const& rows, std::vector<size_t> const& slots,
+                        std::vector<mrd::StreamItem>& values) {
+  using TOuter = std::variant_alternative_t<I, mrd::StreamItem>;
+  std::vector<TOuter> images;
+  reader.ReadRows<TInner, TOuter>(rows, images);
+  for (size_t i = 0; i < images.size(); i++) {
+    ReadDenseArrays(dense_arrays, images[i], rows[i]);
+    values[slots[i]].emplace<I>(std::move(images[i]));
+  }
+}
+} // namespace
+
+// The key tables of acquisitions and images, collected while writing or
+// loaded for MrdFileReader::Select().
+struct KeyTables {
+  void Append(mrd::StreamItem const& value) {
+    std::visit(
+      [&](auto const& arg) {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, mrd::Acquisition>) {
+          auto const& idx = arg.head.idx;
+          acquisitions.push_back({KeyValue(idx.slice), KeyValue(idx.contrast), KeyValue(idx.repetition),
+                                  KeyValue(idx.kspace_encode_step_1), KeyValue(idx.kspace_encode_step_2),
+                                  arg.head.flags.Value(), position});
+        } else if constexpr (IsImage<T>::value) {
+          images.push_back({KeyValue(arg.head.image_series_index), KeyValue(arg.head.image_index),
+                            KeyValue(arg.head.slice), position});
+        }
+      },
+      value);
+    position++;
+  }
+
+  void Write(H5::Group const& group) {
+    WriteKeyTable(group, "acquisition", GetAcquisitionKeyHdf5Ddl(), acquisitions);
+    WriteKeyTable(group, "image", GetImageKeyHdf5Ddl(), images);
+  }
+
+  void Read(H5::Group const& group) {
+    acquisitions = ReadKeyTable<AcquisitionKey>(group, "acquisition", GetAcquisitionKeyHdf5Ddl());
+    images = ReadKeyTable<ImageKey>(group, "image", GetImageKeyHdf5Ddl());
+  }
+
+  std::vector<AcquisitionKey> acquisitions;
+  std::vector<ImageKey> images;
+  uint64_t position{};
+};
+
+MrdFileWriter::MrdFileWriter(std::string path)
+    : MrdFileWriter(std::move(path), ArrayLayout::kVariableLength) {
+}
+
+MrdFileWriter::MrdFileWriter(std::string path, Hdf5Options const& options)
+    : MrdFileWriter(std::move(path), ArrayLayout::kVariableLength, options) {
+}
+
+MrdFileWriter::MrdFileWriter(std::string path, ArrayLayout array_layout, Hdf5Options const& options)
+    : MrdFileWriter(std::move(path), MrdWriterOptions{array_layout}, options) {
+}
+
+MrdFileWriter::MrdFileWriter(std::string path, MrdWriterOptions const& mrd_options, Hdf5Options const& options)
+    : Hdf5Writer::Hdf5Writer(path, "Mrd", schema_, options) {
+  // No objects can be created once SWMR writing has started
+  if (options.swmr && (mrd_options.array_layout == ArrayLayout::kDense || mrd_options.key_tables)) {
+    throw std::invalid_argument("SWMR writing does not support the dense array layout or key tables.");
+  }
+  if (mrd_options.array_layout == ArrayLayout::kDense) {
+    SetFormatVersion(kDenseArraysFormatVersion);
+    dense_arrays_ = std::make_unique<DenseArrayWriters>(group_.createGroup(kDenseArraysGroupName), options_);
+  }
+  if (mrd_options.key_tables) {
+    key_tables_ = std::make_unique<KeyTables>();
+  }
+}
+
+MrdFileWriter::~MrdFileWriter() = default;
+
+namespace {
+void ReadHeaderDataset(H5::Group const& group, std::optional<mrd::Header>& value) {
+  ReadScalarDataset<InnerOptional<mrd::hdf5::_Inner_Header, mrd::Header>, std::optional<mrd::Header>>(group, "header", OptionalTypeDdl<mrd::hdf5::_Inner_Header, mrd::Header>(mrd::hdf5::GetHeaderHdf5Ddl()), value);
+}
+
+// A source file of a virtual data stream, opened once to check that it
+// matches the file being written and to map its data stream.
+class VirtualDataSource : public Hdf5Reader {
+  public:
+  VirtualDataSource(std::string const& path, std::string const& schema, Hdf5Options const& options)
+      : Hdf5Reader(path, "Mrd", schema, options, kDenseArraysFormatVersion) {
+    if (format_version_ == kDenseArraysFormatVersion) {
+      throw std::runtime_error("Unable to map the data stream of '" + path +
+                               "' because it uses the dense array layout.");
+    }
+  }
+
+  std::optional<mrd::Header> Header() const {
+    std::optional<mrd::Header> value;
+    ReadHeaderDataset(group_, value);
+    return value;
+  }
+
+  H5::Group DataGroup() const {
+    return group_.openGroup("data");
+  }
+};
+} // namespace
+
+void MrdFileWriter::WriteHeaderImpl(std::optional<mrd::Header> const& value) {
+  WriteScalarDataset<InnerOptional<mrd::hdf5::_Inner_Header, mrd::Header>, std::optional<mrd::Header>>(group_, "header", OptionalTypeDdl<mrd::hdf5::_Inner_Header, mrd::Header>(mrd::hdf5::GetHeaderHdf5Ddl()), value);
+}
+
+namespace {
+void AppendStreamItem(UnionDatasetWriter<22>& writer, DenseArrayWriters* dense_arrays, mrd::StreamItem const& value) {
+  if (dense_arrays != nullptr && AppendDenseItem(writer, *dense_arrays, value)) {
+    return;
+  }
+
+  std::visit(
+    [&](auto const& arg) {
+      using T = std::decay_t<decltype(arg)>;
+      if constexpr (std::is_same_v<T, mrd::Acquisition>) {
+        writer.Append<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::AcquisitionPrototype>) {
+        writer.Append<mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::WaveformUint32>) {
+        writer.Append<mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::ImageUint16>) {
+        writer.Append<mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::ImageInt16>) {
+        writer.Append<mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::ImageUint32>) {
+        writer.Append<mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::ImageInt32>) {
+        writer.Append<mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::ImageFloat>) {
+        writer.Append<mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::ImageDouble>) {
+        writer.Append<mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::ImageComplexFloat>) {
+        writer.Append<mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::ImageComplexDouble>) {
+        writer.Append<mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::AcquisitionBucket>) {
+        writer.Append<mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::ReconData>) {
+        writer.Append<mrd::hdf5::_Inner_ReconData, mrd::ReconData>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::ArrayComplexFloat>) {
+        writer.Append<InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::ImageArray>) {
+        writer.Append<mrd::hdf5::_Inner_ImageArray, mrd::ImageArray>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::PulseqDefinitions>) {
+        writer.Append<mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, std::vector<mrd::PulseqBlock>>) {
+        writer.Append<InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::PulseqRFEvent>) {
+        writer.Append<mrd::PulseqRFEvent, mrd::PulseqRFEvent>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::PulseqArbitraryGradient>) {
+        writer.Append<mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::PulseqTrapezoidalGradient>) {
+        writer.Append<mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::PulseqADCEvent>) {
+        writer.Append<mrd::PulseqADCEvent, mrd::PulseqADCEvent>(static_cast<int8_t>(value.index()), arg);
+      } else if constexpr (std::is_same_v<T, mrd::PulseqShape>) {
+        writer.Append<mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>(static_cast<int8_t>(value.index()), arg);
+      } else {
+        static_assert(always_false_v<T>, "non-exhaustive visitor!");
+      }
+    },
+    value);
+}
+} // namespace
+
+UnionDatasetWriter<22>& MrdFileWriter::DataDatasetState() {
+  if (!data_dataset_state_) {
+    data_dataset_state_ = std::make_unique<UnionDatasetWriter<22>>(group_, "data", options_, false, std::make_tuple(mrd::hdf5::GetAcquisitionHdf5Ddl(), "acquisition", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetAcquisitionPrototypeHdf5Ddl(), "acquisitionPrototype", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetWaveformHdf5Ddl<uint32_t, uint32_t>(H5::PredType::NATIVE_UINT32), "waveformUint32", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<uint16_t, uint16_t>(H5::PredType::NATIVE_UINT16), "imageUint16", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<int16_t, int16_t>(H5::PredType::NATIVE_INT16), "imageInt16", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<uint32_t, uint32_t>(H5::PredType::NATIVE_UINT32), "imageUint32", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<int32_t, int32_t>(H5::PredType::NATIVE_INT32), "imageInt32", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<float, float>(H5::PredType::NATIVE_FLOAT), "imageFloat", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<double, double>(H5::PredType::NATIVE_DOUBLE), "imageDouble", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<std::complex<float>, std::complex<float>>(ComplexTypeDdl<float>()), "imageComplexFloat", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<std::complex<double>, std::complex<double>>(ComplexTypeDdl<double>()), "imageComplexDouble", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetAcquisitionBucketHdf5Ddl(), "acquisitionBucket", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetReconDataHdf5Ddl(), "reconData", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(DynamicNDArrayDdl<std::complex<float>, std::complex<float>>(ComplexTypeDdl<float>()), "arrayComplexFloat", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageArrayHdf5Ddl(), "imageArray", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetPulseqDefinitionsHdf5Ddl(), "pulseqDefinitions", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(InnerVlenDdl(mrd::hdf5::GetPulseqBlockHdf5Ddl()), "pulseqBlocks", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetPulseqRFEventHdf5Ddl(), "pulseqRfEvent", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetPulseqArbitraryGradientHdf5Ddl(), "pulseqArbitraryGradient", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetPulseqTrapezoidalGradientHdf5Ddl(), "pulseqTrapezoidalGradient", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetPulseqADCEventHdf5Ddl(), "pulseqAdcEvent", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetPulseqShapeHdf5Ddl(), "pulseqShape", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))));
+    if (options_.swmr) {
+      ReleaseFile();
+      data_dataset_state_->StartSwmrWrite();
+    }
+  }
+
+  return *data_dataset_state_;
+}
+
+void MrdFileWriter::WriteDataImpl(mrd::StreamItem const& value) {
+  AppendStreamItem(DataDatasetState(), dense_arrays_.get(), value);
+  if (key_tables_) {
+    key_tables_->Append(value);
+  }
+}
+
+void MrdFileWriter::WriteDataImpl(std::vector<mrd::StreamItem> const& values) {
+  if (virtual_source_paths_ != nullptr) {
+    WriteVirtualDataImpl(*virtual_source_paths_);
+    return;
+  }
+
+  for (auto const& value : values) {
+    AppendStreamItem(DataDatasetState(), dense_arrays_.get(), value);
+    if (key_tables_) {
+      key_tables_->Append(value);
+    }
+  }
+}
+
+void MrdFileWriter::EndDataImpl() {
+  if (!virtual_data_) {
+    DataDatasetState();
+  }
+  data_dataset_state_.reset();
+  if (dense_arrays_) {
+    dense_arrays_->Close();
+  }
+  if (key_tables_) {
+    key_tables_->Write(group_.createGroup(kKeysGroupName));
+    key_tables_.reset();
+  }
+}
+
+void MrdFileWriter::Flush() {
+  if (data_dataset_state_) {
+    data_dataset_state_->Flush();
+  }
+  if (dense_arrays_) {
+    dense_arrays_->Flush();
+  }
+}
+
+void MrdFileWriter::WriteVirtualData(std::vector<std::string> const& source_paths) {
+  static std::vector<mrd::StreamItem> const no_values;
+  virtual_source_paths_ = &source_paths;
+  try {
+    MrdWriterBase::WriteData(no_values);
+  } catch (...) {
+    virtual_source_paths_ = nullptr;
+    throw;
+  }
+  virtual_source_paths_ = nullptr;
+}
+
+void MrdFileWriter::WriteVirtualDataImpl(std::vector<std::string> const& source_paths) {
+  if (data_dataset_state_ || virtual_data_) {
+    throw std::runtime_error("The data stream has already been written.");
+  }
+  if (dense_arrays_ || key_tables_) {
+    throw std::invalid_argument("Virtual data streams do not support the dense array layout or key tables.");
+  }
+
+  std::optional<mrd::Header> header;
+  ReadHeaderDataset(group_, header);
+
+  std::vector<H5::Group> source_groups;
+  for (auto const& source_path : source_paths) {
+    // Checks the schema and format version of the source
+    VirtualDataSource source(source_path, schema_, options_);
+    if (source.Header() != header) {
+      throw std::runtime_error("The header of '" + source_path + "' differs from the header of the file.");
+    }
+    source_groups.push_back(source.DataGroup());
+  }
+
+  CreateVirtualUnionDataset(group_, "data", source_groups, options_);
+  virtual_data_ = true;
+}
+
+MrdFileReader::MrdFileReader(std::string path, bool skip_completed_check)
+    : MrdFileReader(std::move(path), Hdf5Options{}, skip_completed_check) {
+}
+
+MrdFileReader::MrdFileReader(std::string path, Hdf5Options const& options, bool skip_completed_check)
+    : mrd::MrdVisitingReaderBase(skip_completed_check), Hdf5Reader::Hdf5Reader(path, "Mrd", schema_, options, kDenseArraysFormatVersion) {
+  if (format_version_ == kDenseArraysFormatVersion) {
+    dense_arrays_ = std::make_unique<DenseArrayReaders>(group_.openGroup(kDenseArraysGroupName), options_);
+  }
+}
+
+MrdFileReader::~MrdFileReader() = default;
+
+void MrdFileReader::ReadHeaderImpl(std::optional<mrd::Header>& value) {
+  ReadHeaderDataset(group_, value);
+}
+
+uint64_t MrdFileReader::DataSize() {
+  return DataDatasetState().Size();
+}
+
+void MrdFileReader::Seek(uint64_t index) {
+  DataDatasetState().Seek(index);
+}
+
+void MrdFileReader::ReadDataRange(uint64_t begin, uint64_t end, std::vector<mrd::StreamItem>& values) {
+  auto& state = DataDatasetState();
+  if (begin > end || end > state.Size()) {
+    throw std::out_of_range("Invalid range [" + std::to_string(begin) + ", " + std::to_string(end) +
+                            ") of the data stream, which has " + std::to_string(state.Size()) + " items.");
+  }
+
+  state.Seek(begin, end);
+  values.resize(end - begin);
+  for (auto& value : values) {
+    ReadItemImpl(value);
+  }
+}
+
+std::vector<uint64_t> MrdFileReader::SelectPositions(AcquisitionSelection const& selection) {
+  return SelectKeyPositions(KeyTablesState().acquisitions, selection, selection.slice, &AcquisitionKey::slice);
+}
+
+std::vector<uint64_t> MrdFileReader::SelectPositions(ImageSelection const& selection) {
+  return SelectKeyPositions(KeyTablesState().images, selection, selection.image_series_index,
+                            &ImageKey::image_series_index);
+}
+
+void MrdFileReader::Select(AcquisitionSelection const& selection, std::vector<mrd::Acquisition>& values) {
+  auto& state = DataDatasetState();
+  auto positions = SelectPositions(selection);
+  std::vector<hsize_t> rows;
+  for (auto const& entry : state.ReadIndexEntries({positions.begin(), positions.end()})) {
+    rows.push_back(entry.offset_);
+  }
+
+  state.Reader(0).ReadRows<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition>(rows, values);
+  for (size_t i = 0; i < values.size(); i++) {
+    ReadDenseArrays(dense_arrays_.get(), values[i], rows[i]);
+  }
+}
+
+void MrdFileReader::Select(ImageSelection const& selection, std::vector<mrd::StreamItem>& values) {
+  auto& state = DataDatasetState();
+  auto positions = SelectPositions(selection);
+  auto entries = state.ReadIndexEntries({positions.begin(), positions.end()});
+  values.clear();
+  values.resize(entries.size());
+
+  // The rows of each image type and the slots of their items in `values`
+  std::array<std::vector<hsize_t>, 22> rows;
+  std::array<std::vector<size_t>, 22> slots;
+  for (size_t i = 0; i < entries.size(); i++) {
+    rows[entries[i].type_].push_back(entries[i].offset_);
+    slots[entries[i].type_].push_back(i);
+  }
+
+  DenseArrayReaders* dense_arrays = dense_arrays_.get();
+  ReadSelectedImages<mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, 3>(state.Reader(3), dense_arrays, rows[3], slots[3], values);
+  ReadSelectedImages<mrd::hdf5::_Inner_Image<int16_t, int16_t>, 4>(state.Reader(4), dense_arrays, rows[4], slots[4], values);
+  ReadSelectedImages<mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, 5>(state.Reader(5), dense_arrays, rows[5], slots[5], values);
+  ReadSelectedImages<mrd::hdf5::_Inner_Image<int32_t, int32_t>, 6>(state.Reader(6), dense_arrays, rows[6], slots[6], values);
+  ReadSelectedImages<mrd::hdf5::_Inner_Image<float, float>, 7>(state.Reader(7), dense_arrays, rows[7], slots[7], values);
+  ReadSelectedImages<mrd::hdf5::_Inner_Image<double, double>, 8>(state.Reader(8), dense_arrays, rows[8], slots[8], values);
+  ReadSelectedImages<mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, 9>(state.Reader(9), dense_arrays, rows[9], slots[9], values);
+  ReadSelectedImages<mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, 10>(state.Reader(10), dense_arrays, rows[10], slots[10], values);
+}
+
+KeyTables& MrdFileReader::KeyTablesState() {
+  if (!key_tables_) {
+    if (!group_.nameExists(kKeysGroupName)) {
+      throw std::runtime_error("The file has no key tables. They are written with MrdWriterOptions::key_tables.");
+    }
+    key_tables_ = std::make_unique<KeyTables>();
+    key_tables_->Read(group_.openGroup(kKeysGroupName));
+  }
+  return *key_tables_;
+}
+
+UnionDatasetReader<22>& MrdFileReader::DataDatasetState() {
+  if (!data_dataset_state_) {
+    data_dataset_state_ = std::make_unique<UnionDatasetReader<22>>(group_, "data", options_, false, std::make_tuple(mrd::hdf5::GetAcquisitionHdf5Ddl(), "acquisition", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetAcquisitionPrototypeHdf5Ddl(), "acquisitionPrototype", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetWaveformHdf5Ddl<uint32_t, uint32_t>(H5::PredType::NATIVE_UINT32), "waveformUint32", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<uint16_t, uint16_t>(H5::PredType::NATIVE_UINT16), "imageUint16", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<int16_t, int16_t>(H5::PredType::NATIVE_INT16), "imageInt16", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<uint32_t, uint32_t>(H5::PredType::NATIVE_UINT32), "imageUint32", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<int32_t, int32_t>(H5::PredType::NATIVE_INT32), "imageInt32", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<float, float>(H5::PredType::NATIVE_FLOAT), "imageFloat", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<double, double>(H5::PredType::NATIVE_DOUBLE), "imageDouble", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<std::complex<float>, std::complex<float>>(ComplexTypeDdl<float>()), "imageComplexFloat", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageHdf5Ddl<std::complex<double>, std::complex<double>>(ComplexTypeDdl<double>()), "imageComplexDouble", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetAcquisitionBucketHdf5Ddl(), "acquisitionBucket", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetReconDataHdf5Ddl(), "reconData", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(DynamicNDArrayDdl<std::complex<float>, std::complex<float>>(ComplexTypeDdl<float>()), "arrayComplexFloat", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetImageArrayHdf5Ddl(), "imageArray", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetPulseqDefinitionsHdf5Ddl(), "pulseqDefinitions", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(InnerVlenDdl(mrd::hdf5::GetPulseqBlockHdf5Ddl()), "pulseqBlocks", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetPulseqRFEventHdf5Ddl(), "pulseqRfEvent", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetPulseqArbitraryGradientHdf5Ddl(), "pulseqArbitraryGradient", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetPulseqTrapezoidalGradientHdf5Ddl(), "pulseqTrapezoidalGradient", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetPulseqADCEventHdf5Ddl(), "pulseqAdcEvent", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))), std::make_tuple(mrd::hdf5::GetPulseqShapeHdf5Ddl(), "pulseqShape", static_cast<size_t>(std::max(sizeof(::InnerUnion22<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition, mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype, mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32, mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16, mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16, mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32, mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32, mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat, mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble, mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat, mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble, mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket, mrd::hdf5::_Inner_ReconData, mrd::ReconData, InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat, mrd::hdf5::_Inner_ImageArray, mrd::ImageArray, mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions, InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqADCEvent, mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>), sizeof(std::variant<mrd::Acquisition, mrd::AcquisitionPrototype, mrd::WaveformUint32, mrd::ImageUint16, mrd::ImageInt16, mrd::ImageUint32, mrd::ImageInt32, mrd::ImageFloat, mrd::ImageDouble, mrd::ImageComplexFloat, mrd::ImageComplexDouble, mrd::AcquisitionBucket, mrd::ReconData, mrd::ArrayComplexFloat, mrd::ImageArray, mrd::PulseqDefinitions, std::vector<mrd::PulseqBlock>, mrd::PulseqRFEvent, mrd::PulseqArbitraryGradient, mrd::PulseqTrapezoidalGradient, mrd::PulseqADCEvent, mrd::PulseqShape>)))));
+  }
+  return *data_dataset_state_;
+}
+
+bool MrdFileReader::ReadItemImpl(mrd::StreamItem& value) {
+  auto [has_result, type_index, reader] = DataDatasetState().ReadIndex();
+  if (!has_result) {
+    data_dataset_state_.reset();
+    return false;
+  }
+
+  switch (type_index) {
+  case 0: {
+    mrd::Acquisition& ref = value.emplace<0>();
+    reader->Read<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition>(ref);
+    ReadDenseArrays(dense_arrays_.get(), ref, reader->Offset() - 1);
+    break;
+  }
+  case 1: {
+    mrd::AcquisitionPrototype& ref = value.emplace<1>();
+    reader->Read<mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype>(ref);
+    break;
+  }
+  case 2: {
+    mrd::WaveformUint32& ref = value.emplace<2>();
+    reader->Read<mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32>(ref);
+    break;
+  }
+  case 3: {
+    mrd::ImageUint16& ref = value.emplace<3>();
+    reader->Read<mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16>(ref);
+    ReadDenseArrays(dense_arrays_.get(), ref, reader->Offset() - 1);
+    break;
+  }
+  case 4: {
+    mrd::ImageInt16& ref = value.emplace<4>();
+    reader->Read<mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16>(ref);
+    ReadDenseArrays(dense_arrays_.get(), ref, reader->Offset() - 1);
+    break;
+  }
+  case 5: {
+    mrd::ImageUint32& ref = value.emplace<5>();
+    reader->Read<mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32>(ref);
+    ReadDenseArrays(dense_arrays_.get(), ref, reader->Offset() - 1);
+    break;
+  }
+  case 6: {
+    mrd::ImageInt32& ref = value.emplace<6>();
+    reader->Read<mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32>(ref);
+    ReadDenseArrays(dense_arrays_.get(), ref, reader->Offset() - 1);
+    break;
+  }
+  case 7: {
+    mrd::ImageFloat& ref = value.emplace<7>();
+    reader->Read<mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat>(ref);
+    ReadDenseArrays(dense_arrays_.get(), ref, reader->Offset() - 1);
+    break;
+  }
+  case 8: {
+    mrd::ImageDouble& ref = value.emplace<8>();
+    reader->Read<mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble>(ref);
+    ReadDenseArrays(dense_arrays_.get(), ref, reader->Offset() - 1);
+    break;
+  }
+  case 9: {
+    mrd::ImageComplexFloat& ref = value.emplace<9>();
+    reader->Read<mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat>(ref);
+    ReadDenseArrays(dense_arrays_.get(), ref, reader->Offset() - 1);
+    break;
+  }
+  case 10: {
+    mrd::ImageComplexDouble& ref = value.emplace<10>();
+    reader->Read<mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble>(ref);
+    ReadDenseArrays(dense_arrays_.get(), ref, reader->Offset() - 1);
+    break;
+  }
+  case 11: {
+    mrd::AcquisitionBucket& ref = value.emplace<11>();
+    reader->Read<mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket>(ref);
+    break;
+  }
+  case 12: {
+    mrd::ReconData& ref = value.emplace<12>();
+    reader->Read<mrd::hdf5::_Inner_ReconData, mrd::ReconData>(ref);
+    break;
+  }
+  case 13: {
+    mrd::ArrayComplexFloat& ref = value.emplace<13>();
+    reader->Read<InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat>(ref);
+    break;
+  }
+  case 14: {
+    mrd::ImageArray& ref = value.emplace<14>();
+    reader->Read<mrd::hdf5::_Inner_ImageArray, mrd::ImageArray>(ref);
+    break;
+  }
+  case 15: {
+    mrd::PulseqDefinitions& ref = value.emplace<15>();
+    reader->Read<mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions>(ref);
+    break;
+  }
+  case 16: {
+    std::vector<mrd::PulseqBlock>& ref = value.emplace<16>();
+    reader->Read<InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>>(ref);
+    break;
+  }
+  case 17: {
+    mrd::PulseqRFEvent& ref = value.emplace<17>();
+    reader->Read<mrd::PulseqRFEvent, mrd::PulseqRFEvent>(ref);
+    break;
+  }
+  case 18: {
+    mrd::PulseqArbitraryGradient& ref = value.emplace<18>();
+    reader->Read<mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient>(ref);
+    break;
+  }
+  case 19: {
+    mrd::PulseqTrapezoidalGradient& ref = value.emplace<19>();
+    reader->Read<mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient>(ref);
+    break;
+  }
+  case 20: {
+    mrd::PulseqADCEvent& ref = value.emplace<20>();
+    reader->Read<mrd::PulseqADCEvent, mrd::PulseqADCEvent>(ref);
+    break;
+  }
+  case 21: {
+    mrd::PulseqShape& ref = value.emplace<21>();
+    reader->Read<mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>(ref);
+    break;
+  }
+  }
+
+  return true;
+}
+
+bool MrdFileReader::ReadItemImpl(mrd::MrdDataVisitor& visitor) {
+  auto [has_result, type_index, reader] = DataDatasetState().ReadIndex();
+  if (!has_result) {
+    data_dataset_state_.reset();
+    return false;
+  }
+
+  switch (type_index) {
+  case 0: {
+    if (!visitor.Handles(0)) {
+      reader->Skip();
+      break;
+    }
+    mrd::Acquisition value;
+    reader->Read<mrd::hdf5::_Inner_Acquisition, mrd::Acquisition>(value);
+    ReadDenseArrays(dense_arrays_.get(), value, reader->Offset() - 1);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 1: {
+    if (!visitor.Handles(1)) {
+      reader->Skip();
+      break;
+    }
+    mrd::AcquisitionPrototype value;
+    reader->Read<mrd::hdf5::_Inner_AcquisitionPrototype, mrd::AcquisitionPrototype>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 2: {
+    if (!visitor.Handles(2)) {
+      reader->Skip();
+      break;
+    }
+    mrd::WaveformUint32 value;
+    reader->Read<mrd::hdf5::_Inner_Waveform<uint32_t, uint32_t>, mrd::WaveformUint32>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 3: {
+    if (!visitor.Handles(3)) {
+      reader->Skip();
+      break;
+    }
+    mrd::ImageUint16 value;
+    reader->Read<mrd::hdf5::_Inner_Image<uint16_t, uint16_t>, mrd::ImageUint16>(value);
+    ReadDenseArrays(dense_arrays_.get(), value, reader->Offset() - 1);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 4: {
+    if (!visitor.Handles(4)) {
+      reader->Skip();
+      break;
+    }
+    mrd::ImageInt16 value;
+    reader->Read<mrd::hdf5::_Inner_Image<int16_t, int16_t>, mrd::ImageInt16>(value);
+    ReadDenseArrays(dense_arrays_.get(), value, reader->Offset() - 1);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 5: {
+    if (!visitor.Handles(5)) {
+      reader->Skip();
+      break;
+    }
+    mrd::ImageUint32 value;
+    reader->Read<mrd::hdf5::_Inner_Image<uint32_t, uint32_t>, mrd::ImageUint32>(value);
+    ReadDenseArrays(dense_arrays_.get(), value, reader->Offset() - 1);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 6: {
+    if (!visitor.Handles(6)) {
+      reader->Skip();
+      break;
+    }
+    mrd::ImageInt32 value;
+    reader->Read<mrd::hdf5::_Inner_Image<int32_t, int32_t>, mrd::ImageInt32>(value);
+    ReadDenseArrays(dense_arrays_.get(), value, reader->Offset() - 1);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 7: {
+    if (!visitor.Handles(7)) {
+      reader->Skip();
+      break;
+    }
+    mrd::ImageFloat value;
+    reader->Read<mrd::hdf5::_Inner_Image<float, float>, mrd::ImageFloat>(value);
+    ReadDenseArrays(dense_arrays_.get(), value, reader->Offset() - 1);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 8: {
+    if (!visitor.Handles(8)) {
+      reader->Skip();
+      break;
+    }
+    mrd::ImageDouble value;
+    reader->Read<mrd::hdf5::_Inner_Image<double, double>, mrd::ImageDouble>(value);
+    ReadDenseArrays(dense_arrays_.get(), value, reader->Offset() - 1);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 9: {
+    if (!visitor.Handles(9)) {
+      reader->Skip();
+      break;
+    }
+    mrd::ImageComplexFloat value;
+    reader->Read<mrd::hdf5::_Inner_Image<std::complex<float>, std::complex<float>>, mrd::ImageComplexFloat>(value);
+    ReadDenseArrays(dense_arrays_.get(), value, reader->Offset() - 1);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 10: {
+    if (!visitor.Handles(10)) {
+      reader->Skip();
+      break;
+    }
+    mrd::ImageComplexDouble value;
+    reader->Read<mrd::hdf5::_Inner_Image<std::complex<double>, std::complex<double>>, mrd::ImageComplexDouble>(value);
+    ReadDenseArrays(dense_arrays_.get(), value, reader->Offset() - 1);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 11: {
+    if (!visitor.Handles(11)) {
+      reader->Skip();
+      break;
+    }
+    mrd::AcquisitionBucket value;
+    reader->Read<mrd::hdf5::_Inner_AcquisitionBucket, mrd::AcquisitionBucket>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 12: {
+    if (!visitor.Handles(12)) {
+      reader->Skip();
+      break;
+    }
+    mrd::ReconData value;
+    reader->Read<mrd::hdf5::_Inner_ReconData, mrd::ReconData>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 13: {
+    if (!visitor.Handles(13)) {
+      reader->Skip();
+      break;
+    }
+    mrd::ArrayComplexFloat value;
+    reader->Read<InnerDynamicNdArray<std::complex<float>, std::complex<float>>, mrd::ArrayComplexFloat>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 14: {
+    if (!visitor.Handles(14)) {
+      reader->Skip();
+      break;
+    }
+    mrd::ImageArray value;
+    reader->Read<mrd::hdf5::_Inner_ImageArray, mrd::ImageArray>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 15: {
+    if (!visitor.Handles(15)) {
+      reader->Skip();
+      break;
+    }
+    mrd::PulseqDefinitions value;
+    reader->Read<mrd::hdf5::_Inner_PulseqDefinitions, mrd::PulseqDefinitions>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 16: {
+    if (!visitor.Handles(16)) {
+      reader->Skip();
+      break;
+    }
+    std::vector<mrd::PulseqBlock> value;
+    reader->Read<InnerVlen<mrd::PulseqBlock, mrd::PulseqBlock>, std::vector<mrd::PulseqBlock>>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 17: {
+    if (!visitor.Handles(17)) {
+      reader->Skip();
+      break;
+    }
+    mrd::PulseqRFEvent value;
+    reader->Read<mrd::PulseqRFEvent, mrd::PulseqRFEvent>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 18: {
+    if (!visitor.Handles(18)) {
+      reader->Skip();
+      break;
+    }
+    mrd::PulseqArbitraryGradient value;
+    reader->Read<mrd::PulseqArbitraryGradient, mrd::PulseqArbitraryGradient>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 19: {
+    if (!visitor.Handles(19)) {
+      reader->Skip();
+      break;
+    }
+    mrd::PulseqTrapezoidalGradient value;
+    reader->Read<mrd::PulseqTrapezoidalGradient, mrd::PulseqTrapezoidalGradient>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 20: {
+    if (!visitor.Handles(20)) {
+      reader->Skip();
+      break;
+    }
+    mrd::PulseqADCEvent value;
+    reader->Read<mrd::PulseqADCEvent, mrd::PulseqADCEvent>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  case 21: {
+    if (!visitor.Handles(21)) {
+      reader->Skip();
+      break;
+    }
+    mrd::PulseqShape value;
+    reader->Read<mrd::hdf5::_Inner_PulseqShape, mrd::PulseqShape>(value);
+    visitor.Visit(std::move(value));
+    break;
+  }
+  }
+
+  return true;
+}
+
+} // namespace mrd::hdf5
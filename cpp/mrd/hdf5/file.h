@@ -0,0 +1,162 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../data_visitor.h"
+#include "../protocols.h"
+#include "io.h"
+
+namespace mrd::hdf5 {
+// How MrdFileWriter stores the data and trajectory arrays of
+// acquisitions and the data arrays of images.
+enum class ArrayLayout {
+  // As variable-length data within each acquisition or image row.
+  kVariableLength,
+  // In dense N-dimensional datasets under "Mrd/arrays", one per array shape,
+  // leaving the arrays in the rows empty. See dense_arrays.h.
+  kDense,
+};
+
+// Options of MrdFileWriter in addition to Hdf5Options.
+struct MrdWriterOptions {
+  ArrayLayout array_layout{ArrayLayout::kVariableLength};
+
+  // Whether to write tables of the keys of acquisitions and images under
+  // "Mrd/keys", sorted by key, for MrdFileReader::Select().
+  bool key_tables{};
+};
+
+// The half-open range [first, last) of values of a key. A single value
+// converts to the range of that value. `last` is 64-bit so that the range can
+// end after the largest value.
+struct KeyRange {
+  KeyRange(uint32_t value) : first(value), last(uint64_t{value} + 1) {}
+  KeyRange(uint32_t first, uint64_t last) : first(first), last(last) {}
+
+  uint32_t first;
+  uint64_t last;
+};
+
+// Selects acquisitions by their encoding counters and flags. Unset ranges
+// match any value, set ranges do not match acquisitions without the counter.
+// For example, slice 3 of repetitions 10 to 19:
+//   mrd::hdf5::AcquisitionSelection selection;
+//   selection.slice = 3;
+//   selection.repetition = {10, 20};
+struct AcquisitionSelection {
+  std::optional<KeyRange> slice;
+  std::optional<KeyRange> contrast;
+  std::optional<KeyRange> repetition;
+  std::optional<KeyRange> kspace_encode_step_1;
+  std::optional<KeyRange> kspace_encode_step_2;
+  // Flags that must be set, and flags that must not be set.
+  mrd::AcquisitionFlags flags_set{};
+  mrd::AcquisitionFlags flags_clear{};
+};
+
+// Selects images of any type by their series, index and slice.
+struct ImageSelection {
+  std::optional<KeyRange> image_series_index;
+  std::optional<KeyRange> image_index;
+  std::optional<KeyRange> slice;
+};
+
+struct DenseArrayWriters;
+struct DenseArrayReaders;
+struct KeyTables;
+
+// HDF5 writer for the Mrd protocol that adds the array layouts and key tables
+// of MrdWriterOptions, virtual data streams and Hdf5Options to
+// the generated MrdWriter. Files written with the default options can also be
+// read by the generated MrdReader.
+class MrdFileWriter : public mrd::MrdWriterBase, public Hdf5Writer {
+  public:
+  MrdFileWriter(std::string path);
+  MrdFileWriter(std::string path, Hdf5Options const& options);
+  MrdFileWriter(std::string path, ArrayLayout array_layout, Hdf5Options const& options = {});
+  MrdFileWriter(std::string path, MrdWriterOptions const& mrd_options, Hdf5Options const& options = {});
+  ~MrdFileWriter() override;
+
+  void Flush() override;
+
+  // Writes the data stream as the concatenation of the data streams of the
+  // MRD files at `source_paths`, whose items are mapped with HDF5 virtual
+  // datasets rather than copied. Called instead of WriteData(), between
+  // WriteHeader() and EndData(). The source files must have the schema and
+  // header of this file, stay in place and cannot use the dense array layout.
+  // Their key tables are not carried over.
+  void WriteVirtualData(std::vector<std::string> const& source_paths);
+
+  protected:
+  void WriteHeaderImpl(std::optional<mrd::Header> const& value) override;
+  void WriteDataImpl(mrd::StreamItem const& value) override;
+  void WriteDataImpl(std::vector<mrd::StreamItem> const& values) override;
+  void EndDataImpl() override;
+
+  private:
+  UnionDatasetWriter<22>& DataDatasetState();
+  void WriteVirtualDataImpl(std::vector<std::string> const& source_paths);
+
+  std::unique_ptr<UnionDatasetWriter<22>> data_dataset_state_;
+  std::unique_ptr<DenseArrayWriters> dense_arrays_;
+  std::unique_ptr<KeyTables> key_tables_;
+  bool virtual_data_{};
+
+  // The sources of the WriteVirtualData() call in progress, which reach
+  // WriteDataImpl() through the state checks of MrdWriterBase::WriteData().
+  std::vector<std::string> const* virtual_source_paths_ = nullptr;
+};
+
+// HDF5 reader for the Mrd protocol that reads files written by MrdFileWriter
+// or the generated MrdWriter, with random access to the data stream and
+// selection of acquisitions and images by their keys. Items an MrdDataVisitor
+// does not handle are skipped without being read (see mrd::ReadData()).
+class MrdFileReader : public mrd::MrdVisitingReaderBase, public Hdf5Reader {
+  public:
+  MrdFileReader(std::string path, bool skip_completed_check=false);
+  MrdFileReader(std::string path, Hdf5Options const& options, bool skip_completed_check=false);
+  ~MrdFileReader() override;
+
+  // Returns the number of items in the data stream.
+  uint64_t DataSize();
+
+  // Positions the data stream so that the next ReadData() call returns the
+  // item at `index`, resolving its position through the stream's index.
+  // Seeking to DataSize() ends the stream. Once ReadData() has returned
+  // false, the data stream cannot be read again.
+  void Seek(uint64_t index);
+
+  // Reads the items at [begin, end) of the data stream into `values`, with
+  // one read per item type, and leaves the stream positioned at `end`.
+  void ReadDataRange(uint64_t begin, uint64_t end, std::vector<mrd::StreamItem>& values);
+
+  // Returns the positions in the data stream of the acquisitions or images
+  // matching `selection`, in ascending order, using the key tables written
+  // with MrdWriterOptions::key_tables.
+  std::vector<uint64_t> SelectPositions(AcquisitionSelection const& selection);
+  std::vector<uint64_t> SelectPositions(ImageSelection const& selection);
+
+  // Reads the acquisitions or images matching `selection` in stream order,
+  // with one read of the matching rows of each item type. Does not move the
+  // position of the data stream.
+  void Select(AcquisitionSelection const& selection, std::vector<mrd::Acquisition>& values);
+  void Select(ImageSelection const& selection, std::vector<mrd::StreamItem>& values);
+
+  protected:
+  void ReadHeaderImpl(std::optional<mrd::Header>& value) override;
+  bool ReadItemImpl(mrd::StreamItem& value) override;
+  bool ReadItemImpl(mrd::MrdDataVisitor& visitor) override;
+
+  private:
+  UnionDatasetReader<22>& DataDatasetState();
+  KeyTables& KeyTablesState();
+
+  std::unique_ptr<UnionDatasetReader<22>> data_dataset_state_;
+  std::unique_ptr<DenseArrayReaders> dense_arrays_;
+  std::unique_ptr<KeyTables> key_tables_;
+};
+
+} // namespace mrd::hdf5
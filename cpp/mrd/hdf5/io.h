@@ -0,0 +1,1406 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+// The HDF5 runtime of MrdFileWriter and MrdFileReader (file.h), extending
+// the one yardl generates under yardl/detail/hdf5 with batched and SWMR
+// writing, read-ahead, random access and virtual datasets. The generated
+// hdf5/protocols.cc keeps using the yardl runtime.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <H5Cpp.h>
+
+#include "../byte_size.h"
+#include "chunk_codec.h"
+#include "ddl.h"
+
+namespace mrd::hdf5 {
+// Datasets size their batches and chunks with the yardl::ByteSize()
+// overloads, and those found by argument-dependent lookup.
+using yardl::ByteSize;
+
+// To be incremented when we make a structural change to the
+// way we store data in an HDF5 file
+static const inline uint32_t kHdf5FormatVersionNumber = 1;
+static const inline std::string kHdf5FormatVersionNumberAttributeName = "$yardl_format_version";
+
+static const inline std::string kSchemaDatasetName = "$yardl_schema";
+
+// The number of index entries of a stream committed by a SWMR writer,
+// followed by whether the stream has ended.
+static const inline std::string kUnionCommitDatasetName = "$commit";
+
+template <typename TInner, typename TOuter>
+static inline void WriteScalarDataset(H5::Group const& group, std::string name,
+                                      H5::DataType const& hdf5_type, TOuter const& value) {
+  H5::DataSpace dataspace;
+  auto dataset = group.createDataSet(name, hdf5_type, dataspace);
+
+  if constexpr (std::is_same_v<TInner, TOuter>) {
+    dataset.write(&value, hdf5_type);
+  } else {
+    TInner inner_value(value);
+    dataset.write(&inner_value, hdf5_type);
+  }
+}
+
+template <typename TInner, typename TOuter>
+static inline void ReadScalarDataset(H5::Group const& group, std::string name,
+                                     H5::DataType const& hdf5_type, TOuter& value) {
+  auto dataset = group.openDataSet(name);
+  H5::DataSpace dataspace;
+  if constexpr (std::is_same_v<TInner, TOuter>) {
+    dataset.read(&value, hdf5_type, dataspace, dataspace);
+  } else {
+    TInner inner_value;
+    dataset.read(&inner_value, hdf5_type, dataspace, dataspace, VlenTransferProperties());
+    inner_value.ToOuter(value);
+  }
+}
+
+/**
+ * Chunking and chunk cache settings of a dataset. Sizes of 0 are chosen
+ * automatically.
+ */
+struct DatasetOptions {
+  size_t chunk_bytes{};
+  size_t chunk_cache_bytes{};
+  size_t chunk_cache_slots{};
+  ChunkFilters filters{};
+  size_t compression_threads{};
+};
+
+/**
+ * Tuning options for the files and datasets of HDF5 writers and readers.
+ * Sizes of 0 keep the defaults: chunk sizes are then tuned from the size of
+ * the first rows written to each dataset, and chunk caches hold at least two
+ * chunks.
+ */
+struct Hdf5Options {
+  // Size in bytes of the chunks of datasets.
+  size_t chunk_bytes{};
+
+  // Chunk sizes of individual datasets by name, such as "$index" or
+  // "acquisition", overriding chunk_bytes.
+  std::map<std::string, size_t> dataset_chunk_bytes;
+
+  // Size and number of hash table slots of each dataset's chunk cache
+  // (H5Pset_chunk_cache).
+  size_t chunk_cache_bytes{};
+  size_t chunk_cache_slots{};
+
+  // Initial size of the file's metadata cache (H5Pset_mdc_config).
+  size_t metadata_cache_bytes{};
+
+  // When writing, allocates file space in pages of this size
+  // (H5Pset_file_space_strategy with H5F_FSPACE_STRATEGY_PAGE), so that
+  // metadata and small raw data are grouped together.
+  size_t file_space_page_bytes{};
+
+  // Size of the page buffer (H5Pset_page_buffer_size). It is only used for
+  // files written with file_space_page_bytes set.
+  size_t page_buffer_bytes{};
+
+  // Compression of datasets with fixed-size elements. Chunks of dense arrays
+  // are compressed on a pool of threads and written with H5Dwrite_chunk.
+  // Datasets of rows without variable-length fields, such as indexes, are
+  // compressed with deflate by HDF5's filter pipeline. Variable-length data
+  // is not compressed.
+  Compression compression{Compression::kNone};
+
+  // The compression level, or -1 for the default of the compression.
+  int compression_level{-1};
+
+  // Whether to shuffle the bytes of elements before compressing them.
+  bool shuffle{true};
+
+  // The maximum number of chunks of a dataset compressed or decompressed at
+  // a time, or 0 for the number of hardware threads.
+  size_t compression_threads{};
+
+  // Single-writer/multiple-reader access, so that a file can be read while it
+  // is written by another process. Writers create all datasets of a stream
+  // when its first item is written, then start SWMR writing and commit the
+  // items written so far to readers on Flush() and every swmr_flush_interval.
+  // HDF5 supports SWMR only for appending rows of fixed size, so writers
+  // reject items with variable-length data, such as vectors and strings.
+  // Readers wait for more items at the end of the stream until the writer
+  // ends it, checking every swmr_poll_interval and giving up after
+  // swmr_timeout without new items (0 waits indefinitely).
+  bool swmr{};
+  std::chrono::milliseconds swmr_flush_interval{1000};
+  std::chrono::milliseconds swmr_poll_interval{100};
+  std::chrono::milliseconds swmr_timeout{60000};
+
+  DatasetOptions ForDataset(std::string const& name) const {
+    auto it = dataset_chunk_bytes.find(name);
+    ChunkFilters filters;
+    if (compression != Compression::kNone) {
+      filters.shuffle = shuffle;
+      filters.compression = compression;
+      filters.level = compression_level >= 0 ? compression_level : (compression == Compression::kDeflate ? 1 : 3);
+    }
+    return {it != dataset_chunk_bytes.end() ? it->second : chunk_bytes, chunk_cache_bytes, chunk_cache_slots,
+            filters, compression_threads};
+  }
+};
+
+// Automatically sized chunks hold about kAutoChunkBytes of rows and their
+// variable-length data, but at least kMinAutoChunkBytes and at most
+// kAutoChunkBytes of rows in the dataset itself, so that chunks of small rows
+// such as index entries fit in the chunk cache, while chunks of rows with
+// large arrays, such as images, are not made of a handful of rows.
+static constexpr size_t kAutoChunkBytes = 1024 * 1024;
+static constexpr size_t kMinAutoChunkBytes = 64 * 1024;
+
+// HDF5's default chunk cache size, and a prime number of hash table slots
+// for caches holding many small chunks.
+static constexpr size_t kDefaultChunkCacheBytes = 1024 * 1024;
+static constexpr size_t kDefaultChunkCacheSlots = 12421;
+
+/**
+ * Returns the number of rows of `row_bytes` per chunk, given the average
+ * size in bytes of the items stored in the rows, including any
+ * variable-length data.
+ */
+static inline hsize_t ChunkRows(DatasetOptions const& options, size_t row_bytes, size_t item_bytes) {
+  row_bytes = std::max(row_bytes, static_cast<size_t>(1));
+  if (options.chunk_bytes != 0) {
+    return std::max(static_cast<size_t>(1), options.chunk_bytes / row_bytes);
+  }
+
+  size_t rows = kAutoChunkBytes / std::max(item_bytes, row_bytes);
+  return std::clamp(rows, std::max(static_cast<size_t>(1), kMinAutoChunkBytes / row_bytes),
+                    std::max(static_cast<size_t>(1), kAutoChunkBytes / row_bytes));
+}
+
+/**
+ * Returns access properties with a chunk cache for chunks of `chunk_bytes`.
+ * Rows are written and read in order, so fully written or read chunks are
+ * evicted first.
+ */
+static inline H5::DSetAccPropList ChunkCacheProperties(DatasetOptions const& options, size_t chunk_bytes) {
+  size_t cache_bytes = options.chunk_cache_bytes != 0
+                           ? options.chunk_cache_bytes
+                           : std::max(kDefaultChunkCacheBytes, 2 * chunk_bytes);
+  size_t cache_slots = options.chunk_cache_slots != 0 ? options.chunk_cache_slots : kDefaultChunkCacheSlots;
+
+  H5::DSetAccPropList properties;
+  properties.setChunkCache(cache_slots, cache_bytes, 1.0);
+  return properties;
+}
+
+class TransferPropertiesContainer {
+ public:
+  TransferPropertiesContainer(size_t buffer_size)
+      : buffer_(buffer_size), background_buffer_(buffer_size) {
+    properties_.setBuffer(buffer_size, buffer_.data(), background_buffer_.data());
+    SetVlenMemoryManager(properties_);
+  }
+
+  TransferPropertiesContainer(TransferPropertiesContainer const&) = delete;
+
+  H5::DSetMemXferPropList const& properties() const {
+    return properties_;
+  }
+
+ private:
+  H5::DSetMemXferPropList properties_{};
+  std::vector<uint8_t> buffer_;
+  std::vector<uint8_t> background_buffer_;
+};
+
+/**
+ * Rows in their HDF5 representation: rows appended to a DatasetWriter but
+ * not yet written to the file, or rows read ahead by a DatasetReader.
+ */
+class RowBufferBase {
+ public:
+  virtual ~RowBufferBase() = default;
+
+  virtual void const* data() const = 0;
+  virtual size_t size() const = 0;
+  virtual size_t capacity() const = 0;
+  virtual void clear() = 0;
+};
+
+template <typename TInner>
+class RowBuffer : public RowBufferBase {
+ public:
+  explicit RowBuffer(size_t capacity) : data_(capacity * sizeof(TInner)) {
+  }
+
+  RowBuffer(RowBuffer const&) = delete;
+  RowBuffer& operator=(RowBuffer const&) = delete;
+
+  ~RowBuffer() override {
+    clear();
+  }
+
+  template <typename TOuter>
+  void push_back(TOuter const& value) {
+    new (reinterpret_cast<TInner*>(data_.data()) + size_) TInner(value);
+    size_++;
+  }
+
+  // Replaces the rows with `count` empty rows for HDF5 to read into.
+  TInner* reset_for_read(size_t count) {
+    clear();
+    if (count > capacity()) {
+      data_.resize(count * sizeof(TInner));
+    }
+    std::memset(data_.data(), 0, count * sizeof(TInner));
+    size_ = count;
+    return reinterpret_cast<TInner*>(data_.data());
+  }
+
+  TInner const& operator[](size_t index) const {
+    return reinterpret_cast<TInner const*>(data_.data())[index];
+  }
+
+  void const* data() const override {
+    return data_.data();
+  }
+
+  size_t size() const override {
+    return size_;
+  }
+
+  size_t capacity() const override {
+    return data_.size() / sizeof(TInner);
+  }
+
+  void clear() override {
+    if constexpr (!std::is_trivially_destructible_v<TInner>) {
+      auto p = reinterpret_cast<TInner*>(data_.data());
+      for (size_t i = 0; i < size_; i++) {
+        (p + i)->~TInner();
+      }
+    }
+    size_ = 0;
+  }
+
+ private:
+  std::vector<uint8_t> data_;
+  size_t size_{};
+};
+
+class DatasetWriter {
+ public:
+  // Limits on the rows held by AppendBuffered before they are written.
+  static constexpr size_t kMaxBufferedRows = 4096;
+  static constexpr size_t kMaxBufferedBytes = 16 * 1024 * 1024;
+
+  /**
+   * The dataset is created when the first rows are written, or on Create(),
+   * so that its chunk size can be chosen from the size of those rows.
+   */
+  DatasetWriter(H5::Group const& group, std::string name,
+                H5::DataType const& element_type, size_t conversion_buffer_size,
+                DatasetOptions const& options = {})
+      : group_(group), name_(std::move(name)), element_type_(element_type), options_(options) {
+    hsize_t rows_at_a_time = 1;
+    mem_space_ = H5::DataSpace(1, &rows_at_a_time, NULL);
+    if (conversion_buffer_size > 0) {
+      transfer_properties_.emplace(conversion_buffer_size);
+    }
+  }
+
+  template <typename TInner, typename TOuter>
+  hsize_t Append(TOuter const& value) {
+    Flush();
+    H5::DataSet& dataset = Dataset(element_type_.getSize() + ByteSize(value));
+    hsize_t new_size = offset_ + 1;
+    dataset.extend(&new_size);
+
+    H5::DataSpace fileSpace = dataset.getSpace();
+    fileSpace.selectElements(H5S_SELECT_SET, 1, &offset_);
+
+    if constexpr (std::is_same_v<TInner, TOuter>) {
+      dataset.write(&value, element_type_, mem_space_, fileSpace);
+    } else {
+      TInner inner_value(value);
+      dataset.write(&inner_value, element_type_, mem_space_, fileSpace, transfer_properties());
+    }
+
+    return offset_++;
+  }
+
+  template <typename TInner, typename TOuter>
+  hsize_t AppendBatch(std::vector<TOuter> const& value) {
+    Flush();
+    if (!dataset_ && !value.empty()) {
+      size_t payload_bytes = 0;
+      for (auto const& v : value) {
+        payload_bytes += ByteSize(v);
+      }
+      Dataset(element_type_.getSize() + payload_bytes / value.size());
+    }
+    if constexpr (std::is_same_v<TInner, TOuter>) {
+      WriteRows(value.data(), value.size(), false);
+    } else {
+      InnerTypeBuffer<TInner, TOuter> inner_value(value);
+      WriteRows(inner_value.data(), value.size(), true);
+    }
+
+    auto initial_offset = offset_;
+    offset_ += value.size();
+    return initial_offset;
+  }
+
+  /**
+   * Like Append, but holds the converted row in memory, to be written
+   * together with the rows appended after it in a single hyperslab once
+   * kMaxBufferedRows or kMaxBufferedBytes is reached, or on Flush().
+   * All rows appended to a dataset with AppendBuffered must have the
+   * same TInner type. Returns the row's offset in the dataset.
+   */
+  template <typename TInner, typename TOuter>
+  hsize_t AppendBuffered(TOuter const& value) {
+    if (!row_buffer_) {
+      size_t max_rows = std::max(static_cast<size_t>(1),
+                                 std::min(kMaxBufferedRows, kMaxBufferedBytes / sizeof(TInner)));
+      row_buffer_ = std::make_unique<RowBuffer<TInner>>(max_rows);
+      rows_need_conversion_ = !std::is_same_v<TInner, TOuter>;
+    }
+
+    auto& rows = static_cast<RowBuffer<TInner>&>(*row_buffer_);
+    rows.push_back(value);
+    buffered_bytes_ += sizeof(TInner) + ByteSize(value);
+
+    hsize_t offset = offset_ + rows.size() - 1;
+    if (rows.size() == rows.capacity() || buffered_bytes_ >= kMaxBufferedBytes) {
+      Flush();
+    }
+    return offset;
+  }
+
+  std::string const& Name() const {
+    return name_;
+  }
+
+  // Closes the dataset and its group, so that their file can be reopened.
+  void Close() {
+    dataset_.reset();
+    group_.close();
+  }
+
+  // Reopens the dataset, created before Close(), in the reopened group.
+  void Reopen(H5::Group const& group) {
+    group_.setId(group.getId());
+    dataset_ = group_.openDataSet(name_, ChunkCacheProperties(options_, chunk_bytes_));
+  }
+
+  // Whether rows hold variable-length data, which is stored outside the dataset.
+  bool HasVariableLengthData() const {
+    // Also true for variable-length strings
+    return H5Tdetect_class(element_type_.getId(), H5T_VLEN) > 0;
+  }
+
+  // Creates the dataset if no rows have been written to it yet.
+  void Create() {
+    Dataset(element_type_.getSize());
+  }
+
+  // Writes the rows held by AppendBuffered. Does not create the dataset when
+  // there are none, so that it can still be sized from the rows that follow.
+  void Flush() {
+    if (!row_buffer_ || row_buffer_->size() == 0) {
+      return;
+    }
+
+    hsize_t row_count = row_buffer_->size();
+    Dataset(buffered_bytes_ / row_count);
+    WriteRows(row_buffer_->data(), row_count, rows_need_conversion_);
+    row_buffer_->clear();
+    buffered_bytes_ = 0;
+    offset_ += row_count;
+  }
+
+ private:
+  // Returns the dataset, creating it with chunks sized for items of the given size.
+  H5::DataSet& Dataset(size_t item_bytes) {
+    if (dataset_) {
+      return *dataset_;
+    }
+
+    hsize_t dims = 0;
+    hsize_t maxdims = H5S_UNLIMITED;
+
+    // Because we do not know the dataset size up-front, we need to enable chunking.
+    size_t row_bytes = element_type_.getSize();
+    hsize_t chunk_dims = ChunkRows(options_, row_bytes, item_bytes);
+
+    H5::DataSpace dataspace(1, &dims, &maxdims);
+
+    H5::DSetCreatPropList prop;
+    prop.setChunk(1, &chunk_dims);
+    if (options_.filters.compression != Compression::kNone &&
+        !element_type_.detectClass(H5T_VLEN) && !element_type_.detectClass(H5T_STRING)) {
+      ChunkFilters filters = options_.filters;
+      if (filters.compression != Compression::kDeflate) {
+        filters.compression = Compression::kDeflate;
+        filters.level = 1;
+      }
+      filters.Apply(prop);
+    }
+    chunk_bytes_ = chunk_dims * row_bytes;
+    dataset_ = group_.createDataSet(name_, element_type_, dataspace, prop,
+                                    ChunkCacheProperties(options_, chunk_bytes_));
+    return *dataset_;
+  }
+
+  // Writes rows at the current offset in a single hyperslab, without advancing it.
+  void WriteRows(void const* rows, hsize_t row_count, bool convert) {
+    if (row_count == 0) {
+      return;
+    }
+
+    H5::DataSet& dataset = *dataset_;
+    hsize_t new_size = offset_ + row_count;
+    dataset.extend(&new_size);
+    H5::DataSpace fileSpace = dataset.getSpace();
+
+    fileSpace.selectHyperslab(H5S_SELECT_SET, &row_count, &offset_);
+    H5::DataSpace mem_space(1, &row_count, NULL);
+
+    if (convert) {
+      dataset.write(rows, element_type_, mem_space, fileSpace, transfer_properties());
+    } else {
+      dataset.write(rows, element_type_, mem_space, fileSpace);
+    }
+  }
+
+  H5::DSetMemXferPropList const& transfer_properties() const {
+    return transfer_properties_.has_value()
+               ? transfer_properties_.value().properties()
+               : VlenTransferProperties();
+  }
+
+  H5::Group group_;
+  std::string name_;
+  std::optional<H5::DataSet> dataset_;
+  size_t chunk_bytes_{};
+  H5::DataType element_type_;
+  DatasetOptions options_;
+  hsize_t offset_{};
+  H5::DataSpace mem_space_;
+  std::optional<TransferPropertiesContainer> transfer_properties_;
+  std::unique_ptr<RowBufferBase> row_buffer_;
+  size_t buffered_bytes_{};
+  bool rows_need_conversion_{};
+};
+
+class DatasetReader {
+ public:
+  DatasetReader(H5::Group const& group, std::string name,
+                H5::DataType const& element_type, size_t conversion_buffer_size = 0,
+                DatasetOptions const& options = {})
+      : dataset_(OpenDataset(group, name, options)),
+        element_type_(element_type),
+        filespace_(dataset_.getSpace()) {
+    filespace_.getSimpleExtentDims(&total_rows_);
+    if (conversion_buffer_size > 0) {
+      transfer_properties_.emplace(std::max(static_cast<size_t>(conversion_buffer_size),
+                                            dataset_.getDataType().getSize()));
+    }
+  }
+
+  // Limits on the rows read ahead by Read. The number of rows read at a time
+  // adapts to the size of the rows read so far.
+  static constexpr size_t kInitialReadAheadRows = 16;
+  static constexpr size_t kMaxReadAheadRows = 4096;
+  static constexpr size_t kMaxReadAheadBytes = 16 * 1024 * 1024;
+
+  // The most runs of rows that ReadRows selects as a union of hyperslabs.
+  static constexpr size_t kMaxSelectedRuns = 64;
+
+  /**
+   * Reads the next row. Rows are read ahead with a single hyperslab read
+   * and then served from memory. All rows read with Read must have the
+   * same TInner type.
+   */
+  template <typename TInner, typename TOuter>
+  bool Read(TOuter& value) {
+    if (offset_ >= total_rows_) {
+      return false;
+    }
+
+    if (!read_ahead_rows_) {
+      read_ahead_rows_ = std::make_unique<RowBuffer<TInner>>(0);
+    }
+    auto& rows = static_cast<RowBuffer<TInner>&>(*read_ahead_rows_);
+    if (offset_ < read_ahead_offset_ || offset_ >= read_ahead_offset_ + rows.size()) {
+      ReadAhead(rows);
+    }
+
+    auto const& inner_value = rows[offset_ - read_ahead_offset_];
+    mrd::hdf5::ToOuter(inner_value, value);
+    read_ahead_bytes_ += sizeof(TInner) + ByteSize(value);
+    read_ahead_served_++;
+
+    offset_++;
+    return true;
+  }
+
+  // Returns the position of the next row to be read.
+  hsize_t Offset() const {
+    return offset_;
+  }
+
+  // Returns the number of rows in the dataset.
+  hsize_t Size() const {
+    return total_rows_;
+  }
+
+  // Reloads the dataset and its size, which grows while a SWMR writer
+  // appends to it, reading at most max_rows rows.
+  void Refresh(hsize_t max_rows = std::numeric_limits<hsize_t>::max()) {
+    if (H5Drefresh(dataset_.getId()) < 0) {
+      throw std::runtime_error("Unable to refresh the HDF5 dataset '" + dataset_.getObjName() + "'.");
+    }
+    filespace_ = dataset_.getSpace();
+    filespace_.getSimpleExtentDims(&total_rows_);
+    total_rows_ = std::min(total_rows_, max_rows);
+  }
+
+  /**
+   * Positions the reader at row `offset`. After a jump outside of the rows
+   * read ahead, the read-ahead window starts small again.
+   */
+  void Seek(hsize_t offset) {
+    if (offset == offset_) {
+      return;
+    }
+
+    offset_ = offset;
+    if (read_ahead_rows_ &&
+        (offset_ < read_ahead_offset_ || offset_ >= read_ahead_offset_ + read_ahead_rows_->size())) {
+      read_ahead_bytes_ = 0;
+      read_ahead_served_ = 0;
+    }
+  }
+
+  /**
+   * Makes the read-ahead windows end at row `end`, and sizes the first of
+   * them from the rows read before rather than starting small, so that a
+   * known range of rows is read with as few hyperslab reads as
+   * kMaxReadAheadRows and kMaxReadAheadBytes allow.
+   */
+  void ReadAheadTo(hsize_t end) {
+    read_ahead_end_ = end;
+  }
+
+  // Advances past the next row without reading it.
+  bool Skip() {
+    if (offset_ >= total_rows_) {
+      return false;
+    }
+
+    offset_++;
+    return true;
+  }
+
+  template <typename TInner, typename TOuter>
+  bool ReadBatch(std::vector<TOuter>& values) {
+    if (offset_ >= total_rows_) {
+      return false;
+    }
+
+    hsize_t rows_to_read = std::min(total_rows_ - offset_, static_cast<hsize_t>(values.capacity()));
+    if (rows_to_read != values.size()) {
+      values.resize(rows_to_read);
+    }
+
+    H5::DataSpace memspace(1, &rows_to_read, NULL);
+    filespace_.selectHyperslab(H5S_SELECT_SET, &rows_to_read, &offset_);
+
+    if constexpr (std::is_same_v<TInner, TOuter>) {
+      dataset_.read(values.data(), element_type_, memspace, filespace_);
+    } else {
+      InnerTypeBuffer<TInner, TOuter> inner_value(values.size());
+      dataset_.read(inner_value.data(), element_type_, memspace, filespace_, transfer_properties());
+
+      auto i_iter = inner_value.begin();
+      auto o_iter = values.begin();
+
+      while (i_iter != inner_value.end()) {
+        i_iter->ToOuter(*o_iter);
+        ++i_iter;
+        ++o_iter;
+      }
+    }
+
+    offset_ += rows_to_read;
+    return offset_ < total_rows_;
+  }
+
+  /**
+   * Reads the given rows, in ascending order, with one read of the union of
+   * their runs for every kMaxReadAheadRows rows. Does not move the position
+   * of the reader.
+   */
+  template <typename TInner, typename TOuter>
+  void ReadRows(std::vector<hsize_t> const& rows, std::vector<TOuter>& values) {
+    values.resize(rows.size());
+    for (size_t first = 0; first < rows.size(); first += kMaxReadAheadRows) {
+      size_t count = std::min(rows.size() - first, kMaxReadAheadRows);
+      ReadRows<TInner, TOuter>(rows.data() + first, count, values.data() + first);
+    }
+  }
+
+ private:
+  // Opens the dataset with a chunk cache sized for its chunks.
+  static H5::DataSet OpenDataset(H5::Group const& group, std::string const& name, DatasetOptions const& options) {
+    H5::DataSet dataset = group.openDataSet(name);
+    H5::DSetCreatPropList prop = dataset.getCreatePlist();
+    if (prop.getLayout() != H5D_CHUNKED) {
+      return dataset;
+    }
+
+    hsize_t chunk_rows = 0;
+    prop.getChunk(1, &chunk_rows);
+    size_t chunk_bytes = chunk_rows * dataset.getDataType().getSize();
+    return group.openDataSet(name, ChunkCacheProperties(options, chunk_bytes));
+  }
+
+  H5::DSetMemXferPropList const& transfer_properties() const {
+    return transfer_properties_.has_value()
+               ? transfer_properties_.value().properties()
+               : VlenTransferProperties();
+  }
+
+  template <typename TInner, typename TOuter>
+  void ReadRows(hsize_t const* rows, size_t count, TOuter* values) {
+    std::vector<std::pair<hsize_t, hsize_t>> runs;
+    for (size_t i = 0; i < count; i++) {
+      if (!runs.empty() && rows[i] == runs.back().first + runs.back().second) {
+        runs.back().second++;
+      } else {
+        runs.push_back({rows[i], 1});
+      }
+    }
+
+    // Combining hyperslabs gets slow with many of them, so scattered rows
+    // are selected as points instead.
+    H5::DataSpace filespace(filespace_);
+    if (runs.size() > kMaxSelectedRuns) {
+      filespace.selectElements(H5S_SELECT_SET, count, rows);
+    } else {
+      filespace.selectNone();
+      for (auto const& [start, run_count] : runs) {
+        filespace.selectHyperslab(H5S_SELECT_OR, &run_count, &start);
+      }
+    }
+
+    hsize_t rows_to_read = count;
+    H5::DataSpace memspace(1, &rows_to_read, NULL);
+    if constexpr (std::is_same_v<TInner, TOuter>) {
+      dataset_.read(values, element_type_, memspace, filespace);
+    } else {
+      InnerTypeBuffer<TInner, TOuter> inner_value(count);
+      dataset_.read(inner_value.data(), element_type_, memspace, filespace, transfer_properties());
+
+      for (auto const& inner : inner_value) {
+        inner.ToOuter(*values++);
+      }
+    }
+  }
+
+  template <typename TInner>
+  void ReadAhead(RowBuffer<TInner>& rows) {
+    // Sizes the window from the rows served from the previous one, or
+    // within a range, from those served before
+    if (read_ahead_served_ > 0) {
+      average_row_bytes_ = std::max(sizeof(TInner), read_ahead_bytes_ / read_ahead_served_);
+    }
+    bool in_range = read_ahead_end_ > offset_;
+    size_t row_count = kInitialReadAheadRows;
+    if (average_row_bytes_ > 0 && (read_ahead_served_ > 0 || in_range)) {
+      row_count = std::clamp(kMaxReadAheadBytes / average_row_bytes_, static_cast<size_t>(1), kMaxReadAheadRows);
+    }
+    if (in_range) {
+      row_count = static_cast<size_t>(std::min(read_ahead_end_ - offset_, static_cast<hsize_t>(row_count)));
+    } else {
+      read_ahead_end_ = 0;
+    }
+    hsize_t rows_to_read = std::min(total_rows_ - offset_, static_cast<hsize_t>(row_count));
+
+    TInner* data = rows.reset_for_read(rows_to_read);
+    H5::DataSpace memspace(1, &rows_to_read, NULL);
+    filespace_.selectHyperslab(H5S_SELECT_SET, &rows_to_read, &offset_);
+    dataset_.read(data, element_type_, memspace, filespace_, transfer_properties());
+
+    read_ahead_offset_ = offset_;
+    read_ahead_bytes_ = 0;
+    read_ahead_served_ = 0;
+  }
+
+  H5::DataSet dataset_;
+  H5::DataType element_type_;
+  H5::DataSpace filespace_;
+  hsize_t offset_{};
+  hsize_t total_rows_;
+  std::optional<TransferPropertiesContainer> transfer_properties_;
+  std::unique_ptr<RowBufferBase> read_ahead_rows_;
+  hsize_t read_ahead_offset_{};
+  size_t read_ahead_bytes_{};
+  size_t read_ahead_served_{};
+  size_t average_row_bytes_{};
+  hsize_t read_ahead_end_{};
+};
+
+/**
+ * Returns file access properties with the metadata cache and page buffer
+ * sizes of the given options.
+ */
+static inline H5::FileAccPropList FileAccessProperties(Hdf5Options const& options, bool page_buffer) {
+  H5::FileAccPropList properties;
+  if (options.metadata_cache_bytes != 0) {
+    H5AC_cache_config_t config;
+    config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+    if (H5Pget_mdc_config(properties.getId(), &config) < 0) {
+      throw std::runtime_error("Unable to get the HDF5 metadata cache configuration.");
+    }
+    config.set_initial_size = true;
+    config.initial_size = options.metadata_cache_bytes;
+    config.max_size = std::max(config.max_size, config.initial_size);
+    config.min_size = std::min(config.min_size, config.initial_size);
+    if (H5Pset_mdc_config(properties.getId(), &config) < 0) {
+      throw std::runtime_error("Unable to set the HDF5 metadata cache size.");
+    }
+  }
+  if (page_buffer && options.page_buffer_bytes != 0) {
+    if (H5Pset_page_buffer_size(properties.getId(), options.page_buffer_bytes, 0, 0) < 0) {
+      throw std::runtime_error("Unable to set the HDF5 page buffer size.");
+    }
+  }
+  if (options.swmr) {
+    // SWMR requires the file format of HDF5 1.10 or later
+    properties.setLibverBounds(H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+  }
+  return properties;
+}
+
+/**
+ * Opens an existing file. Opening a file with a page buffer fails unless it
+ * was written with paged aggregation, so other files are opened without one.
+ */
+static inline H5::H5File OpenFile(std::string const& path, unsigned int flags, Hdf5Options const& options) {
+  H5::H5File file(path, flags, H5::FileCreatPropList::DEFAULT, FileAccessProperties(options, false));
+  if (options.page_buffer_bytes == 0) {
+    return file;
+  }
+
+  H5F_fspace_strategy_t strategy;
+  hbool_t persist;
+  hsize_t threshold;
+  if (H5Pget_file_space_strategy(file.getCreatePlist().getId(), &strategy, &persist, &threshold) < 0 ||
+      strategy != H5F_FSPACE_STRATEGY_PAGE) {
+    return file;
+  }
+
+  file.close();
+  return H5::H5File(path, flags, H5::FileCreatPropList::DEFAULT, FileAccessProperties(options, true));
+}
+
+template <size_t N>
+class UnionDatasetWriter {
+ public:
+  template <typename... TypeLabelBufferSizeTuples>
+  UnionDatasetWriter(H5::Group const& parent_group, std::string name, bool nullable,
+                     TypeLabelBufferSizeTuples const&... type_label_buffer_size_tuples)
+      : UnionDatasetWriter(parent_group, std::move(name), Hdf5Options{}, nullable, type_label_buffer_size_tuples...) {}
+
+  template <typename... TypeLabelBufferSizeTuples>
+  UnionDatasetWriter(H5::Group const& parent_group, std::string name, Hdf5Options const& options,
+                     bool nullable, TypeLabelBufferSizeTuples const&... type_label_buffer_size_tuples)
+      : group_(CreateGroup(parent_group, name)),
+        index_writer_(
+            group_, "$index",
+            UnionIndexDatasetElementTypeDdl(
+                UnionTypeEnumDdl(nullable, std::get<1>(type_label_buffer_size_tuples)...)),
+            0, options.ForDataset("$index")),
+        writers_{DatasetWriter{group_,
+                               std::get<1>(type_label_buffer_size_tuples),
+                               std::get<0>(type_label_buffer_size_tuples),
+                               std::get<2>(type_label_buffer_size_tuples),
+                               options.ForDataset(std::get<1>(type_label_buffer_size_tuples))}...},
+        options_(options) {
+    index_entry_buffer_.reserve(8192);
+
+    // No datasets can be created once SWMR writing has started, so all of
+    // them are created up-front, along with the commit record.
+    if (options.swmr) {
+      CreateDatasets();
+      hsize_t commit_size = 2;
+      commit_dataset_ = group_.createDataSet(kUnionCommitDatasetName, H5::PredType::NATIVE_UINT64,
+                                             H5::DataSpace(1, &commit_size));
+    }
+  }
+
+  ~UnionDatasetWriter() {
+    Flush();
+    CreateDatasets();
+    if (commit_dataset_) {
+      Commit(true);
+    }
+  }
+
+  // Writes the buffered rows of each type, then their index entries, and
+  // commits them for SWMR readers. The datasets of types without rows are
+  // only created once the stream ends, so that those written later are still
+  // sized from their first rows.
+  void Flush() {
+    for (auto& writer : writers_) {
+      writer.Flush();
+    }
+    if (!index_entry_buffer_.empty()) {
+      index_writer_.AppendBatch<IndexEntry, IndexEntry>(index_entry_buffer_);
+      index_rows_ += index_entry_buffer_.size();
+      index_entry_buffer_.clear();
+    }
+    if (commit_dataset_) {
+      Commit(false);
+    }
+  }
+
+  template <typename TElementInner, typename TElementOuter>
+  void Append(int8_t type, TElementOuter const& value) {
+    uint64_t offset;
+    if (type == -1) {
+      offset = 0;
+    } else {
+      DatasetWriter& ds = writers_[type];
+      if (commit_dataset_ && ds.HasVariableLengthData()) {
+        throw std::runtime_error("SWMR writing does not support items with variable-length data, such as '" +
+                                 ds.Name() + "' items.");
+      }
+      offset = static_cast<uint64_t>(ds.AppendBuffered<TElementInner, TElementOuter>(value));
+    }
+
+    index_entry_buffer_.push_back({type, offset});
+    if (index_entry_buffer_.size() == index_entry_buffer_.capacity()) {
+      Flush();
+    }
+
+    if (commit_dataset_ && std::chrono::steady_clock::now() - last_commit_ >= options_.swmr_flush_interval) {
+      Flush();
+    }
+  }
+
+  /**
+   * Reopens the file for SWMR writing, after which items are committed to
+   * SWMR readers on every Flush(). No other handles of the file may be open,
+   * and no objects may be created in it from then on.
+   */
+  void StartSwmrWrite() {
+    std::string path = group_.getFileName();
+    std::string name = group_.getObjName();
+    index_writer_.Close();
+    for (auto& writer : writers_) {
+      writer.Close();
+    }
+    commit_dataset_.reset();
+    group_.close();
+
+    group_.setId(OpenFile(path, H5F_ACC_RDWR | H5F_ACC_SWMR_WRITE, options_).openGroup(name).getId());
+    index_writer_.Reopen(group_);
+    for (auto& writer : writers_) {
+      writer.Reopen(group_);
+    }
+    commit_dataset_ = group_.openDataSet(kUnionCommitDatasetName);
+    Commit(false);
+  }
+
+ private:
+  /**
+   * Makes the flushed items visible to SWMR readers. HDF5 does not order the
+   * writes to different datasets, so the items are counted only once the
+   * file has been flushed.
+   */
+  void Commit(bool ended) {
+    group_.flush(H5F_SCOPE_LOCAL);
+    std::array<uint64_t, 2> commit{index_rows_, ended};
+    commit_dataset_->write(commit.data(), H5::PredType::NATIVE_UINT64);
+    group_.flush(H5F_SCOPE_LOCAL);
+    last_commit_ = std::chrono::steady_clock::now();
+  }
+
+  // Creates the datasets that no rows have been written to, which readers
+  // expect to find empty.
+  void CreateDatasets() {
+    index_writer_.Create();
+    for (auto& writer : writers_) {
+      writer.Create();
+    }
+  }
+
+  static H5::Group CreateGroup(H5::Group const& parent_group, std::string group_name) {
+    if (parent_group.nameExists(group_name)) {
+      throw std::runtime_error("Unable to create group '" + group_name +
+                               "' for protocol because it already exists.");
+    }
+    return parent_group.createGroup(group_name);
+  }
+
+  H5::Group group_;
+  DatasetWriter index_writer_;
+  std::vector<IndexEntry> index_entry_buffer_;
+  std::array<DatasetWriter, N> writers_;
+  uint64_t index_rows_{};
+  std::optional<H5::DataSet> commit_dataset_;
+  Hdf5Options options_;
+  std::chrono::steady_clock::time_point last_commit_;
+};
+
+template <size_t N>
+class UnionDatasetReader {
+ public:
+  template <typename... TypeLabelBufferSizeTuples>
+  UnionDatasetReader(H5::Group const& parent_group, std::string name, bool nullable,
+                     TypeLabelBufferSizeTuples const&... type_label_buffer_size_tuples)
+      : UnionDatasetReader(parent_group, std::move(name), Hdf5Options{}, nullable, type_label_buffer_size_tuples...) {}
+
+  template <typename... TypeLabelBufferSizeTuples>
+  UnionDatasetReader(H5::Group const& parent_group, std::string name, Hdf5Options const& options,
+                     bool nullable, TypeLabelBufferSizeTuples const&... type_label_buffer_size_tuples)
+      : group_(parent_group.openGroup(name)),
+        index_reader_(group_, "$index",
+                      UnionIndexDatasetElementTypeDdl(
+                          UnionTypeEnumDdl(nullable, std::get<1>(type_label_buffer_size_tuples)...)),
+                      0, options.ForDataset("$index")),
+        readers_{DatasetReader{group_,
+                               std::get<1>(type_label_buffer_size_tuples),
+                               std::get<0>(type_label_buffer_size_tuples),
+                               std::get<2>(type_label_buffer_size_tuples),
+                               options.ForDataset(std::get<1>(type_label_buffer_size_tuples))}...},
+        swmr_(options.swmr),
+        swmr_poll_interval_(options.swmr_poll_interval),
+        swmr_timeout_(options.swmr_timeout) {
+    index_entry_buffer_.reserve(kIndexBatchSize);
+
+    // Rows past the committed items may not be fully written
+    if (swmr_) {
+      index_reader_.Refresh(ReadCommit().first);
+      for (auto& reader : readers_) {
+        reader.Refresh(0);
+      }
+    }
+  }
+
+  // Returns the number of items in the stream.
+  hsize_t Size() const {
+    return index_reader_.Size();
+  }
+
+  /**
+   * Positions the reader at item `position` of the stream. If `end` is
+   * greater than `position`, the index entries of items [position, end) are
+   * read at once and the rows of each type in that range are then read with
+   * one hyperslab read per type.
+   */
+  void Seek(hsize_t position, hsize_t end = 0) {
+    if (position > Size()) {
+      throw std::out_of_range("Cannot seek past the end of the '" + group_.getObjName() + "' stream.");
+    }
+
+    end = std::min(end, Size());
+    index_reader_.Seek(position);
+    index_entry_buffer_.clear();
+    index_entry_buffer_offset_ = 0;
+    index_reader_has_more_ = position < Size();
+    if (end <= position) {
+      return;
+    }
+
+    std::vector<IndexEntry> entries;
+    entries.reserve(end - position);
+    index_reader_has_more_ = index_reader_.ReadBatch<IndexEntry, IndexEntry>(entries);
+
+    std::array<std::pair<hsize_t, hsize_t>, N> type_ranges;
+    type_ranges.fill({std::numeric_limits<hsize_t>::max(), 0});
+    for (auto const& entry : entries) {
+      if (entry.type_ >= 0) {
+        auto& [first, last] = type_ranges[entry.type_];
+        first = std::min(first, static_cast<hsize_t>(entry.offset_));
+        last = std::max(last, static_cast<hsize_t>(entry.offset_) + 1);
+      }
+    }
+    if (swmr_) {
+      RefreshReaders(entries);
+    }
+    for (size_t i = 0; i < N; i++) {
+      if (type_ranges[i].second > 0) {
+        readers_[i].Seek(type_ranges[i].first);
+        readers_[i].ReadAheadTo(type_ranges[i].second);
+      }
+    }
+
+    index_entry_buffer_ = std::move(entries);
+    index_entry_buffer_.reserve(kIndexBatchSize);
+  }
+
+  // Returns the index entries of the items at the given positions, which
+  // must be in ascending order.
+  std::vector<IndexEntry> ReadIndexEntries(std::vector<hsize_t> const& positions) {
+    std::vector<IndexEntry> entries;
+    index_reader_.ReadRows<IndexEntry, IndexEntry>(positions, entries);
+    return entries;
+  }
+
+  // Returns the reader of the rows of the given type.
+  DatasetReader& Reader(int8_t type) {
+    return readers_[type];
+  }
+
+  std::tuple<bool, int8_t, DatasetReader*> ReadIndex() {
+    while (index_entry_buffer_offset_ == index_entry_buffer_.size()) {
+      if (!index_reader_has_more_ && !(swmr_ && WaitForItems())) {
+        return {false, 0, nullptr};
+      }
+
+      index_reader_has_more_ = index_reader_.ReadBatch<IndexEntry, IndexEntry>(index_entry_buffer_);
+      index_entry_buffer_offset_ = 0;
+
+      if (swmr_) {
+        RefreshReaders(index_entry_buffer_);
+      } else if (index_entry_buffer_.empty()) {
+        return {false, 0, nullptr};
+      }
+    }
+
+    IndexEntry const& entry = index_entry_buffer_[index_entry_buffer_offset_++];
+
+    if (entry.type_ < 0) {
+      return {true, entry.type_, nullptr};
+    }
+
+    // The readers follow the index, so that they stay in step after a Seek.
+    DatasetReader& reader = readers_[entry.type_];
+    reader.Seek(entry.offset_);
+    return {true, entry.type_, &reader};
+  }
+
+  static constexpr size_t kIndexBatchSize = 8192;
+
+ private:
+  /**
+   * Waits for the SWMR writer to commit items to the stream. Returns false
+   * once the writer has ended the stream without committing more.
+   */
+  bool WaitForItems() {
+    auto deadline = std::chrono::steady_clock::now() + swmr_timeout_;
+    while (true) {
+      auto [committed, ended] = ReadCommit();
+      if (committed > index_reader_.Size()) {
+        index_reader_.Refresh(committed);
+        if (index_reader_.Offset() < index_reader_.Size()) {
+          index_reader_has_more_ = true;
+          return true;
+        }
+      } else if (ended) {
+        return false;
+      }
+      if (swmr_timeout_.count() != 0 && std::chrono::steady_clock::now() >= deadline) {
+        throw std::runtime_error("Timed out waiting for the writer of '" + group_.getObjName() + "' to append items.");
+      }
+      std::this_thread::sleep_for(swmr_poll_interval_);
+    }
+  }
+
+  // Returns the number of committed items and whether the stream has ended.
+  // Streams not written in SWMR mode are committed and ended as a whole.
+  std::pair<hsize_t, bool> ReadCommit() {
+    if (!commit_dataset_) {
+      if (!group_.nameExists(kUnionCommitDatasetName)) {
+        index_reader_.Refresh();
+        return {index_reader_.Size(), true};
+      }
+      commit_dataset_ = group_.openDataSet(kUnionCommitDatasetName);
+    }
+
+    if (H5Drefresh(commit_dataset_->getId()) < 0) {
+      throw std::runtime_error("Unable to refresh the HDF5 dataset '" + kUnionCommitDatasetName + "'.");
+    }
+    std::array<uint64_t, 2> commit;
+    commit_dataset_->read(commit.data(), H5::PredType::NATIVE_UINT64);
+    return {commit[0], commit[1] != 0};
+  }
+
+  // Extends the readers of each type to the rows of the given committed
+  // entries, so that they do not read ahead into uncommitted rows.
+  void RefreshReaders(std::vector<IndexEntry> const& entries) {
+    std::array<hsize_t, N> rows{};
+    for (auto const& entry : entries) {
+      if (entry.type_ >= 0) {
+        rows[entry.type_] = std::max(rows[entry.type_], static_cast<hsize_t>(entry.offset_) + 1);
+      }
+    }
+    for (size_t i = 0; i < N; i++) {
+      if (rows[i] > readers_[i].Size()) {
+        readers_[i].Refresh(rows[i]);
+      }
+    }
+  }
+
+ public:
+  H5::Group group_;
+  DatasetReader index_reader_;
+  std::vector<IndexEntry> index_entry_buffer_;
+  size_t index_entry_buffer_offset_{};
+  bool index_reader_has_more_{true};
+  std::array<DatasetReader, N> readers_;
+  bool swmr_;
+  std::chrono::milliseconds swmr_poll_interval_;
+  std::chrono::milliseconds swmr_timeout_;
+  std::optional<H5::DataSet> commit_dataset_;
+};
+
+/**
+ * Creates the union stream `name` in `parent_group` as the concatenation of
+ * the union streams `source_groups`, opened in other files. The dataset of
+ * each type is a virtual dataset mapping the rows of the sources' datasets,
+ * which are not copied. Virtual datasets cannot transform values, so the
+ * index is written with the offsets of each source's entries moved past the
+ * rows of the sources before it. The sources must have the same types, with
+ * the same datatypes.
+ *
+ * Source files are referred to relative to the directory of the file of
+ * `parent_group`, where HDF5 looks for them first, and must stay in place.
+ */
+static inline void CreateVirtualUnionDataset(H5::Group const& parent_group, std::string const& name,
+                                             std::vector<H5::Group> const& source_groups,
+                                             Hdf5Options const& options) {
+  if (source_groups.empty()) {
+    throw std::invalid_argument("The virtual stream '" + name + "' needs at least one source file.");
+  }
+  if (parent_group.nameExists(name)) {
+    throw std::runtime_error("Unable to create group '" + name +
+                             "' for protocol because it already exists.");
+  }
+
+  H5::Group group = parent_group.createGroup(name);
+  std::filesystem::path directory = std::filesystem::absolute(parent_group.getFileName()).parent_path();
+
+  std::optional<H5::EnumType> type_enum;
+  std::optional<DatasetWriter> index_writer;
+  std::vector<IndexEntry> index_entries;
+  index_entries.reserve(8192);
+
+  // The labels and datatypes of the types, and the rows of each source
+  struct VirtualTypeDataset {
+    std::string label;
+    H5::DataType element_type;
+    hsize_t rows{};
+    std::vector<std::pair<std::string, hsize_t>> source_rows;
+  };
+  std::vector<VirtualTypeDataset> type_datasets;
+
+  std::string source_group_path = source_groups.front().getObjName();
+  for (auto const& source_group : source_groups) {
+    std::string source_path = source_group.getFileName();
+    if (source_group.getObjName() != source_group_path) {
+      throw std::invalid_argument("The source streams of the virtual stream '" + name +
+                                  "' must be at the same path in their files.");
+    }
+
+    H5::EnumType source_type_enum = source_group.openDataSet("$index").getCompType().getMemberEnumType(0);
+    if (!type_enum) {
+      type_enum = source_type_enum;
+      index_writer.emplace(group, "$index", UnionIndexDatasetElementTypeDdl(*type_enum), 0,
+                           options.ForDataset("$index"));
+
+      for (int i = 0; i < type_enum->getNmembers(); i++) {
+        int8_t type;
+        type_enum->getMemberValue(i, &type);
+        if (type >= 0) {
+          type_datasets.resize(std::max(type_datasets.size(), static_cast<size_t>(type) + 1));
+          type_datasets[type].label = type_enum->nameOf(&type, 256);
+        }
+      }
+    } else if (!(source_type_enum == *type_enum)) {
+      throw std::runtime_error("The '" + source_group_path + "' stream of '" + source_path +
+                               "' does not have the item types of the other source files.");
+    }
+
+    std::filesystem::path source_file = std::filesystem::absolute(source_path).lexically_normal();
+    std::filesystem::path source_file_name = source_file.lexically_relative(directory);
+    if (source_file_name.empty()) {
+      source_file_name = source_file;
+    }
+
+    std::vector<hsize_t> source_offsets;
+    for (auto& type_dataset : type_datasets) {
+      H5::DataSet source_dataset = source_group.openDataSet(type_dataset.label);
+      if (type_dataset.source_rows.empty()) {
+        type_dataset.element_type = source_dataset.getDataType();
+      } else if (!(source_dataset.getDataType() == type_dataset.element_type)) {
+        throw std::runtime_error("The '" + type_dataset.label + "' items of '" + source_path +
+                                 "' do not have the datatype of those of the other source files.");
+      }
+      hsize_t rows = 0;
+      source_dataset.getSpace().getSimpleExtentDims(&rows);
+      type_dataset.source_rows.push_back({source_file_name.string(), rows});
+      source_offsets.push_back(type_dataset.rows);
+      type_dataset.rows += rows;
+    }
+
+    DatasetReader index_reader(source_group, "$index", UnionIndexDatasetElementTypeDdl(*type_enum), 0,
+                               options.ForDataset("$index"));
+    while (index_reader.Offset() < index_reader.Size()) {
+      index_reader.ReadBatch<IndexEntry, IndexEntry>(index_entries);
+      for (auto& entry : index_entries) {
+        if (entry.type_ >= 0) {
+          entry.offset_ += source_offsets[entry.type_];
+        }
+      }
+      index_writer->AppendBatch<IndexEntry, IndexEntry>(index_entries);
+    }
+  }
+
+  index_writer->Create();
+  for (auto const& type_dataset : type_datasets) {
+    hsize_t dims = type_dataset.rows;
+    H5::DataSpace dataspace(1, &dims);
+    H5::DSetCreatPropList prop;
+    hsize_t start = 0;
+    for (auto const& [source_file_name, rows] : type_dataset.source_rows) {
+      if (rows == 0) {
+        continue;
+      }
+      H5::DataSpace virtual_space(dataspace);
+      virtual_space.selectHyperslab(H5S_SELECT_SET, &rows, &start);
+      prop.setVirtual(virtual_space, source_file_name, source_group_path + "/" + type_dataset.label,
+                      H5::DataSpace(1, &rows));
+      start += rows;
+    }
+    group.createDataSet(type_dataset.label, type_dataset.element_type, dataspace, prop);
+  }
+}
+
+class Hdf5Writer {
+ public:
+  Hdf5Writer(std::string const& path, std::string const& group_name, std::string const& schema,
+             Hdf5Options options = {})
+      : options_(std::move(options)),
+        file_(CreateOrOpenFile(path, options_)),
+        group_(CreateGroup(file_, group_name)) {
+    WriteScalarDataset<InnerVlenString, std::string>(group_, kSchemaDatasetName, InnerVlenStringDdl(), schema);
+  }
+
+ protected:
+  // Closes the writer's handles of the file, which stays open for as long as
+  // any of its objects are, e.g. so that a SWMR stream writer can reopen it.
+  void ReleaseFile() {
+    group_.close();
+    file_.close();
+  }
+
+  // Replaces the format version written by the constructor, for files that
+  // readers of kHdf5FormatVersionNumber cannot read correctly.
+  void SetFormatVersion(uint32_t version) {
+    group_.openAttribute(kHdf5FormatVersionNumberAttributeName).write(H5::PredType::NATIVE_UINT32, &version);
+  }
+
+ private:
+  // Protocols can be written to groups of an existing file, whose file space
+  // strategy was chosen when it was created.
+  static H5::H5File CreateOrOpenFile(std::string const& path, Hdf5Options const& options) {
+    if (std::filesystem::exists(path)) {
+      return OpenFile(path, H5F_ACC_RDWR, options);
+    }
+
+    H5::FileCreatPropList properties;
+    if (options.file_space_page_bytes != 0) {
+      properties.setFileSpaceStrategy(H5F_FSPACE_STRATEGY_PAGE, false, 1);
+      properties.setFileSpacePagesize(options.file_space_page_bytes);
+    }
+    return H5::H5File(path, H5F_ACC_EXCL, properties,
+                      FileAccessProperties(options, options.file_space_page_bytes != 0));
+  }
+
+  static H5::Group CreateGroup(H5::H5File const& file, std::string group_name) {
+    if (file.nameExists(group_name)) {
+      throw std::runtime_error("Unable to create group '" + group_name +
+                               "' for protocol because it already exists.");
+    }
+    H5::Group group = file.createGroup(group_name);
+
+    uint32_t version = kHdf5FormatVersionNumber;
+    group.createAttribute(kHdf5FormatVersionNumberAttributeName, H5::PredType::NATIVE_INT, H5::DataSpace())
+        .write(H5::PredType::NATIVE_UINT32, &version);
+
+    return group;
+  }
+
+ protected:
+  Hdf5Options options_;
+  H5::H5File file_;
+  H5::Group group_;
+};
+
+class Hdf5Reader {
+ public:
+  // Reads files with a format version from kHdf5FormatVersionNumber up to
+  // max_format_version.
+  Hdf5Reader(std::string path, std::string group_name, std::string const& expected_schema,
+             Hdf5Options options = {}, uint32_t max_format_version = kHdf5FormatVersionNumber)
+      : options_(std::move(options)),
+        file_(OpenFile(path, options_.swmr ? H5F_ACC_RDONLY | H5F_ACC_SWMR_READ : H5F_ACC_RDONLY, options_)),
+        group_(OpenGroup(file_, group_name, max_format_version, format_version_)) {
+    std::string actual_schema;
+    ReadScalarDataset<InnerVlenString, std::string>(group_, kSchemaDatasetName, InnerVlenStringDdl(), actual_schema);
+    if (actual_schema != expected_schema) {
+      throw std::runtime_error(
+          "The schema of the data to be read is not compatible with the current protocol.");
+    }
+  }
+
+ private:
+  static H5::Group OpenGroup(H5::H5File const& file, std::string group_name, uint32_t max_format_version,
+                             uint32_t& version) {
+    if (!file.nameExists(group_name)) {
+      throw std::runtime_error("Unable to open group '" + group_name +
+                               "' for protocol because it does not exist.");
+    }
+
+    H5::Group group = file.openGroup(group_name);
+    if (group.attrExists(kHdf5FormatVersionNumberAttributeName)) {
+      group.openAttribute(kHdf5FormatVersionNumberAttributeName)
+          .read(H5::PredType::NATIVE_UINT32, &version);
+      if (version >= kHdf5FormatVersionNumber && version <= max_format_version) {
+        return group;
+      }
+    }
+
+    throw std::runtime_error("The data in the HDF5 file is not in the expected format.");
+  }
+
+ protected:
+  Hdf5Options options_;
+  uint32_t format_version_{};
+  H5::H5File file_;
+  H5::Group group_;
+};
+
+template <class>
+inline constexpr bool always_false_v = false;
+
+}  // namespace mrd::hdf5
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+#include <H5Cpp.h>
+
+// The memory of variable-length data (hvl_t and strings) in inner types.
+// HDF5 allocates this memory when reading, and the inner types when writing,
+// once for each variable-length element of each row. Allocations are served
+// from per-thread pools of blocks rounded up to size classes, so that the
+// blocks of one window of rows are reused for the next. A block freed by
+// another thread than the one that allocated it is released rather than
+// cached, and the free blocks of all threads together are bounded.
+//
+// Memory allocated by HDF5 must be freed with VlenFree, so every read of
+// data with variable-length types must use a transfer property list with
+// SetVlenMemoryManager.
+namespace mrd::hdf5 {
+
+class VlenPool {
+  public:
+  // Blocks larger than this are not pooled.
+  static constexpr size_t kMaxPooledBlockBytes = 16 * 1024 * 1024;
+
+  // Limits on the free blocks kept by each thread, and by all threads.
+  static constexpr size_t kMaxCachedBytesPerClass = kMaxPooledBlockBytes;
+  static constexpr size_t kMaxCachedBytesPerThread = 32 * 1024 * 1024;
+  static constexpr size_t kMaxCachedBytes = 64 * 1024 * 1024;
+
+  static void* Allocate(size_t size) {
+    size_t class_bytes;
+    uint32_t size_class = SizeClass(size, class_bytes);
+    uint32_t owner = 0;
+    if (size_class != kUnpooled) {
+      VlenPool& pool = ThreadPool();
+      owner = pool.id_;
+      auto& free_blocks = pool.free_blocks_[size_class];
+      if (!free_blocks.empty()) {
+        void* block = free_blocks.back();
+        free_blocks.pop_back();
+        pool.cached_bytes_ -= class_bytes;
+        TotalCachedBytes().fetch_sub(class_bytes, std::memory_order_relaxed);
+        return static_cast<std::byte*>(block) + kHeaderBytes;
+      }
+    }
+
+    void* block = std::malloc(kHeaderBytes + class_bytes);
+    if (!block) {
+      return nullptr;
+    }
+    static_cast<uint32_t*>(block)[0] = size_class;
+    static_cast<uint32_t*>(block)[1] = owner;
+    return static_cast<std::byte*>(block) + kHeaderBytes;
+  }
+
+  static void Free(void* p) {
+    if (p == nullptr) {
+      return;
+    }
+
+    void* block = static_cast<std::byte*>(p) - kHeaderBytes;
+    uint32_t size_class = static_cast<uint32_t*>(block)[0];
+    uint32_t owner = static_cast<uint32_t*>(block)[1];
+    if (size_class != kUnpooled) {
+      VlenPool& pool = ThreadPool();
+      size_t class_bytes = ClassBytes(size_class);
+      auto& free_blocks = pool.free_blocks_[size_class];
+      if (owner == pool.id_ &&
+          pool.cached_bytes_ + class_bytes <= kMaxCachedBytesPerThread &&
+          (free_blocks.size() + 1) * class_bytes <= kMaxCachedBytesPerClass &&
+          ReserveCachedBytes(class_bytes)) {
+        try {
+          free_blocks.push_back(block);
+          pool.cached_bytes_ += class_bytes;
+          return;
+        } catch (std::bad_alloc const&) {
+          TotalCachedBytes().fetch_sub(class_bytes, std::memory_order_relaxed);
+        }
+      }
+    }
+
+    std::free(block);
+  }
+
+  // The bytes of free blocks kept by all threads.
+  static size_t CachedBytes() {
+    return TotalCachedBytes().load(std::memory_order_relaxed);
+  }
+
+  VlenPool(VlenPool const&) = delete;
+  VlenPool& operator=(VlenPool const&) = delete;
+
+  ~VlenPool() {
+    Release();
+  }
+
+  private:
+  // Keeps the memory after the header aligned for any type. The header holds
+  // the block's size class and the id of the thread that allocated it.
+  static constexpr size_t kHeaderBytes = alignof(std::max_align_t);
+  static_assert(kHeaderBytes >= 2 * sizeof(uint32_t));
+
+  static constexpr uint32_t kUnpooled = UINT32_MAX;
+
+  // Size classes are 16 bytes, then four per power of two up to
+  // kMaxPooledBlockBytes, so that blocks are at most 25% larger than needed.
+  static constexpr size_t kSizeClassCount = 1 + 4 * 20;
+
+  VlenPool() : id_(NextId()) {}
+
+  static VlenPool& ThreadPool() {
+    static thread_local VlenPool pool;
+    return pool;
+  }
+
+  // Thread ids start at 1, so that no pool owns unpooled blocks.
+  static uint32_t NextId() {
+    static std::atomic<uint32_t> next_id{1};
+    uint32_t id = next_id.fetch_add(1, std::memory_order_relaxed);
+    return id != 0 ? id : next_id.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  static std::atomic<size_t>& TotalCachedBytes() {
+    static std::atomic<size_t> total{0};
+    return total;
+  }
+
+  static bool ReserveCachedBytes(size_t bytes) {
+    auto& total = TotalCachedBytes();
+    size_t cached = total.load(std::memory_order_relaxed);
+    do {
+      if (cached + bytes > kMaxCachedBytes) {
+        return false;
+      }
+    } while (!total.compare_exchange_weak(cached, cached + bytes, std::memory_order_relaxed));
+    return true;
+  }
+
+  void Release() {
+    for (auto& free_blocks : free_blocks_) {
+      for (void* block : free_blocks) {
+        std::free(block);
+      }
+      free_blocks.clear();
+    }
+    TotalCachedBytes().fetch_sub(cached_bytes_, std::memory_order_relaxed);
+    cached_bytes_ = 0;
+  }
+
+  static uint32_t SizeClass(size_t size, size_t& class_bytes) {
+    if (size <= 16) {
+      class_bytes = 16;
+      return 0;
+    }
+    if (size > kMaxPooledBlockBytes) {
+      class_bytes = size;
+      return kUnpooled;
+    }
+
+    // 2^(bits - 1) < size <= 2^bits
+    uint32_t bits = 0;
+    for (size_t s = size - 1; s != 0; s >>= 1) {
+      bits++;
+    }
+    size_t base = size_t{1} << (bits - 1);
+    size_t step = base / 4;
+    size_t steps = (size - base + step - 1) / step;
+    class_bytes = base + steps * step;
+    return 1 + (bits - 5) * 4 + static_cast<uint32_t>(steps - 1);
+  }
+
+  static size_t ClassBytes(uint32_t size_class) {
+    if (size_class == 0) {
+      return 16;
+    }
+    uint32_t bits = (size_class - 1) / 4 + 5;
+    size_t base = size_t{1} << (bits - 1);
+    return base + ((size_class - 1) % 4 + 1) * (base / 4);
+  }
+
+  std::array<std::vector<void*>, kSizeClassCount> free_blocks_;
+  size_t cached_bytes_{};
+  uint32_t id_;
+};
+
+static inline void* VlenAllocateOrThrow(size_t size) {
+  auto res = VlenPool::Allocate(size);
+  if (!res) {
+    throw std::bad_alloc{};
+  }
+
+  return res;
+}
+
+static inline void VlenFree(void* p) {
+  VlenPool::Free(p);
+}
+
+/**
+ * Makes HDF5 allocate and free variable-length data read or written with
+ * the given transfer properties with VlenPool.
+ */
+static inline void SetVlenMemoryManager(H5::DSetMemXferPropList& properties) {
+  auto allocate = [](size_t size, void*) { return VlenPool::Allocate(size); };
+  auto free = [](void* p, void*) { VlenPool::Free(p); };
+  if (H5Pset_vlen_mem_manager(properties.getId(), allocate, nullptr, free, nullptr) < 0) {
+    throw std::runtime_error("Failed to set the variable-length memory manager.");
+  }
+}
+
+// Transfer properties with the default conversion buffers, for reading
+// variable-length data into inner types.
+static inline H5::DSetMemXferPropList const& VlenTransferProperties() {
+  static H5::DSetMemXferPropList const properties = [] {
+    H5::DSetMemXferPropList p;
+    SetVlenMemoryManager(p);
+    return p;
+  }();
+  return properties;
+}
+
+}  // namespace mrd::hdf5
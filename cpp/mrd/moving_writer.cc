@@ -0,0 +1,71 @@
+#include "moving_writer.h"
+
+#include <utility>
+
+namespace mrd {
+
+void MrdMovingWriterBase::WriteData(mrd::StreamItem&& value) {
+  moving_ = &value;
+  try {
+    MrdWriterBase::WriteData(static_cast<mrd::StreamItem const&>(value));
+  } catch (...) {
+    moving_ = nullptr;
+    throw;
+  }
+  moving_ = nullptr;
+}
+
+void MrdMovingWriterBase::WriteData(std::vector<mrd::StreamItem>&& values) {
+  moving_ = &values;
+  try {
+    MrdWriterBase::WriteData(static_cast<std::vector<mrd::StreamItem> const&>(values));
+  } catch (...) {
+    moving_ = nullptr;
+    throw;
+  }
+  moving_ = nullptr;
+}
+
+// The const_casts are safe: the value was passed to WriteData() as a non-const rvalue.
+void MrdMovingWriterBase::WriteDataImpl(mrd::StreamItem const& value) {
+  if (&value == moving_) {
+    moving_ = nullptr;
+    WriteDataImpl(std::move(const_cast<mrd::StreamItem&>(value)));
+  } else {
+    WriteDataImpl(mrd::StreamItem(value));
+  }
+}
+
+void MrdMovingWriterBase::WriteDataImpl(std::vector<mrd::StreamItem> const& values) {
+  if (&values == moving_) {
+    moving_ = nullptr;
+    WriteDataImpl(std::move(const_cast<std::vector<mrd::StreamItem>&>(values)));
+  } else {
+    WriteDataImpl(std::vector<mrd::StreamItem>(values));
+  }
+}
+
+// fallback implementation
+void MrdMovingWriterBase::WriteDataImpl(std::vector<mrd::StreamItem>&& values) {
+  for (auto& v : values) {
+    WriteDataImpl(std::move(v));
+  }
+}
+
+void WriteData(MrdWriterBase& writer, mrd::StreamItem&& value) {
+  if (auto moving_writer = dynamic_cast<MrdMovingWriterBase*>(&writer)) {
+    moving_writer->WriteData(std::move(value));
+  } else {
+    writer.WriteData(value);
+  }
+}
+
+void WriteData(MrdWriterBase& writer, std::vector<mrd::StreamItem>&& values) {
+  if (auto moving_writer = dynamic_cast<MrdMovingWriterBase*>(&writer)) {
+    moving_writer->WriteData(std::move(values));
+  } else {
+    writer.WriteData(values);
+  }
+}
+
+} // namespace mrd
@@ -0,0 +1,36 @@
+#pragma once
+#include <vector>
+
+#include "protocols.h"
+
+namespace mrd {
+// Base of writers for the Mrd protocol that keep the items of the `data`
+// stream in memory instead of encoding them, such as in-process channels and
+// background writers. Adds WriteData() overloads taking rvalues, which hand
+// the items over without copying them. Items written as lvalues are copied
+// once, before they reach WriteDataImpl().
+class MrdMovingWriterBase : public MrdWriterBase {
+  public:
+  using MrdWriterBase::WriteData;
+
+  void WriteData(mrd::StreamItem&& value);
+  void WriteData(std::vector<mrd::StreamItem>&& values);
+
+  protected:
+  void WriteDataImpl(mrd::StreamItem const& value) final;
+  void WriteDataImpl(std::vector<mrd::StreamItem> const& values) final;
+  virtual void WriteDataImpl(mrd::StreamItem&& value) = 0;
+  virtual void WriteDataImpl(std::vector<mrd::StreamItem>&& values);
+
+  private:
+  // The argument of the rvalue WriteData() call in progress, which reaches
+  // WriteDataImpl() through the state checks of MrdWriterBase::WriteData().
+  void const* moving_ = nullptr;
+};
+
+// Writes to the `data` stream of any writer, moving the items into writers
+// derived from MrdMovingWriterBase.
+void WriteData(MrdWriterBase& writer, mrd::StreamItem&& value);
+void WriteData(MrdWriterBase& writer, std::vector<mrd::StreamItem>&& values);
+
+} // namespace mrd
@@ -0,0 +1,95 @@
+#include "pipelined_copy.h"
+
+#include <exception>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "byte_size.h"
+#include "moving_writer.h"
+#include "concurrency/bounded_queue.h"
+
+namespace mrd {
+
+CopyToStats CopyToPipelined(MrdReaderBase& reader, MrdWriterBase& writer, size_t data_buffer_size,
+                            size_t queue_capacity, size_t queue_max_bytes) {
+  using clock = std::chrono::steady_clock;
+  auto start = clock::now();
+  CopyToStats stats;
+
+  {
+    std::optional<mrd::Header> value;
+    reader.ReadHeader(value);
+    writer.WriteHeader(value);
+  }
+
+  concurrency::BoundedQueue<std::vector<mrd::StreamItem>> queue(queue_capacity, queue_max_bytes);
+  std::exception_ptr reader_error;
+  std::thread reader_thread([&]() {
+    try {
+      while (true) {
+        std::vector<mrd::StreamItem> batch;
+        auto read_start = clock::now();
+        bool more;
+        if (data_buffer_size > 1) {
+          batch.reserve(data_buffer_size);
+          more = reader.ReadData(batch);
+        } else {
+          batch.resize(1);
+          more = reader.ReadData(batch[0]);
+          if (!more) {
+            batch.clear();
+          }
+        }
+        stats.read_time += clock::now() - read_start;
+
+        if (!more) {
+          break;
+        }
+
+        size_t bytes = queue_max_bytes != 0 ? yardl::ByteSize(batch) : 0;
+        if (!queue.Push(std::move(batch), bytes)) {
+          break;
+        }
+      }
+    } catch (...) {
+      reader_error = std::current_exception();
+    }
+    queue.Close();
+  });
+
+  try {
+    std::vector<mrd::StreamItem> batch;
+    while (queue.Pop(batch)) {
+      auto write_start = clock::now();
+      size_t batch_size = batch.size();
+      if (batch_size == 1) {
+        mrd::WriteData(writer, std::move(batch[0]));
+      } else {
+        mrd::WriteData(writer, std::move(batch));
+      }
+      stats.write_time += clock::now() - write_start;
+      stats.items += batch_size;
+      stats.batches++;
+    }
+  } catch (...) {
+    queue.Cancel();
+    reader_thread.join();
+    throw;
+  }
+
+  reader_thread.join();
+  if (reader_error) {
+    std::rethrow_exception(reader_error);
+  }
+
+  writer.EndData();
+
+  stats.reader_wait_time = queue.PushWaitTime();
+  stats.writer_wait_time = queue.PopWaitTime();
+  stats.elapsed = clock::now() - start;
+  return stats;
+}
+
+} // namespace mrd
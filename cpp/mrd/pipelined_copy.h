@@ -0,0 +1,42 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+
+#include "protocols.h"
+
+namespace mrd {
+// Throughput statistics of a pipelined copy between a reader and a writer.
+struct CopyToStats {
+  using Seconds = std::chrono::duration<double>;
+
+  // Number of data stream items copied, and the number of batches they were
+  // handed over in.
+  size_t items = 0;
+  size_t batches = 0;
+
+  // Wall-clock time of the whole copy.
+  Seconds elapsed{};
+
+  // Time the reader thread spent reading, and blocked on a full queue.
+  Seconds read_time{};
+  Seconds reader_wait_time{};
+
+  // Time the writer thread spent writing, and blocked on an empty queue.
+  Seconds write_time{};
+  Seconds writer_wait_time{};
+
+  double ItemsPerSecond() const {
+    return elapsed.count() > 0 ? items / elapsed.count() : 0;
+  }
+};
+
+// Like MrdReaderBase::CopyTo(), but reads on a separate thread while the
+// calling thread writes. Batches of up to `data_buffer_size` items are moved
+// between the threads through a queue holding at most `queue_capacity`
+// batches and, if `queue_max_bytes` is not zero, at most that many bytes (see
+// yardl::ByteSize()). An exception on either side stops the copy and is
+// rethrown here.
+CopyToStats CopyToPipelined(MrdReaderBase& reader, MrdWriterBase& writer, size_t data_buffer_size = 1,
+                            size_t queue_capacity = 16, size_t queue_max_bytes = 0);
+
+} // namespace mrd
@@ -0,0 +1,119 @@
+#include "prefetch.h"
+
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "byte_size.h"
+
+namespace mrd {
+
+namespace {
+size_t ValidatedMaxItems(PrefetchOptions const& options) {
+  if (options.max_items == 0) {
+    throw std::invalid_argument("PrefetchOptions::max_items must be greater than zero.");
+  }
+  return options.max_items;
+}
+} // namespace
+
+PrefetchingMrdReader::PrefetchingMrdReader(std::unique_ptr<MrdReaderBase> reader, PrefetchOptions options)
+    : reader_(std::move(reader)), queue_(ValidatedMaxItems(options), options.max_bytes) {
+  if (!reader_) {
+    throw std::invalid_argument("PrefetchingMrdReader reader must not be null.");
+  }
+}
+
+PrefetchingMrdReader::~PrefetchingMrdReader() {
+  queue_.Cancel();
+  Stop();
+}
+
+PrefetchStats PrefetchingMrdReader::GetStats() const {
+  PrefetchStats stats;
+  stats.items = items_.load(std::memory_order_relaxed);
+  stats.read_time = Clock::duration(read_time_.load(std::memory_order_relaxed));
+  stats.reader_wait_time = queue_.PushWaitTime();
+  stats.consumer_wait_time = queue_.PopWaitTime();
+  stats.consumer_time = consumer_time_;
+  return stats;
+}
+
+void PrefetchingMrdReader::ReadHeaderImpl(std::optional<mrd::Header>& value) {
+  reader_->ReadHeader(value);
+  thread_ = std::thread([this]() { Run(); });
+}
+
+bool PrefetchingMrdReader::ReadDataImpl(mrd::StreamItem& value) {
+  auto now = Clock::now();
+  if (last_return_) {
+    consumer_time_ += now - *last_return_;
+  }
+
+  bool more = queue_.Pop(value);
+  last_return_ = Clock::now();
+  if (!more) {
+    // The queue was closed after error_ was set, and Pop() took its lock since
+    if (error_) {
+      std::rethrow_exception(error_);
+    }
+    return false;
+  }
+  items_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool PrefetchingMrdReader::ReadDataImpl(std::vector<mrd::StreamItem>& values) {
+  values.clear();
+  values.emplace_back();
+  if (!ReadDataImpl(values.back())) {
+    values.clear();
+    return false;
+  }
+
+  while (values.size() < values.capacity()) {
+    values.emplace_back();
+    if (!queue_.TryPop(values.back())) {
+      values.pop_back();
+      break;
+    }
+    items_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return true;
+}
+
+void PrefetchingMrdReader::CloseImpl() {
+  Stop();
+  reader_->Close();
+}
+
+void PrefetchingMrdReader::Run() {
+  try {
+    while (true) {
+      mrd::StreamItem item;
+      auto start = Clock::now();
+      bool more = reader_->ReadData(item);
+      read_time_.fetch_add((Clock::now() - start).count(), std::memory_order_relaxed);
+      if (!more) {
+        break;
+      }
+
+      size_t bytes = sizeof(mrd::StreamItem) + yardl::ByteSize(item);
+      if (!queue_.Push(std::move(item), bytes)) {
+        return;
+      }
+    }
+  } catch (...) {
+    error_ = std::current_exception();
+  }
+  queue_.Close();
+}
+
+void PrefetchingMrdReader::Stop() {
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+} // namespace mrd
@@ -0,0 +1,87 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "concurrency/bounded_queue.h"
+#include "protocols.h"
+
+namespace mrd {
+struct PrefetchOptions {
+  // Maximum number of items read ahead.
+  size_t max_items = 64;
+
+  // Maximum in-memory size of the items read ahead, as given by
+  // yardl::ByteSize(), or 0 for no limit. A single item larger than this is
+  // still read ahead on its own.
+  size_t max_bytes = 0;
+};
+
+struct PrefetchStats {
+  uint64_t items = 0;
+
+  // Time the background thread spent reading and decoding items.
+  std::chrono::steady_clock::duration read_time{};
+
+  // Time the background thread was blocked because the read-ahead buffer was
+  // full, i.e. waiting on the consumer.
+  std::chrono::steady_clock::duration reader_wait_time{};
+
+  // Time ReadData() blocked because no item was ready, i.e. the consumer
+  // waiting on I/O and decoding.
+  std::chrono::steady_clock::duration consumer_wait_time{};
+
+  // Time the consumer spent between ReadData() calls, i.e. processing items.
+  std::chrono::steady_clock::duration consumer_time{};
+};
+
+// Reader for the Mrd protocol that reads the `data` stream of another reader
+// ahead on a background thread, so that decoding overlaps with whatever the
+// consumer does with the items. For example:
+//   mrd::PrefetchingMrdReader reader(std::make_unique<mrd::binary::MrdReader>(std::cin));
+//
+// The header is read on the calling thread. After that, the background thread
+// keeps up to PrefetchOptions::max_items items (and max_bytes bytes) ready.
+// An exception thrown by the underlying reader is rethrown by ReadData() once
+// the items read before it have been consumed.
+//
+// Destroying the reader before the end of the stream stops the background
+// thread after the read it is currently blocked in, if any, returns.
+class PrefetchingMrdReader : public MrdReaderBase {
+  public:
+  PrefetchingMrdReader(std::unique_ptr<MrdReaderBase> reader, PrefetchOptions options = {});
+  ~PrefetchingMrdReader() override;
+
+  PrefetchStats GetStats() const;
+
+  protected:
+  void ReadHeaderImpl(std::optional<mrd::Header>& value) override;
+  bool ReadDataImpl(mrd::StreamItem& value) override;
+  bool ReadDataImpl(std::vector<mrd::StreamItem>& values) override;
+  void CloseImpl() override;
+
+  private:
+  using Clock = std::chrono::steady_clock;
+
+  void Run();
+  void Stop();
+
+  std::unique_ptr<MrdReaderBase> reader_;
+  // The items read ahead. The background thread closes the queue at the end
+  // of the stream, after setting error_ if the underlying reader failed.
+  concurrency::BoundedQueue<mrd::StreamItem> queue_;
+  std::exception_ptr error_;
+  std::atomic<uint64_t> items_{0};
+  std::atomic<Clock::rep> read_time_{0};
+  std::thread thread_;
+  std::optional<std::chrono::steady_clock::time_point> last_return_;
+  std::chrono::steady_clock::duration consumer_time_{};
+};
+
+} // namespace mrd
@@ -0,0 +1,121 @@
+#include "tee.h"
+
+#include <stdexcept>
+#include <utility>
+
+#include "byte_size.h"
+
+namespace mrd {
+
+namespace {
+using Event = detail::WriterWorker::Event;
+} // namespace
+
+struct TeeMrdWriter::Sink {
+  Sink(std::unique_ptr<MrdWriterBase> writer, TeeSinkOptions const& options)
+      : worker(std::move(writer), options.queue_capacity, options.max_bytes), options(options) {}
+
+  detail::WriterWorker worker;
+  TeeSinkOptions options;
+  uint64_t items_dropped = 0;
+};
+
+TeeMrdWriter::TeeMrdWriter() = default;
+
+TeeMrdWriter::~TeeMrdWriter() = default;
+
+size_t TeeMrdWriter::AddSink(std::unique_ptr<MrdWriterBase> writer, TeeSinkOptions options) {
+  if (started_) {
+    throw std::runtime_error("Sinks must be added to a TeeMrdWriter before calling WriteHeader().");
+  }
+  if (!writer) {
+    throw std::invalid_argument("TeeMrdWriter sink must not be null.");
+  }
+
+  sinks_.push_back(std::make_unique<Sink>(std::move(writer), options));
+  return sinks_.size() - 1;
+}
+
+TeeSinkStats TeeMrdWriter::GetSinkStats(size_t index) const {
+  Sink const& sink = *sinks_.at(index);
+  TeeSinkStats stats;
+  stats.items_written = sink.worker.ItemsWritten();
+  stats.items_dropped = sink.items_dropped;
+  stats.wait_time = sink.worker.PushWaitTime();
+  return stats;
+}
+
+void TeeMrdWriter::Flush() {
+  ThrowIfSinkFailed();
+
+  std::vector<std::future<void>> pending;
+  for (auto& sink : sinks_) {
+    pending.push_back(sink->worker.Flush());
+  }
+
+  for (size_t i = 0; i < sinks_.size(); i++) {
+    sinks_[i]->worker.Wait(pending[i]);
+  }
+}
+
+void TeeMrdWriter::WriteHeaderImpl(std::optional<mrd::Header> const& value) {
+  started_ = true;
+  Broadcast(detail::WriterWorker::HeaderEvent{std::make_shared<std::optional<mrd::Header> const>(value)}, 0, 0);
+}
+
+void TeeMrdWriter::WriteDataImpl(mrd::StreamItem&& value) {
+  auto item = std::make_shared<mrd::StreamItem const>(std::move(value));
+  size_t bytes = sizeof(mrd::StreamItem) + yardl::ByteSize(*item);
+  Broadcast(detail::WriterWorker::SharedItemEvent{std::move(item)}, 1, bytes);
+}
+
+void TeeMrdWriter::WriteDataImpl(std::vector<mrd::StreamItem>&& values) {
+  size_t count = values.size();
+  auto items = std::make_shared<std::vector<mrd::StreamItem> const>(std::move(values));
+  size_t bytes = yardl::ByteSize(*items);
+  Broadcast(detail::WriterWorker::SharedItemsEvent{std::move(items)}, count, bytes);
+}
+
+void TeeMrdWriter::EndDataImpl() {
+  Broadcast(detail::WriterWorker::EndDataEvent{}, 0, 0);
+}
+
+void TeeMrdWriter::CloseImpl() {
+  std::exception_ptr error;
+  for (auto& sink : sinks_) {
+    try {
+      sink->worker.Close();
+    } catch (...) {
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+// Events carrying data (item_count > 0) may be dropped by sinks with the kDrop policy.
+void TeeMrdWriter::Broadcast(Event const& event, size_t item_count, size_t bytes) {
+  ThrowIfSinkFailed();
+
+  for (auto& sink : sinks_) {
+    Event copy = event;
+    if (item_count > 0 && sink->options.policy == TeeSinkPolicy::kDrop) {
+      if (!sink->worker.TryPush(std::move(copy), bytes)) {
+        sink->items_dropped += item_count;
+      }
+    } else {
+      sink->worker.Push(std::move(copy), bytes);
+    }
+  }
+}
+
+void TeeMrdWriter::ThrowIfSinkFailed() {
+  for (auto& sink : sinks_) {
+    sink->worker.ThrowIfFailed();
+  }
+}
+
+} // namespace mrd
@@ -0,0 +1,87 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "moving_writer.h"
+#include "writer_worker.h"
+
+namespace mrd {
+// What a TeeMrdWriter does when a sink's queue is full.
+enum class TeeSinkPolicy {
+  // Wait for the sink to catch up. The slowest blocking sink sets the pace.
+  kBlock,
+  // Discard the item for this sink only. The header and the end of the
+  // stream are never dropped.
+  kDrop,
+};
+
+struct TeeSinkOptions {
+  TeeSinkPolicy policy = TeeSinkPolicy::kBlock;
+
+  // Maximum number of writes queued for the sink.
+  size_t queue_capacity = 64;
+
+  // Maximum in-memory size of the items queued for the sink, as given by
+  // yardl::ByteSize(), or 0 for no limit. Items are shared between sinks, so
+  // an item queued for several sinks counts against each of their budgets.
+  size_t max_bytes = 0;
+};
+
+struct TeeSinkStats {
+  uint64_t items_written = 0;
+  uint64_t items_dropped = 0;
+
+  // Time the tee spent blocked because this sink's queue was full.
+  std::chrono::steady_clock::duration wait_time{};
+};
+
+// Writer for the Mrd protocol that forwards everything written to it to any
+// number of child writers (sinks), for example to archive a stream to HDF5,
+// forward it to a viewer and reconstruct it at the same time.
+//
+// Each sink is driven by its own thread through its own bounded queue. An item
+// is copied at most once, when written as an lvalue, and is then shared
+// read-only by all sinks. Writes return as soon as the item is queued for
+// every sink. An exception thrown by a sink is rethrown by the next call
+// to the tee.
+//
+// Close() waits for all sinks to finish and then closes them.
+//
+// Sinks run concurrently, so unless HDF5 was built thread-safe, use at most
+// one mrd::hdf5::MrdWriter sink and no other HDF5 access while the tee is open.
+class TeeMrdWriter : public MrdMovingWriterBase {
+  public:
+  TeeMrdWriter();
+  ~TeeMrdWriter() override;
+
+  // Adds a sink. Must be called before WriteHeader(). Returns the sink's index.
+  size_t AddSink(std::unique_ptr<MrdWriterBase> writer, TeeSinkOptions options = {});
+
+  size_t SinkCount() const { return sinks_.size(); }
+  TeeSinkStats GetSinkStats(size_t index) const;
+
+  // Waits until every sink has written and flushed all queued items.
+  void Flush() override;
+
+  protected:
+  void WriteHeaderImpl(std::optional<mrd::Header> const& value) override;
+  void WriteDataImpl(mrd::StreamItem&& value) override;
+  void WriteDataImpl(std::vector<mrd::StreamItem>&& values) override;
+  void EndDataImpl() override;
+  void CloseImpl() override;
+
+  private:
+  struct Sink;
+
+  void Broadcast(detail::WriterWorker::Event const& event, size_t item_count, size_t bytes);
+  void ThrowIfSinkFailed();
+
+  std::vector<std::unique_ptr<Sink>> sinks_;
+  bool started_ = false;
+};
+
+} // namespace mrd
@@ -0,0 +1,127 @@
+#include "writer_worker.h"
+
+#include <utility>
+
+#include "data_visitor.h"
+#include "moving_writer.h"
+
+namespace mrd::detail {
+
+WriterWorker::WriterWorker(std::unique_ptr<MrdWriterBase> writer, size_t max_items, size_t max_bytes)
+    : writer_(std::move(writer)), queue_(max_items, max_bytes) {
+  thread_ = std::thread([this]() { Run(); });
+}
+
+WriterWorker::~WriterWorker() {
+  Cancel();
+}
+
+bool WriterWorker::Push(Event&& event, size_t bytes) {
+  ThrowIfFailed();
+  if (!queue_.Push(std::move(event), bytes)) {
+    ThrowIfFailed();
+    return false;
+  }
+  return true;
+}
+
+bool WriterWorker::TryPush(Event&& event, size_t bytes) {
+  ThrowIfFailed();
+  if (!queue_.TryPush(std::move(event), bytes)) {
+    ThrowIfFailed();
+    return false;
+  }
+  return true;
+}
+
+std::future<void> WriterWorker::Flush() {
+  auto promise = std::make_shared<std::promise<void>>();
+  std::future<void> flushed = promise->get_future();
+  // A flush that is not queued breaks its promise
+  Push(FlushEvent{std::move(promise)}, 0);
+  return flushed;
+}
+
+void WriterWorker::Wait(std::future<void>& flushed) {
+  try {
+    flushed.get();
+  } catch (std::future_error const&) {
+    // The writer failed before reaching the flush
+    ThrowIfFailed();
+    throw;
+  }
+}
+
+void WriterWorker::Close() {
+  queue_.Close();
+  Join();
+  ThrowIfFailed();
+  writer_->Close();
+}
+
+void WriterWorker::Cancel() {
+  queue_.Cancel();
+  Join();
+}
+
+void WriterWorker::ThrowIfFailed() const {
+  if (failed_.load(std::memory_order_acquire)) {
+    std::rethrow_exception(error_);
+  }
+}
+
+void WriterWorker::Run() {
+  try {
+    Event event;
+    while (queue_.Pop(event)) {
+      auto start = std::chrono::steady_clock::now();
+      Write(std::move(event));
+      write_time_.fetch_add((std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+      // Releases shared items while waiting for the next event
+      event = EndDataEvent{};
+    }
+  } catch (...) {
+    error_ = std::current_exception();
+    failed_.store(true, std::memory_order_release);
+    // Discards queued events, which breaks the promises of pending flushes.
+    queue_.Cancel();
+  }
+}
+
+void WriterWorker::Write(Event&& event) {
+  std::visit(
+      mrd::Overloaded{
+          [&](HeaderEvent& e) { writer_->WriteHeader(*e.header); },
+          [&](ItemEvent& e) {
+            mrd::WriteData(*writer_, std::move(e.item));
+            items_written_.fetch_add(1, std::memory_order_relaxed);
+          },
+          [&](ItemsEvent& e) {
+            size_t count = e.items.size();
+            mrd::WriteData(*writer_, std::move(e.items));
+            items_written_.fetch_add(count, std::memory_order_relaxed);
+          },
+          [&](SharedItemEvent& e) {
+            writer_->WriteData(*e.item);
+            items_written_.fetch_add(1, std::memory_order_relaxed);
+          },
+          [&](SharedItemsEvent& e) {
+            writer_->WriteData(*e.items);
+            items_written_.fetch_add(e.items->size(), std::memory_order_relaxed);
+          },
+          [&](EndDataEvent&) { writer_->EndData(); },
+          [&](FlushEvent& e) {
+            writer_->Flush();
+            e.flushed->set_value();
+          },
+      },
+      event);
+}
+
+void WriterWorker::Join() {
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+} // namespace mrd::detail
@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include "protocols.h"
+#include "concurrency/bounded_queue.h"
+
+namespace mrd::detail {
+// Drives a writer from a background thread through a bounded queue of
+// writes. The thread behind AsyncMrdWriter and each sink of TeeMrdWriter.
+//
+// Once the writer throws, the queued writes are discarded, and the
+// exception is rethrown by every later call.
+class WriterWorker {
+  public:
+  // The writes queued for the worker. Items are either owned by the event and
+  // moved into the writer, or shared read-only with other workers.
+  struct HeaderEvent {
+    std::shared_ptr<std::optional<mrd::Header> const> header;
+  };
+  struct ItemEvent {
+    mrd::StreamItem item;
+  };
+  struct ItemsEvent {
+    std::vector<mrd::StreamItem> items;
+  };
+  struct SharedItemEvent {
+    std::shared_ptr<mrd::StreamItem const> item;
+  };
+  struct SharedItemsEvent {
+    std::shared_ptr<std::vector<mrd::StreamItem> const> items;
+  };
+  struct EndDataEvent {};
+  struct FlushEvent {
+    std::shared_ptr<std::promise<void>> flushed;
+  };
+  using Event = std::variant<HeaderEvent, ItemEvent, ItemsEvent, SharedItemEvent, SharedItemsEvent, EndDataEvent, FlushEvent>;
+
+  // The queue holds at most `max_items` writes, and at most `max_bytes` bytes
+  // of items, or any number of bytes if 0.
+  WriterWorker(std::unique_ptr<MrdWriterBase> writer, size_t max_items, size_t max_bytes);
+
+  // Discards the queued writes and stops the thread.
+  ~WriterWorker();
+
+  // Queues a write of `bytes` bytes, blocking while the queue is full.
+  // Returns false if the queue was closed.
+  bool Push(Event&& event, size_t bytes);
+
+  // Queues a write of `bytes` bytes unless the queue is full. Returns false
+  // if it was not queued.
+  bool TryPush(Event&& event, size_t bytes);
+
+  // Queues a flush of the writer, and returns the future it completes.
+  std::future<void> Flush();
+
+  // Waits for a flush returned by Flush().
+  void Wait(std::future<void>& flushed);
+
+  // Stops the thread once the queued writes are done, then closes the writer.
+  void Close();
+
+  // Stops the thread, without closing the writer.
+  void Cancel();
+
+  void ThrowIfFailed() const;
+
+  uint64_t ItemsWritten() const { return items_written_.load(std::memory_order_relaxed); }
+
+  // Time the thread spent in the writer.
+  std::chrono::steady_clock::duration WriteTime() const {
+    return std::chrono::steady_clock::duration(write_time_.load(std::memory_order_relaxed));
+  }
+
+  // Time callers were blocked because the queue was at its limits.
+  std::chrono::steady_clock::duration PushWaitTime() const { return queue_.PushWaitTime(); }
+
+  private:
+  void Run();
+  void Write(Event&& event);
+  void Join();
+
+  std::unique_ptr<MrdWriterBase> writer_;
+  concurrency::BoundedQueue<Event> queue_;
+  std::thread thread_;
+  std::exception_ptr error_;
+  std::atomic<bool> failed_{false};
+  std::atomic<uint64_t> items_written_{0};
+  std::atomic<std::chrono::steady_clock::rep> write_time_{0};
+};
+
+} // namespace mrd::detail
@@ -14,7 +14,7 @@ function ifmatlab() {
 }
 
 function cleanup() {
-  rm -f ./*.h5 ./*.ismrmrd ./*.mrd ./*.png ./*.pipe
+  rm -f ./*.h5 ./*.ismrmrd ./*.mrd ./*.png ./*.pipe ./*.sock
   popd >/dev/null
 }
 
@@ -62,6 +62,282 @@ ifmatlab && python validate_recon.py --reference coil_images.mat.mrd --testdata
 ifmatlab && python validate_recon.py --reference coil_images.mat.mrd --testdata reconstructed.mat.py.mrd
 ifmatlab && python validate_recon.py --reference coil_images.mat.mrd --testdata reconstructed.mat.mat.mrd
 
+## Reconstruct the acquisitions of one repetition only
+mrd_stream_recon --repetition 1 -i phantom.cpp.mrd -o reconstructed.repetition.cpp.mrd
+python - reconstructed.cpp.cpp.mrd reconstructed.repetition.cpp.mrd <<'EOF'
+import sys
+import numpy as np
+import mrd
+def read_images(filename):
+    with mrd.BinaryMrdReader(filename) as reader:
+        reader.read_header()
+        return [item.value for item in reader.read_data() if isinstance(item, mrd.StreamItem.ImageFloat)]
+expected = [image for image in read_images(sys.argv[1]) if image.head.repetition == 1]
+images = read_images(sys.argv[2])
+assert len(expected) > 0 and len(images) == len(expected), "The reconstruction did not select one repetition"
+assert all(image.head.repetition == 1 and np.array_equal(image.data, other.data)
+           for image, other in zip(images, expected)), "The images of the selected repetition do not match"
+EOF
+
+## Reconstruct phantoms with reduced-precision k-space samples
+mrd_phantom "${generate_args[@]}" --sample-encoding float16 --output phantom.f16.cpp.mrd
+mrd_phantom "${generate_args[@]}" --sample-encoding bfloat16 --output phantom.bf16.cpp.mrd
+mrd_stream_recon -i phantom.f16.cpp.mrd -o reconstructed.f16.cpp.mrd
+mrd_stream_recon -i phantom.bf16.cpp.mrd -o reconstructed.bf16.cpp.mrd
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.f16.cpp.mrd --tolerance 1e-3
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.bf16.cpp.mrd --tolerance 1e-2
+
+## Reconstruct a phantom with checksummed items
+mrd_phantom "${generate_args[@]}" --checksums --output phantom.crc.cpp.mrd
+mrd_stream_recon -i phantom.crc.cpp.mrd -o reconstructed.crc.cpp.mrd
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.crc.cpp.mrd
+
+## Reconstruct a phantom while decoding ahead on a background thread
+mrd_stream_recon --prefetch 64 -i phantom.cpp.mrd -o reconstructed.prefetch.cpp.mrd
+mrd_stream_recon --prefetch 64 -i phantom.crc.cpp.mrd -o reconstructed.prefetch.crc.cpp.mrd
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.prefetch.cpp.mrd
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.prefetch.crc.cpp.mrd
+
+## Write a phantom on a background thread
+mrd_phantom "${generate_args[@]}" --async --output phantom.async.cpp.mrd
+cmp phantom.cpp.mrd phantom.async.cpp.mrd
+
+## Write a phantom to several files at once
+mrd_phantom "${generate_args[@]}" --output phantom.tee0.cpp.mrd --tee phantom.tee1.cpp.mrd --tee-drop phantom.tee2.cpp.mrd
+cmp phantom.cpp.mrd phantom.tee0.cpp.mrd
+cmp phantom.cpp.mrd phantom.tee1.cpp.mrd
+python - phantom.cpp.mrd phantom.tee2.cpp.mrd <<'EOF'
+import sys
+import mrd
+def read_items(filename):
+    with mrd.BinaryMrdReader(filename) as reader:
+        header = reader.read_header()
+        return header, list(reader.read_data())
+header, items = read_items(sys.argv[1])
+dropping_header, dropping_items = read_items(sys.argv[2])
+assert dropping_header == header, "The header of the dropping sink does not match"
+# The dropping sink may skip items, but keeps the others in order
+remaining = iter(items)
+assert all(any(item == other for other in remaining) for item in dropping_items), "The dropping sink reordered items"
+EOF
+# A failing sink fails the whole write
+if mrd_phantom "${generate_args[@]}" --output phantom.tee0.cpp.mrd --tee /dev/full 2>/dev/null; then
+  echo "Writing a phantom to a full device succeeded" >&2
+  exit 1
+fi
+
+## Stream a phantom to the reconstruction through shared memory
+mrd_phantom "${generate_args[@]}" --output-shm "/mrd-test-$$" &
+writer_pid=$!
+while [[ ! -e "/dev/shm/mrd-test-$$" ]]; do sleep 0.1; done
+# The name is taken until the reader opens it
+if mrd_phantom "${generate_args[@]}" --output-shm "/mrd-test-$$" 2>/dev/null; then
+  echo "A second writer took over the shared memory of the first" >&2
+  exit 1
+fi
+mrd_stream_recon --input-shm "/mrd-test-$$" -o reconstructed.shm.cpp.mrd
+wait $writer_pid
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.shm.cpp.mrd
+
+## Replace a stale shared memory object left behind by a writer
+: > "/dev/shm/mrd-test-$$"
+mrd_phantom "${generate_args[@]}" --output-shm "/mrd-test-$$" --replace-shm &
+while [[ ! -s "/dev/shm/mrd-test-$$" ]]; do sleep 0.1; done
+mrd_stream_recon --input-shm "/mrd-test-$$" -o reconstructed.shm.replaced.cpp.mrd
+wait $!
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.shm.replaced.cpp.mrd
+
+## Reconstruct phantoms concurrently through a long-running reconstruction server
+mrd_stream_recon --listen recon.sock --threads 2 &
+server_pid=$!
+while [[ ! -S recon.sock ]]; do sleep 0.1; done
+mrd_stream_recon --connect recon.sock -i phantom.cpp.mrd -o reconstructed.server.cpp.mrd &
+client_pid=$!
+mrd_stream_recon --connect recon.sock -i phantom.py.mrd -o reconstructed.server.py.mrd
+wait $client_pid
+# The server finishes its sessions, removes its socket and exits cleanly
+kill -TERM $server_pid
+wait $server_pid
+[[ ! -e recon.sock ]]
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.server.cpp.mrd
+python validate_recon.py --reference coil_images.py.mrd --testdata reconstructed.server.py.mrd
+
+## Stop a busy server: it finishes the session in progress and closes the connections waiting for a thread
+rm -f busy.fifo && mkfifo busy.fifo
+mrd_stream_recon --listen busy.sock --threads 1 &
+server_pid=$!
+while [[ ! -S busy.sock ]]; do sleep 0.1; done
+mrd_stream_recon --connect busy.sock -i busy.fifo -o reconstructed.busy.cpp.mrd &
+client_pid=$!
+exec 3>busy.fifo
+sleep 1
+# One connection waits in the server's queue, the other for room in it
+mrd_stream_recon --connect busy.sock -i phantom.cpp.mrd -o reconstructed.queued.cpp.mrd &
+queued_pid=$!
+mrd_stream_recon --connect busy.sock -i phantom.cpp.mrd -o reconstructed.unqueued.cpp.mrd &
+unqueued_pid=$!
+sleep 1
+kill -TERM $server_pid
+cat phantom.cpp.mrd >&3
+exec 3>&-
+wait $server_pid
+wait $client_pid
+wait $queued_pid $unqueued_pid || true
+[[ ! -e busy.sock && ! -s reconstructed.queued.cpp.mrd && ! -s reconstructed.unqueued.cpp.mrd ]]
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.busy.cpp.mrd
+
+## Merge two copies of a phantom read on concurrent threads, with a small memory budget
+mrd_stream_merge --max-bytes 100000 phantom.cpp.mrd phantom.crc.cpp.mrd > phantom.merged.mrd
+python - phantom.cpp.mrd phantom.merged.mrd <<'EOF'
+import sys
+import mrd
+def read_items(filename):
+    with mrd.BinaryMrdReader(filename) as reader:
+        reader.read_header()
+        return list(reader.read_data())
+items = read_items(sys.argv[1])
+# The merged stream must interleave two copies of the items, each in order
+states = {(0, 0)}
+for item in read_items(sys.argv[2]):
+    states = ({(i + 1, j) for i, j in states if i < len(items) and items[i] == item} |
+              {(i, j + 1) for i, j in states if j < len(items) and items[j] == item})
+    states = {(max(i, j), min(i, j)) for i, j in states}
+    assert states, "The merged stream is not an interleaving of its sources"
+assert (len(items), len(items)) in states, "The merged stream misses items of its sources"
+EOF
+
+## Multiplex two phantoms over one stream and split them up again
+mrd_stream_mux phantom.cpp.mrd phantom.py.mrd | mrd_stream_mux --demux phantom.demuxed.
+python compare_dataset.py phantom.cpp.mrd phantom.demuxed.0.mrd
+python compare_dataset.py phantom.py.mrd phantom.demuxed.1.mrd
+# Again with a session buffer smaller than an Acquisition
+mrd_stream_mux phantom.cpp.mrd phantom.py.mrd | mrd_stream_mux --demux phantom.demuxed.small. --max-session-bytes 1024
+python compare_dataset.py phantom.cpp.mrd phantom.demuxed.small.0.mrd
+python compare_dataset.py phantom.py.mrd phantom.demuxed.small.1.mrd
+
+## Distribute the reconstruction of a phantom across worker servers
+mrd_stream_recon --listen worker0.sock --threads 1 &
+worker0_pid=$!
+mrd_stream_recon --listen worker1.sock --threads 1 &
+worker1_pid=$!
+while [[ ! -S worker0.sock || ! -S worker1.sock ]]; do sleep 0.1; done
+mrd_stream_recon --workers worker0.sock,worker1.sock -i phantom.cpp.mrd -o reconstructed.distributed.cpp.mrd
+kill -INT $worker0_pid $worker1_pid
+wait $worker0_pid $worker1_pid
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.distributed.cpp.mrd
+# Each worker reconstructed one repetition, and the merged output is that of a single process
+python - reconstructed.cpp.cpp.mrd reconstructed.distributed.cpp.mrd <<'EOF'
+import sys
+import mrd
+def read_items(filename):
+    with mrd.BinaryMrdReader(filename) as reader:
+        reader.read_header()
+        return list(reader.read_data())
+assert read_items(sys.argv[1]) == read_items(sys.argv[2]), "The distributed reconstruction differs"
+EOF
+
+## Convert a phantom to HDF5 and back, reading and writing on separate threads
+copy_stats=$(mrd_stream_to_hdf5 phantom.roundtrip.h5 --stats 2>&1 < phantom.cpp.mrd)
+[[ "$copy_stats" == "Copied "* ]]
+mrd_hdf5_to_stream phantom.roundtrip.h5 --stats > phantom.roundtrip.mrd
+python compare_dataset.py phantom.cpp.mrd phantom.roundtrip.mrd
+mrd_stream_recon -i phantom.roundtrip.mrd -o reconstructed.roundtrip.cpp.mrd
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.roundtrip.cpp.mrd
+
+## Store a phantom's arrays in dense compressed datasets, with key tables
+mrd_stream_to_hdf5 phantom.dense.h5 --dense --compression deflate --key-tables < phantom.cpp.mrd
+mrd_hdf5_to_stream phantom.dense.h5 > phantom.dense.mrd
+python compare_dataset.py phantom.cpp.mrd phantom.dense.mrd
+mrd_stream_recon -i phantom.dense.mrd -o reconstructed.dense.cpp.mrd
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.dense.cpp.mrd
+
+## Read items by their positions and acquisitions by their keys
+mrd_hdf5_to_stream phantom.dense.h5 --range 10:100 > phantom.range.mrd
+mrd_hdf5_to_stream phantom.dense.h5 --range 100: > phantom.seek.mrd
+mrd_hdf5_to_stream phantom.dense.h5 --repetition 1 > phantom.select.mrd
+python - phantom.cpp.mrd phantom.range.mrd phantom.seek.mrd phantom.select.mrd <<'EOF'
+import sys
+import mrd
+def read_items(filename):
+    with mrd.BinaryMrdReader(filename) as reader:
+        reader.read_header()
+        return list(reader.read_data())
+items = read_items(sys.argv[1])
+assert read_items(sys.argv[2]) == items[10:100], "Items read by range do not match"
+assert read_items(sys.argv[3]) == items[100:], "Items read after seeking do not match"
+repetition = [item for item in items
+              if isinstance(item, mrd.StreamItem.Acquisition) and item.value.head.idx.repetition == 1]
+assert len(repetition) > 0 and read_items(sys.argv[4]) == repetition, "Selected acquisitions do not match"
+EOF
+
+## Reconstruct a phantom through an HDF5 virtual file mapping its acquisitions
+mrd_stream_to_hdf5 phantom.series1.h5 < phantom.cpp.mrd
+cp phantom.series1.h5 phantom.series2.h5
+mrd_hdf5_aggregate phantom.virtual.h5 phantom.series1.h5
+mrd_hdf5_to_stream phantom.virtual.h5 | mrd_stream_recon -o reconstructed.virtual.cpp.mrd
+python validate_recon.py --reference coil_images.cpp.mrd --testdata reconstructed.virtual.cpp.mrd
+mrd_hdf5_aggregate phantom.study.h5 phantom.series1.h5 phantom.series2.h5
+mrd_hdf5_to_stream phantom.study.h5 > phantom.study.mrd
+python - phantom.cpp.mrd phantom.study.mrd <<'EOF'
+import sys
+import mrd
+def count_items(filename):
+    with mrd.BinaryMrdReader(filename) as reader:
+        reader.read_header()
+        return sum(1 for _ in reader.read_data())
+assert count_items(sys.argv[2]) == 2 * count_items(sys.argv[1]), "The virtual file does not hold the items of both files"
+EOF
+mrd_phantom --matrix 64 | mrd_stream_to_hdf5 phantom.other.h5
+if mrd_hdf5_aggregate phantom.mixed.h5 phantom.series1.h5 phantom.other.h5 2>/dev/null; then
+  echo "Error: aggregated files with different headers" >&2
+  exit 1
+fi
+
+## Read an HDF5 file while it is written (SWMR), which HDF5 supports for
+## items of fixed size such as Pulseq events, but not for acquisitions
+python - live.source.mrd <<'EOF'
+import sys
+import mrd
+def generate_events():
+    for i in range(20000):
+        yield mrd.StreamItem.PulseqRfEvent(mrd.PulseqRFEvent(id=i, amp=float(i)))
+        if i % 3 == 0:
+            yield mrd.StreamItem.PulseqAdcEvent(mrd.PulseqADCEvent(id=i))
+with mrd.BinaryMrdWriter(sys.argv[1]) as w:
+    w.write_header(mrd.Header())
+    w.write_data(generate_events())
+EOF
+rm -f live.h5 live.pipe && mkfifo live.pipe
+mrd_stream_to_hdf5 live.h5 --swmr < live.pipe &
+writer_pid=$!
+# Hold back the rest of the stream until the reader has opened the file
+{ head -c 400000 live.source.mrd; sleep 3; tail -c +400001 live.source.mrd; } > live.pipe &
+feeder_pid=$!
+while [[ ! -s live.h5 ]]; do sleep 0.1; done
+sleep 1
+mrd_hdf5_to_stream live.h5 --swmr > live.swmr.mrd &
+reader_pid=$!
+kill -0 $writer_pid
+wait $feeder_pid
+wait $writer_pid
+wait $reader_pid
+mrd_hdf5_to_stream live.h5 > live.mrd
+python - live.source.mrd live.mrd live.swmr.mrd <<'EOF'
+import sys
+import mrd
+def read_items(filename):
+    with mrd.BinaryMrdReader(filename) as reader:
+        reader.read_header()
+        return list(reader.read_data())
+items = read_items(sys.argv[1])
+assert read_items(sys.argv[2]) == items, "The items written with SWMR do not match"
+assert read_items(sys.argv[3]) == items, "The items read while they were written do not match"
+EOF
+if mrd_stream_to_hdf5 live.acquisitions.h5 --swmr < phantom.cpp.mrd 2>/dev/null; then
+  echo "Error: wrote acquisitions with SWMR" >&2
+  exit 1
+fi
+
 ####
 # Test that phantom generation (with parallel imaging) is consistent across implementations
 
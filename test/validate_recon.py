@@ -3,7 +3,7 @@ import numpy as np
 import numpy.typing as npt
 import mrd
 
-def verify_basic_recon(reference_file: str, testdata_file: str):
+def verify_basic_recon(reference_file: str, testdata_file: str, tolerance: float = 2e-5):
     reference: npt.NDArray[np.float32]
     with mrd.BinaryMrdReader(reference_file) as reader:
         header = reader.read_header()
@@ -39,12 +39,13 @@ def verify_basic_recon(reference_file: str, testdata_file: str):
 
     for image in images:
         reconstruction = np.squeeze(image.data)
-        assert np.linalg.norm(reconstruction - reference) / np.linalg.norm(reference) < 2e-5
+        assert np.linalg.norm(reconstruction - reference) / np.linalg.norm(reference) < tolerance
 
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(description='Validate results of an ismrmrd reconstruction')
     parser.add_argument('--reference', type=str, help='Reference file', required=True)
     parser.add_argument('--testdata', type=str, help='Test data file', required=True)
+    parser.add_argument('--tolerance', type=float, help='Maximum relative error', default=2e-5)
     args = parser.parse_args()
-    verify_basic_recon(args.reference, args.testdata)
+    verify_basic_recon(args.reference, args.testdata, args.tolerance)
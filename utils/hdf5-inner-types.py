@@ -0,0 +1,47 @@
+import argparse
+
+# Extracts the HDF5 inner types and type definitions of the Mrd model from the
+# generated cpp/mrd/hdf5/protocols.cc, where they live in an anonymous
+# namespace, into a header for MrdFileWriter and MrdFileReader
+# (cpp/mrd/hdf5/file.cc). They use the HDF5 runtime in cpp/mrd/hdf5 instead
+# of the one under cpp/mrd/yardl, so references to yardl::hdf5 are rewritten.
+# Run by `just generate` after `yardl generate`.
+
+HEADER = """// This file was generated from hdf5/protocols.cc by utils/hdf5-inner-types.py. DO NOT EDIT.
+
+#pragma once
+
+#include "../protocols.h"
+#include "ddl.h"
+#include "inner_types.h"
+#include "io.h"
+
+"""
+
+def extract(source: str):
+    # The inner types start with the first anonymous namespace, and end with
+    # the anonymous namespace within mrd::hdf5, before the first member
+    # definition of the generated writers. mrd::hdf5 itself is closed after
+    # the writers, so it is closed here.
+    begin = source.find("namespace {")
+    writer = source.find("MrdWriter::MrdWriter(")
+    end = source.rfind("} // namespace", 0, writer)
+    if begin < 0 or writer < 0 or end < begin:
+        raise Exception("Unexpected layout of the generated code")
+
+    body = source[begin:source.index("\n", end) + 1]
+    return HEADER + body.replace("yardl::hdf5::", "mrd::hdf5::") + "} // namespace mrd::hdf5\n"
+
+def main():
+    parser = argparse.ArgumentParser(description="Extract the HDF5 inner types of the Mrd model")
+    parser.add_argument("protocols", help="Path of the generated hdf5/protocols.cc")
+    parser.add_argument("output", help="Path of the header to write")
+    args = parser.parse_args()
+
+    with open(args.protocols) as f:
+        source = f.read()
+    with open(args.output, "w") as f:
+        f.write(extract(source))
+
+if __name__ == "__main__":
+    main()